@@ -29,6 +29,9 @@
 //-----------------------------------------------------------------------------
 
 #include "llpolymorph.h"
+
+#include <algorithm>
+
 #include "llavatarappearance.h"
 #include "llavatarjoint.h"
 #include "llwearable.h"
@@ -568,86 +571,86 @@ void LLPolyMorphTarget::apply( ESex avatar_sex )
     if (delta_weight != 0.f)
     {
         llassert(!mMesh->isLOD());
-        LLVector4a *coords = mMesh->getWritableCoords();
-
-        LLVector4a *scaled_normals = mMesh->getScaledNormals();
-        LLVector4a *normals = mMesh->getWritableNormals();
+        F32 *maskWeightArray = (mVertMask) ? mVertMask->getMorphMaskWeights() : NULL;
 
-        LLVector4a *scaled_binormals = mMesh->getScaledBinormals();
-        LLVector4a *binormals = mMesh->getWritableBinormals();
+        LLPolyMorphBatch* batch = LLPolyMorphBatch::getActive();
+        if (batch)
+        {
+            batch->addMorph(mMesh, mMorphData, maskWeightArray, delta_weight, getInfo()->mIsClothingMorph);
+        }
+        else
+        {
+            LLVector4a *coords = mMesh->getWritableCoords();
 
-        LLVector4a *clothing_weights = mMesh->getWritableClothingWeights();
-        LLVector2 *tex_coords = mMesh->getWritableTexCoords();
+            LLVector4a *scaled_normals = mMesh->getScaledNormals();
+            LLVector4a *normals = mMesh->getWritableNormals();
 
-        F32 *maskWeightArray = (mVertMask) ? mVertMask->getMorphMaskWeights() : NULL;
+            LLVector4a *scaled_binormals = mMesh->getScaledBinormals();
+            LLVector4a *binormals = mMesh->getWritableBinormals();
 
-        for(U32 vert_index_morph = 0; vert_index_morph < mMorphData->mNumIndices; vert_index_morph++)
-        {
-            S32 vert_index_mesh = mMorphData->mVertexIndices[vert_index_morph];
+            LLVector4a *clothing_weights = mMesh->getWritableClothingWeights();
+            LLVector2 *tex_coords = mMesh->getWritableTexCoords();
 
-            F32 maskWeight = 1.f;
-            if (maskWeightArray)
+            for(U32 vert_index_morph = 0; vert_index_morph < mMorphData->mNumIndices; vert_index_morph++)
             {
-                maskWeight = maskWeightArray[vert_index_morph];
-            }
+                S32 vert_index_mesh = mMorphData->mVertexIndices[vert_index_morph];
 
+                F32 maskWeight = 1.f;
+                if (maskWeightArray)
+                {
+                    maskWeight = maskWeightArray[vert_index_morph];
+                }
 
-            LLVector4a pos = mMorphData->mCoords[vert_index_morph];
-            pos.mul(delta_weight*maskWeight);
-            coords[vert_index_mesh].add(pos);
 
-            if (getInfo()->mIsClothingMorph && clothing_weights)
-            {
-                LLVector4a clothing_offset = mMorphData->mCoords[vert_index_morph];
-                clothing_offset.mul(delta_weight * maskWeight);
-                LLVector4a* clothing_weight = &clothing_weights[vert_index_mesh];
-                clothing_weight->add(clothing_offset);
-                clothing_weight->getF32ptr()[VW] = maskWeight;
-            }
+                LLVector4a pos = mMorphData->mCoords[vert_index_morph];
+                pos.mul(delta_weight*maskWeight);
+                coords[vert_index_mesh].add(pos);
 
-            // calculate new normals based on half angles
-            LLVector4a norm = mMorphData->mNormals[vert_index_morph];
-            norm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
-            scaled_normals[vert_index_mesh].add(norm);
-            norm = scaled_normals[vert_index_mesh];
+                if (getInfo()->mIsClothingMorph && clothing_weights)
+                {
+                    LLVector4a clothing_offset = mMorphData->mCoords[vert_index_morph];
+                    clothing_offset.mul(delta_weight * maskWeight);
+                    LLVector4a* clothing_weight = &clothing_weights[vert_index_mesh];
+                    clothing_weight->add(clothing_offset);
+                    clothing_weight->getF32ptr()[VW] = maskWeight;
+                }
 
-            // guard against degenerate input data before we create NaNs below!
-            //
-            norm.normalize3fast();
-            normals[vert_index_mesh] = norm;
+                // calculate new normals based on half angles
+                LLVector4a norm = mMorphData->mNormals[vert_index_morph];
+                norm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
+                scaled_normals[vert_index_mesh].add(norm);
+                norm = scaled_normals[vert_index_mesh];
 
-            // calculate new binormals
-            LLVector4a binorm = mMorphData->mBinormals[vert_index_morph];
+                // guard against degenerate input data before we create NaNs below!
+                //
+                norm.normalize3fast();
+                normals[vert_index_mesh] = norm;
 
-            // guard against degenerate input data before we create NaNs below!
-            //
-            if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
-            {
-                binorm.set(1,0,0,1);
-            }
+                // calculate new binormals
+                LLVector4a binorm = mMorphData->mBinormals[vert_index_morph];
 
-            binorm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
-            scaled_binormals[vert_index_mesh].add(binorm);
-            LLVector4a tangent;
-            tangent.setCross3(scaled_binormals[vert_index_mesh], norm);
-            LLVector4a& normalized_binormal = binormals[vert_index_mesh];
+                // guard against degenerate input data before we create NaNs below!
+                //
+                if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
+                {
+                    binorm.set(1,0,0,1);
+                }
+
+                binorm.mul(delta_weight*maskWeight*NORMAL_SOFTEN_FACTOR);
+                scaled_binormals[vert_index_mesh].add(binorm);
+                LLVector4a tangent;
+                tangent.setCross3(scaled_binormals[vert_index_mesh], norm);
+                LLVector4a& normalized_binormal = binormals[vert_index_mesh];
 
-            normalized_binormal.setCross3(norm, tangent);
-            normalized_binormal.normalize3fast();
+                normalized_binormal.setCross3(norm, tangent);
+                normalized_binormal.normalize3fast();
 
-            tex_coords[vert_index_mesh] += mMorphData->mTexCoords[vert_index_morph] * delta_weight * maskWeight;
+                tex_coords[vert_index_mesh] += mMorphData->mTexCoords[vert_index_morph] * delta_weight * maskWeight;
+            }
         }
 
         // now apply volume changes
-        for(LLPolyVolumeMorph& volume_morph : mVolumeMorphs)
-        {
-            LLVector3 scale_delta = volume_morph.mScale * delta_weight;
-            LLVector3 pos_delta = volume_morph.mPos * delta_weight;
-
-            volume_morph.mVolume->setScale(volume_morph.mVolume->getScale() + scale_delta);
-            // SL-315
-            volume_morph.mVolume->setPosition(volume_morph.mVolume->getPosition() + pos_delta);
-        }
+        applyVolumeChanges(delta_weight);
     }
 
     if (mNext)
@@ -842,3 +845,163 @@ F32* LLPolyVertexMask::getMorphMaskWeights()
 
     return mWeights;
 }
+
+//-----------------------------------------------------------------------------
+// LLPolyMorphBatch()
+//-----------------------------------------------------------------------------
+LLPolyMorphBatch::LLPolyMorphBatch(bool enabled)
+    : mCollecting(enabled && !getActive())
+{
+    if (mCollecting)
+    {
+        LLThreadLocalSingletonPointer<LLPolyMorphBatch>::setInstance(this);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// ~LLPolyMorphBatch()
+//-----------------------------------------------------------------------------
+LLPolyMorphBatch::~LLPolyMorphBatch()
+{
+    if (mCollecting)
+    {
+        LLThreadLocalSingletonPointer<LLPolyMorphBatch>::setInstance(NULL);
+    }
+    apply();
+}
+
+//-----------------------------------------------------------------------------
+// addMorph()
+//-----------------------------------------------------------------------------
+void LLPolyMorphBatch::addMorph(LLPolyMesh* mesh, const LLPolyMorphData* morph_data, const F32* mask_weights,
+                                F32 delta_weight, bool clothing_morph)
+{
+    Morph morph;
+    morph.mMesh = mesh;
+    morph.mMorphData = morph_data;
+    morph.mMaskWeights = mask_weights;
+    morph.mDeltaWeight = delta_weight;
+    morph.mClothingMorph = clothing_morph;
+    mMorphs.push_back(morph);
+}
+
+//-----------------------------------------------------------------------------
+// apply()
+//-----------------------------------------------------------------------------
+void LLPolyMorphBatch::apply()
+{
+    if (mMorphs.empty())
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+
+    // group by mesh, keeping the order the morphs were applied in
+    std::stable_sort(mMorphs.begin(), mMorphs.end(),
+                     [](const Morph& a, const Morph& b) { return a.mMesh < b.mMesh; });
+
+    morph_list_t::const_iterator begin = mMorphs.begin();
+    while (begin != mMorphs.end())
+    {
+        morph_list_t::const_iterator end = begin;
+        while (end != mMorphs.end() && end->mMesh == begin->mMesh)
+        {
+            ++end;
+        }
+        applyMesh(begin, end);
+        begin = end;
+    }
+
+    mMorphs.clear();
+}
+
+//-----------------------------------------------------------------------------
+// applyMesh()
+//-----------------------------------------------------------------------------
+void LLPolyMorphBatch::applyMesh(morph_list_t::const_iterator begin, morph_list_t::const_iterator end)
+{
+    LLPolyMesh* mesh = begin->mMesh;
+
+    LLVector4a *coords = mesh->getWritableCoords();
+    LLVector4a *scaled_normals = mesh->getScaledNormals();
+    LLVector4a *normals = mesh->getWritableNormals();
+    LLVector4a *scaled_binormals = mesh->getScaledBinormals();
+    LLVector4a *binormals = mesh->getWritableBinormals();
+    LLVector4a *clothing_weights = mesh->getWritableClothingWeights();
+    LLVector2 *tex_coords = mesh->getWritableTexCoords();
+
+    const U32 num_vertices = mesh->getNumVertices();
+    mTouched.assign(num_vertices, 0);
+    U32 first_touched = num_vertices;
+    U32 last_touched = 0;
+
+    // accumulate the deltas of every morph, in the order they were applied
+    for (morph_list_t::const_iterator iter = begin; iter != end; ++iter)
+    {
+        const LLPolyMorphData* morph_data = iter->mMorphData;
+        const F32* mask_weights = iter->mMaskWeights;
+        const F32 delta_weight = iter->mDeltaWeight;
+        const bool clothing = iter->mClothingMorph && clothing_weights;
+
+        for (U32 vert_index_morph = 0; vert_index_morph < morph_data->mNumIndices; vert_index_morph++)
+        {
+            U32 vert_index_mesh = morph_data->mVertexIndices[vert_index_morph];
+            if (vert_index_mesh >= num_vertices)
+            {
+                continue;
+            }
+
+            F32 mask_weight = mask_weights ? mask_weights[vert_index_morph] : 1.f;
+            F32 weight = delta_weight * mask_weight;
+
+            LLVector4a pos = morph_data->mCoords[vert_index_morph];
+            pos.mul(weight);
+            coords[vert_index_mesh].add(pos);
+
+            if (clothing)
+            {
+                LLVector4a& clothing_weight = clothing_weights[vert_index_mesh];
+                clothing_weight.add(pos);
+                clothing_weight.getF32ptr()[VW] = mask_weight;
+            }
+
+            LLVector4a norm = morph_data->mNormals[vert_index_morph];
+            norm.mul(weight * NORMAL_SOFTEN_FACTOR);
+            scaled_normals[vert_index_mesh].add(norm);
+
+            // guard against degenerate input data, as LLPolyMorphTarget::apply() does
+            LLVector4a binorm = morph_data->mBinormals[vert_index_morph];
+            if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
+            {
+                binorm.set(1,0,0,1);
+            }
+            binorm.mul(weight * NORMAL_SOFTEN_FACTOR);
+            scaled_binormals[vert_index_mesh].add(binorm);
+
+            tex_coords[vert_index_mesh] += morph_data->mTexCoords[vert_index_morph] * delta_weight * mask_weight;
+
+            mTouched[vert_index_mesh] = 1;
+            first_touched = llmin(first_touched, vert_index_mesh);
+            last_touched = llmax(last_touched, vert_index_mesh);
+        }
+    }
+
+    // then rebuild the normals and binormals of the touched vertices once
+    for (U32 i = first_touched; i <= last_touched && i < num_vertices; ++i)
+    {
+        if (!mTouched[i])
+        {
+            continue;
+        }
+
+        LLVector4a norm = scaled_normals[i];
+        norm.normalize3fast();
+        normals[i] = norm;
+
+        LLVector4a tangent;
+        tangent.setCross3(scaled_binormals[i], norm);
+        binormals[i].setCross3(norm, tangent);
+        binormals[i].normalize3fast();
+    }
+}
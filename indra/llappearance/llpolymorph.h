@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "llviewervisualparam.h"
+#include "llthreadlocalstorage.h"
 
 class LLAvatarJointCollisionVolume;
 class LLPolyMeshSharedData;
@@ -190,4 +191,57 @@ protected:
 
 };
 
+//-----------------------------------------------------------------------------
+// LLPolyMorphBatch
+// Collects the vertex changes of every LLPolyMorphTarget applied on this
+// thread while in scope, and applies them when it goes out of scope in one
+// sparse pass per mesh: position, normal, binormal and texture coordinate
+// deltas are accumulated first, then each touched vertex has its normal and
+// binormal rebuilt once instead of once per morph.
+//-----------------------------------------------------------------------------
+class LLPolyMorphBatch
+{
+public:
+    // A disabled batch, or one created while another batch is collecting on
+    // this thread, collects nothing and leaves the morphs to the outer one.
+    LLPolyMorphBatch(bool enabled = true);
+    ~LLPolyMorphBatch();
+
+    LLPolyMorphBatch(const LLPolyMorphBatch&) = delete;
+    LLPolyMorphBatch& operator=(const LLPolyMorphBatch&) = delete;
+
+    // batch collecting on the calling thread, NULL if none
+    static LLPolyMorphBatch* getActive() { return LLThreadLocalSingletonPointer<LLPolyMorphBatch>::getInstance(); }
+
+    // queue morph_data scaled by delta_weight, and by mask_weights if not
+    // NULL, for mesh
+    void addMorph(LLPolyMesh* mesh, const LLPolyMorphData* morph_data, const F32* mask_weights,
+                  F32 delta_weight, bool clothing_morph);
+
+    // Applies and clears the queued morphs. Only the meshes' vertex data is
+    // touched, so this may be called from a worker thread as long as nothing
+    // else uses those meshes meanwhile.
+    void apply();
+
+    bool isEmpty() const { return mMorphs.empty(); }
+
+private:
+    struct Morph
+    {
+        LLPolyMesh*             mMesh;
+        const LLPolyMorphData*  mMorphData;
+        const F32*              mMaskWeights;
+        F32                     mDeltaWeight;
+        bool                    mClothingMorph;
+    };
+    typedef std::vector<Morph> morph_list_t;
+
+    void applyMesh(morph_list_t::const_iterator begin, morph_list_t::const_iterator end);
+
+    morph_list_t    mMorphs;
+    // per vertex flags for the mesh being applied
+    std::vector<U8> mTouched;
+    bool            mCollecting;
+};
+
 #endif // LL_LLPOLYMORPH_H
@@ -0,0 +1,341 @@
+/**
+ * @file llpolymorph_test.cpp
+ * @brief LLPolyMorphBatch test cases, using the shipped avatar meshes.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llpolymorph.h"
+#include "../llpolymesh.h"
+#include "lldir.h"
+#include "llfile.h"
+#include "llxmltree.h"
+
+#include "../test/lltut.h"
+
+// LL_PATH_CHARACTER lookups for LLPolyMesh::getMesh()
+class LLDir_Character : public LLDir
+{
+public:
+    LLDir_Character(const std::string& app_ro_data_dir)
+    {
+        mDirDelimiter = "/";
+        mAppRODataDir = app_ro_data_dir;
+    }
+
+    virtual void initAppDirs(const std::string& app_name, const std::string& app_read_only_data_dir) {}
+    virtual std::string getCurPath() { return ""; }
+    virtual bool fileExists(const std::string& filename) const { return LLFile::isfile(filename); }
+    virtual std::string getLLPluginLauncher() { return ""; }
+    virtual std::string getLLPluginFilename(std::string base_name) { return ""; }
+};
+
+namespace tut
+{
+    struct llpolymorph_data
+    {
+        struct MorphParam
+        {
+            std::string mName;
+            F32         mMinWeight;
+            F32         mMaxWeight;
+            bool        mClothingMorph;
+        };
+
+        struct MeshParams
+        {
+            std::string             mFileName;
+            std::vector<MorphParam> mMorphs;
+        };
+
+        LLDir* mSavedDir;
+        std::unique_ptr<LLDir_Character> mDir;
+        std::vector<MeshParams> mMeshes;
+
+        llpolymorph_data() : mSavedDir(gDirUtilp)
+        {
+            // LL_TEST_CHARACTER_DIR overrides the source tree's
+            // newview/character directory
+            std::string character_dir;
+            const char* env = getenv("LL_TEST_CHARACTER_DIR");
+            if (env)
+            {
+                character_dir = env;
+            }
+            else
+            {
+                std::string source_dir(__FILE__);
+                source_dir = source_dir.substr(0, source_dir.find_last_of("/\\"));
+                character_dir = source_dir + "/../../newview/character";
+            }
+
+            // getExpandedFilename(LL_PATH_CHARACTER, ...) appends "character"
+            mDir.reset(new LLDir_Character(character_dir + "/.."));
+            gDirUtilp = mDir.get();
+
+            LLXmlTree tree;
+            if (!LLFile::isfile(character_dir + "/avatar_lad.xml")
+                || !tree.parseFile(character_dir + "/avatar_lad.xml", false))
+            {
+                return;
+            }
+
+            for (LLXmlTreeNode* mesh_node = tree.getRoot()->getChildByName("mesh");
+                 mesh_node;
+                 mesh_node = tree.getRoot()->getNextNamedChild())
+            {
+                S32 lod = 0;
+                MeshParams mesh;
+                if (!mesh_node->getAttributeS32("lod", lod) || lod != 0
+                    || !mesh_node->getAttributeString("file_name", mesh.mFileName))
+                {
+                    continue;
+                }
+
+                for (LLXmlTreeNode* param_node = mesh_node->getChildByName("param");
+                     param_node;
+                     param_node = mesh_node->getNextNamedChild())
+                {
+                    MorphParam morph;
+                    morph.mMinWeight = 0.f;
+                    morph.mMaxWeight = 1.f;
+                    morph.mClothingMorph = false;
+                    if (param_node->getChildByName("param_morph")
+                        && param_node->getAttributeString("name", morph.mName))
+                    {
+                        param_node->getAttributeF32("value_min", morph.mMinWeight);
+                        param_node->getAttributeF32("value_max", morph.mMaxWeight);
+                        param_node->getAttributeBOOL("clothing_morph", morph.mClothingMorph);
+                        mesh.mMorphs.push_back(morph);
+                    }
+                }
+                mMeshes.push_back(mesh);
+            }
+        }
+
+        ~llpolymorph_data()
+        {
+            LLPolyMesh::freeAllMeshes();
+            gDirUtilp = mSavedDir;
+        }
+
+        static LLPolyMorphData* getMorphData(LLPolyMesh* mesh, const std::string& name)
+        {
+            LLPolyMorphData* morph_data = mesh->getMorphData(name);
+            if (!morph_data)
+            {
+                // as LLPolyMorphTarget::setInfo()
+                auto pos = name.find("_Driven");
+                if (pos != std::string::npos && pos > 0)
+                {
+                    morph_data = mesh->getMorphData(name.substr(0, pos));
+                }
+            }
+            return morph_data;
+        }
+
+        // pseudo random weight for a morph in a given round
+        static F32 getWeight(const MorphParam& morph, U32 index, U32 round)
+        {
+            U32 h = (index + 1) * 2654435761u + round * 40503u;
+            return lerp(morph.mMinWeight, morph.mMaxWeight, (F32)(h % 1000) * 0.001f);
+        }
+
+        // LLPolyMorphTarget::apply() without a batch
+        static void applyReference(LLPolyMesh* mesh, const LLPolyMorphData* morph_data, F32 delta_weight, bool clothing_morph)
+        {
+            const F32 NORMAL_SOFTEN_FACTOR = 0.65f;
+
+            LLVector4a *coords = mesh->getWritableCoords();
+            LLVector4a *scaled_normals = mesh->getScaledNormals();
+            LLVector4a *normals = mesh->getWritableNormals();
+            LLVector4a *scaled_binormals = mesh->getScaledBinormals();
+            LLVector4a *binormals = mesh->getWritableBinormals();
+            LLVector4a *clothing_weights = mesh->getWritableClothingWeights();
+            LLVector2 *tex_coords = mesh->getWritableTexCoords();
+
+            for (U32 k = 0; k < morph_data->mNumIndices; k++)
+            {
+                S32 v = morph_data->mVertexIndices[k];
+
+                LLVector4a pos = morph_data->mCoords[k];
+                pos.mul(delta_weight);
+                coords[v].add(pos);
+
+                if (clothing_morph && clothing_weights)
+                {
+                    clothing_weights[v].add(pos);
+                    clothing_weights[v].getF32ptr()[VW] = 1.f;
+                }
+
+                LLVector4a norm = morph_data->mNormals[k];
+                norm.mul(delta_weight * NORMAL_SOFTEN_FACTOR);
+                scaled_normals[v].add(norm);
+                norm = scaled_normals[v];
+                norm.normalize3fast();
+                normals[v] = norm;
+
+                LLVector4a binorm = morph_data->mBinormals[k];
+                if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
+                {
+                    binorm.set(1,0,0,1);
+                }
+                binorm.mul(delta_weight * NORMAL_SOFTEN_FACTOR);
+                scaled_binormals[v].add(binorm);
+                LLVector4a tangent;
+                tangent.setCross3(scaled_binormals[v], norm);
+                binormals[v].setCross3(norm, tangent);
+                binormals[v].normalize3fast();
+
+                tex_coords[v] += morph_data->mTexCoords[k] * delta_weight;
+            }
+        }
+
+        // every morph of every mesh, one after the other or batched
+        void applyAll(const std::vector<LLPolyMesh*>& meshes, U32 round, LLPolyMorphBatch* batch)
+        {
+            for (size_t m = 0; m < meshes.size(); ++m)
+            {
+                const std::vector<MorphParam>& morphs = mMeshes[m].mMorphs;
+                for (U32 i = 0; i < morphs.size(); ++i)
+                {
+                    const LLPolyMorphData* morph_data = getMorphData(meshes[m], morphs[i].mName);
+                    if (!morph_data)
+                    {
+                        continue;
+                    }
+
+                    F32 delta_weight = getWeight(morphs[i], i, round + 1) - getWeight(morphs[i], i, round);
+                    if (batch)
+                    {
+                        batch->addMorph(meshes[m], morph_data, NULL, delta_weight, morphs[i].mClothingMorph);
+                    }
+                    else
+                    {
+                        applyReference(meshes[m], morph_data, delta_weight, morphs[i].mClothingMorph);
+                    }
+                }
+            }
+        }
+
+        bool loadMeshes(std::vector<LLPolyMesh*>& meshes)
+        {
+            for (const MeshParams& mesh_params : mMeshes)
+            {
+                LLPolyMesh* mesh = LLPolyMesh::getMesh(mesh_params.mFileName);
+                if (!mesh)
+                {
+                    return false;
+                }
+                meshes.push_back(mesh);
+            }
+            return !meshes.empty();
+        }
+
+        static void deleteMeshes(std::vector<LLPolyMesh*>& meshes)
+        {
+            for (LLPolyMesh* mesh : meshes)
+            {
+                delete mesh;
+            }
+            meshes.clear();
+        }
+
+        static void ensure_vectors(const char* msg, const LLVector4a* expected, const LLVector4a* actual, U32 count)
+        {
+            for (U32 i = 0; i < count; ++i)
+            {
+                for (U32 c = 0; c < 3; ++c)
+                {
+                    ensure_approximately_equals_range(msg, actual[i][c], expected[i][c], 0.0001f);
+                }
+            }
+        }
+    };
+    typedef test_group<llpolymorph_data> llpolymorph_t;
+    typedef llpolymorph_t::object llpolymorph_object_t;
+    tut::llpolymorph_t tut_llpolymorph("LLPolyMorphBatch");
+
+    // batched morphs match morphs applied one at a time
+    template<> template<>
+    void llpolymorph_object_t::test<1>()
+    {
+        std::vector<LLPolyMesh*> expected;
+        std::vector<LLPolyMesh*> actual;
+        if (!loadMeshes(expected) || !loadMeshes(actual))
+        {
+            deleteMeshes(expected);
+            deleteMeshes(actual);
+            skip("avatar meshes not found, set LL_TEST_CHARACTER_DIR");
+        }
+
+        for (U32 round = 0; round < 3; ++round)
+        {
+            applyAll(expected, round, NULL);
+
+            LLPolyMorphBatch batch;
+            ensure("batch active", LLPolyMorphBatch::getActive() == &batch);
+            applyAll(actual, round, &batch);
+            batch.apply();
+            ensure("batch applied", batch.isEmpty());
+        }
+        ensure("no batch active", LLPolyMorphBatch::getActive() == NULL);
+
+        for (size_t m = 0; m < expected.size(); ++m)
+        {
+            U32 count = expected[m]->getNumVertices();
+            ensure_vectors("coords", expected[m]->getCoords(), actual[m]->getCoords(), count);
+            ensure_vectors("normals", expected[m]->getNormals(), actual[m]->getNormals(), count);
+            ensure_vectors("binormals", expected[m]->getBinormals(), actual[m]->getBinormals(), count);
+            ensure_vectors("clothing weights", expected[m]->getClothingWeights(), actual[m]->getClothingWeights(), count);
+            for (U32 i = 0; i < count; ++i)
+            {
+                ensure_approximately_equals_range("tex coords", actual[m]->getTexCoords()[i].mV[VX],
+                                                  expected[m]->getTexCoords()[i].mV[VX], 0.0001f);
+                ensure_approximately_equals_range("tex coords", actual[m]->getTexCoords()[i].mV[VY],
+                                                  expected[m]->getTexCoords()[i].mV[VY], 0.0001f);
+            }
+        }
+
+        deleteMeshes(expected);
+        deleteMeshes(actual);
+    }
+
+    // only the outermost enabled batch collects
+    template<> template<>
+    void llpolymorph_object_t::test<2>()
+    {
+        {
+            LLPolyMorphBatch disabled(false);
+            ensure("disabled batch", LLPolyMorphBatch::getActive() == NULL);
+        }
+
+        LLPolyMorphBatch outer;
+        {
+            LLPolyMorphBatch inner;
+            ensure("outer batch collects", LLPolyMorphBatch::getActive() == &outer);
+        }
+        ensure("outer batch still collects", LLPolyMorphBatch::getActive() == &outer);
+    }
+}
@@ -33,6 +33,7 @@
 #include "llcharacter.h"
 #include "llstring.h"
 #include "llfasttimer.h"
+#include "parallelfor.h"
 
 #define SKEL_HEADER "Linden Skeleton 1.0"
 
@@ -179,11 +180,7 @@ void LLCharacter::updateMotions(e_update_t update_type)
     }
     else
     {
-        // unpause if the number of outstanding pause requests has dropped to the initial one
-        if (mMotionController.isPaused() && mPauseRequest->getNumRefs() == 1)
-        {
-            mMotionController.unpauseAllMotions();
-        }
+        updatePauseState();
         bool force_update = (update_type == FORCE_UPDATE);
         {
             mMotionController.updateMotions(force_update);
@@ -191,6 +188,74 @@ void LLCharacter::updateMotions(e_update_t update_type)
     }
 }
 
+//-----------------------------------------------------------------------------
+// requestVisualParamsUpdate()
+//-----------------------------------------------------------------------------
+void LLCharacter::requestVisualParamsUpdate()
+{
+    LLCharacter* character = this;
+    mMotionController.deferCallback([character]()
+        {
+            character->updateVisualParams();
+        });
+}
+
+//-----------------------------------------------------------------------------
+// updateMotionsBatch()
+//-----------------------------------------------------------------------------
+//static
+void LLCharacter::updateMotionsBatch(const std::vector<LLCharacter*>& characters, e_update_t update_type)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (update_type == HIDDEN_UPDATE)
+    {
+        // nothing worth spreading across threads
+        for (LLCharacter* character : characters)
+        {
+            character->updateMotions(update_type);
+        }
+        return;
+    }
+
+    bool force_update = (update_type == FORCE_UPDATE);
+    std::vector<LLMotionController*> controllers;
+    controllers.reserve(characters.size());
+    for (LLCharacter* character : characters)
+    {
+        character->updatePauseState();
+        if (character->mMotionController.prepareUpdate(force_update, true))
+        {
+            controllers.push_back(&character->mMotionController);
+        }
+    }
+
+    LL::parallelFor("General", controllers.size(), 1,
+        [&controllers](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                controllers[i]->evaluateMotions();
+            }
+        });
+
+    for (LLCharacter* character : characters)
+    {
+        character->mMotionController.finishUpdate();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// updatePauseState()
+//-----------------------------------------------------------------------------
+void LLCharacter::updatePauseState()
+{
+    // unpause if the number of outstanding pause requests has dropped to the initial one
+    if (mMotionController.isPaused() && mPauseRequest->getNumRefs() == 1)
+    {
+        mMotionController.unpauseAllMotions();
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 // deactivateAllMotions()
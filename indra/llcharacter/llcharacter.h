@@ -31,6 +31,7 @@
 // Header Files
 //-----------------------------------------------------------------------------
 #include <string>
+#include <vector>
 
 #include "lljoint.h"
 #include "llmotioncontroller.h"
@@ -117,6 +118,10 @@ public:
     // updates all visual parameters for this character
     virtual void updateVisualParams();
 
+    // updateVisualParams() for use from motion updates, which may run off
+    // the main thread (see updateMotionsBatch())
+    void requestVisualParamsUpdate();
+
     virtual void addDebugText( const std::string& text ) = 0;
 
     virtual std::string getDebugName() const { return getID().asString(); }
@@ -157,6 +162,12 @@ public:
     enum e_update_t { NORMAL_UPDATE, HIDDEN_UPDATE, FORCE_UPDATE };
     void updateMotions(e_update_t update_type);
 
+    // Same as calling updateMotions() on each character, but motions are
+    // evaluated in parallel on the "General" thread pool when available.
+    // Characters must not share joints. Motion callbacks that may touch
+    // shared state are deferred until all characters have been evaluated.
+    static void updateMotionsBatch(const std::vector<LLCharacter*>& characters, e_update_t update_type);
+
     LLAnimPauseRequest requestPause();
     bool areAnimationsPaused() const { return mMotionController.isPaused(); }
     void setAnimTimeFactor(F32 factor) { mMotionController.setTimeFactor(factor); }
@@ -294,6 +305,8 @@ protected:
     LLAnimPauseRequest  mPauseRequest;
 
 private:
+    void updatePauseState();
+
     // visual parameter stuff
     typedef std::map<S32, LLVisualParam *>      visual_param_index_map_t;
     typedef std::map<char *, LLVisualParam *>   visual_param_name_map_t;
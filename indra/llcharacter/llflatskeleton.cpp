@@ -0,0 +1,342 @@
+/**
+ * @file llflatskeleton.cpp
+ * @brief Implementation of LLFlatSkeleton class.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include "linden_common.h"
+
+#include "llflatskeleton.h"
+
+#include <atomic>
+
+#include "lljoint.h"
+#include "llmath.h"
+#include "parallelfor.h"
+
+// skeletons per task when batching across threads
+constexpr size_t FLAT_SKELETON_BATCH_GRAIN = 4;
+
+// Build the same matrix as LLMatrix4::initAll(scale, rot, pos): rows 0-2
+// are the rotated unit axes scaled by scale, row 3 is pos.
+static inline void init_world_matrix(LLMatrix4a& mat, const LLVector4a& scale, const LLQuaternion2& rot, const LLVector4a& pos)
+{
+    const F32* q = rot.getVector4a().getF32ptr();
+
+    // (x, y, z, w) * (x, y, z) for the squared terms, doubled
+    LLVector4a q2;
+    q2.setAdd(rot.getVector4a(), rot.getVector4a());
+    const F32* d = q2.getF32ptr();
+
+    const F32 xx = q[VX] * d[VX], yy = q[VY] * d[VY], zz = q[VZ] * d[VZ];
+    const F32 xy = q[VX] * d[VY], xz = q[VX] * d[VZ], yz = q[VY] * d[VZ];
+    const F32 xw = q[VW] * d[VX], yw = q[VW] * d[VY], zw = q[VW] * d[VZ];
+
+    LLVector4a s;
+
+    mat.mMatrix[0].set(1.f - (yy + zz), xy + zw, xz - yw, 0.f);
+    s.splat<0>(scale);
+    mat.mMatrix[0].mul(s);
+
+    mat.mMatrix[1].set(xy - zw, 1.f - (xx + zz), yz + xw, 0.f);
+    s.splat<1>(scale);
+    mat.mMatrix[1].mul(s);
+
+    mat.mMatrix[2].set(xz + yw, yz - xw, 1.f - (xx + yy), 0.f);
+    s.splat<2>(scale);
+    mat.mMatrix[2].mul(s);
+
+    mat.mMatrix[3] = pos;
+    mat.mMatrix[3].getF32ptr()[3] = 1.f;
+}
+
+//-----------------------------------------------------------------------------
+// LLFlatSkeleton()
+//-----------------------------------------------------------------------------
+LLFlatSkeleton::LLFlatSkeleton() :
+    mRoot(NULL),
+    mHierarchySerial(0)
+{
+}
+
+LLFlatSkeleton::~LLFlatSkeleton()
+{
+}
+
+//-----------------------------------------------------------------------------
+// setRoot()
+//-----------------------------------------------------------------------------
+void LLFlatSkeleton::setRoot(LLJoint* root)
+{
+    mRoot = root;
+    rebuild();
+}
+
+//-----------------------------------------------------------------------------
+// rebuild()
+// Flatten the hierarchy depth first so that subtrees are contiguous and
+// every parent precedes its children.
+//-----------------------------------------------------------------------------
+void LLFlatSkeleton::rebuild()
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    mJoints.clear();
+    mParent.clear();
+    mSubtreeEnd.clear();
+    mFlags.clear();
+
+    if (mRoot)
+    {
+        mHierarchySerial = mRoot->getHierarchySerial();
+
+        // explicit stack of (joint, parent slot)
+        std::vector<std::pair<LLJoint*, S32> > stack;
+        stack.emplace_back(mRoot, -1);
+        while (!stack.empty())
+        {
+            LLJoint* joint = stack.back().first;
+            S32 parent = stack.back().second;
+            stack.pop_back();
+
+            S32 slot = (S32)mJoints.size();
+            mJoints.push_back(joint);
+            mParent.push_back(parent);
+            mSubtreeEnd.push_back(slot + 1);
+            mFlags.push_back(0);
+
+            // push in reverse so children are visited in mChildren order
+            for (LLJoint::joints_t::reverse_iterator iter = joint->mChildren.rbegin();
+                 iter != joint->mChildren.rend(); ++iter)
+            {
+                stack.emplace_back(*iter, slot);
+            }
+        }
+
+        // children follow their parent, so walking backwards propagates
+        // subtree extents up to the root
+        for (S32 i = (S32)mJoints.size() - 1; i > 0; --i)
+        {
+            S32 parent = mParent[i];
+            mSubtreeEnd[parent] = llmax(mSubtreeEnd[parent], mSubtreeEnd[i]);
+        }
+    }
+
+    U32 count = (U32)mJoints.size();
+    mLocalPosition.resize(count);
+    mLocalScale.resize(count);
+    mLocalRotation.resize(count);
+    mWorldPosition.resize(count);
+    mWorldRotation.resize(count);
+    mWorldMatrix.resize(count);
+}
+
+//-----------------------------------------------------------------------------
+// update()
+//-----------------------------------------------------------------------------
+void LLFlatSkeleton::update()
+{
+    LLJoint::sNumUpdates.fetch_add(updateJoints(), std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// updateBatch()
+//-----------------------------------------------------------------------------
+//static
+void LLFlatSkeleton::updateBatch(const std::vector<LLFlatSkeleton*>& skeletons)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    std::atomic<U32> num_updates(0);
+    LL::parallelFor("General", skeletons.size(), FLAT_SKELETON_BATCH_GRAIN,
+        [&skeletons, &num_updates](size_t begin, size_t end)
+        {
+            U32 count = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                count += skeletons[i]->updateJoints();
+            }
+            num_updates += count;
+        });
+
+    LLJoint::sNumUpdates.fetch_add(num_updates, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// updateJoints()
+//-----------------------------------------------------------------------------
+U32 LLFlatSkeleton::updateJoints()
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    if (!mRoot)
+    {
+        return 0;
+    }
+
+    if (mRoot->getHierarchySerial() != mHierarchySerial)
+    {
+        rebuild();
+    }
+
+    const S32 count = (S32)mJoints.size();
+    U32 num_dirty = 0;
+
+    // raw pointers keep the bounds checks of LLAlignedArray out of the loops
+    LLVector4a* local_position = mLocalPosition.mArray;
+    LLVector4a* local_scale = mLocalScale.mArray;
+    LLQuaternion2* local_rotation = mLocalRotation.mArray;
+    LLVector4a* world_position = mWorldPosition.mArray;
+    LLQuaternion2* world_rotation = mWorldRotation.mArray;
+    LLMatrix4a* world_matrix = mWorldMatrix.mArray;
+    const S32* parents = mParent.data();
+    U8* flags = mFlags.data();
+
+    // Gather: local transforms for dirty joints, cached world transforms for
+    // clean ones, skipping subtrees that have updates disabled.
+    for (S32 i = 0; i < count; )
+    {
+        LLJoint* joint = mJoints[i];
+        if (!joint->mUpdateXform)
+        {
+            for (S32 j = i; j < mSubtreeEnd[i]; ++j)
+            {
+                flags[j] = 0;
+            }
+            i = mSubtreeEnd[i];
+            continue;
+        }
+
+        const LLXformMatrix& xform = joint->mXform;
+        U8 joint_flags = FLAG_ACTIVE;
+        if (xform.getScaleChildOffset())
+        {
+            joint_flags |= FLAG_SCALE_CHILD_OFFSET;
+        }
+
+        local_scale[i].load3(xform.getScale().mV);
+        if (joint->mDirtyFlags & LLJoint::MATRIX_DIRTY)
+        {
+            joint_flags |= FLAG_DIRTY;
+            ++num_dirty;
+            local_position[i].load3(xform.getPosition().mV);
+            local_rotation[i] = xform.getRotation();
+        }
+        else
+        {
+            world_position[i].load3(xform.getWorldPosition().mV);
+            world_rotation[i] = xform.getWorldRotation();
+        }
+        flags[i] = joint_flags;
+        ++i;
+    }
+
+    if (!num_dirty)
+    {
+        return 0;
+    }
+
+    // The root may be parented to something outside the hierarchy, such as
+    // the drawable of an object the avatar is sitting on.
+    const LLXform* root_parent = mRoot->mXform.getParent();
+    LLVector4a root_parent_position;
+    LLVector4a root_parent_scale;
+    LLQuaternion2 root_parent_rotation;
+    if (root_parent)
+    {
+        root_parent_position.load3(root_parent->getWorldPosition().mV);
+        root_parent_scale.load3(root_parent->getScale().mV);
+        root_parent_rotation = root_parent->getWorldRotation();
+    }
+
+    // Compute: parents always precede children, so one forward pass suffices.
+    for (S32 i = 0; i < count; ++i)
+    {
+        if ((flags[i] & (FLAG_ACTIVE | FLAG_DIRTY)) != (FLAG_ACTIVE | FLAG_DIRTY))
+        {
+            continue;
+        }
+
+        const LLVector4a* parent_position;
+        const LLVector4a* parent_scale;
+        const LLQuaternion2* parent_rotation;
+        bool scale_child_offset;
+
+        S32 parent = parents[i];
+        if (parent >= 0)
+        {
+            parent_position = &world_position[parent];
+            parent_scale = &local_scale[parent];
+            parent_rotation = &world_rotation[parent];
+            scale_child_offset = flags[parent] & FLAG_SCALE_CHILD_OFFSET;
+        }
+        else if (root_parent)
+        {
+            parent_position = &root_parent_position;
+            parent_scale = &root_parent_scale;
+            parent_rotation = &root_parent_rotation;
+            scale_child_offset = root_parent->getScaleChildOffset();
+        }
+        else
+        {
+            world_position[i] = local_position[i];
+            world_rotation[i] = local_rotation[i];
+            init_world_matrix(world_matrix[i], local_scale[i], world_rotation[i], world_position[i]);
+            continue;
+        }
+
+        // same math as LLXformMatrix::update()
+        LLVector4a offset = local_position[i];
+        if (scale_child_offset)
+        {
+            offset.mul(*parent_scale);
+        }
+        world_position[i].setRotated(*parent_rotation, offset);
+        world_position[i].add(*parent_position);
+        world_rotation[i].setMul(local_rotation[i], *parent_rotation);
+
+        init_world_matrix(world_matrix[i], local_scale[i], world_rotation[i], world_position[i]);
+    }
+
+    // Scatter: write results back to the joints that were dirty.
+    for (S32 i = 0; i < count; ++i)
+    {
+        if ((flags[i] & (FLAG_ACTIVE | FLAG_DIRTY)) != (FLAG_ACTIVE | FLAG_DIRTY))
+        {
+            continue;
+        }
+
+        LLJoint* joint = mJoints[i];
+        const F32* rot = world_rotation[i].getVector4a().getF32ptr();
+        joint->mXform.setWorldTransform(LLVector3(world_position[i].getF32ptr()),
+                                        LLQuaternion(rot[VX], rot[VY], rot[VZ], rot[VW]),
+                                        world_matrix[i].asMatrix4());
+        joint->mWorldMatrix = world_matrix[i];
+        joint->mDirtyFlags = 0x0;
+    }
+
+    return num_dirty;
+}
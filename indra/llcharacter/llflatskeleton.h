@@ -0,0 +1,108 @@
+/**
+ * @file llflatskeleton.h
+ * @brief Implementation of LLFlatSkeleton class.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFLATSKELETON_H
+#define LL_LLFLATSKELETON_H
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include <vector>
+
+#include "llmath.h"
+#include "llalignedarray.h"
+#include "llmatrix4a.h"
+
+class LLJoint;
+
+//-----------------------------------------------------------------------------
+// class LLFlatSkeleton
+//
+// Structure-of-arrays copy of a joint hierarchy, sorted so that every joint
+// comes after its parent. update() replaces the recursive
+// LLJoint::updateWorldMatrixChildren() walk with three linear passes:
+// gather local transforms from the joints, compute world transforms with
+// LLVector4a/LLQuaternion2 math indexed by parent slot, and scatter the
+// results back into the dirty joints. LLJoint remains the authoritative
+// view: callers keep using getWorldMatrix() etc. as before.
+//
+// The flattened order is rebuilt automatically when joints are added to or
+// removed from the hierarchy.
+//-----------------------------------------------------------------------------
+class LLFlatSkeleton
+{
+public:
+    LLFlatSkeleton();
+    ~LLFlatSkeleton();
+
+    // flatten the hierarchy under root (may be NULL to release it)
+    void setRoot(LLJoint* root);
+    LLJoint* getRoot() const { return mRoot; }
+
+    S32 getNumJoints() const { return (S32)mJoints.size(); }
+
+    // Equivalent to getRoot()->updateWorldMatrixChildren()
+    void update();
+
+    // Update many skeletons at once, spread across the "General" thread
+    // pool when it is available. Skeletons must not share joints.
+    static void updateBatch(const std::vector<LLFlatSkeleton*>& skeletons);
+
+private:
+    LLFlatSkeleton(const LLFlatSkeleton&) = delete;
+    LLFlatSkeleton& operator=(const LLFlatSkeleton&) = delete;
+
+    void rebuild();
+
+    // returns number of joints whose world matrix was recomputed
+    U32 updateJoints();
+
+    enum
+    {
+        FLAG_ACTIVE = 0x1,              // mUpdateXform set on joint and all ancestors
+        FLAG_DIRTY = 0x2,               // MATRIX_DIRTY was set, recompute and write back
+        FLAG_SCALE_CHILD_OFFSET = 0x4   // children positions are scaled by this joint's scale
+    };
+
+    LLJoint*                        mRoot;
+    U32                             mHierarchySerial;
+
+    // parent-before-child (depth first) order
+    std::vector<LLJoint*>           mJoints;
+    std::vector<S32>                mParent;        // -1 for the root
+    std::vector<S32>                mSubtreeEnd;    // one past the last descendant
+    std::vector<U8>                 mFlags;
+
+    LLAlignedArray<LLVector4a, 64>  mLocalPosition;
+    LLAlignedArray<LLVector4a, 64>  mLocalScale;
+    LLAlignedArray<LLQuaternion2, 64> mLocalRotation;
+
+    LLAlignedArray<LLVector4a, 64>  mWorldPosition;
+    LLAlignedArray<LLQuaternion2, 64> mWorldRotation;
+    LLAlignedArray<LLMatrix4a, 64>  mWorldMatrix;
+};
+
+#endif // LL_LLFLATSKELETON_H
@@ -30,6 +30,7 @@
 //-----------------------------------------------------------------------------
 // Header Files
 //-----------------------------------------------------------------------------
+#include <atomic>
 #include <string>
 #include <list>
 
@@ -90,6 +91,7 @@ LL_ALIGN_PREFIX(16)
 class LLJoint
 {
     LL_ALIGN_NEW
+    friend class LLFlatSkeleton;
 public:
     // priority levels, from highest to lowest
     enum JointPriority
@@ -131,6 +133,10 @@ protected:
     LLVector3       mDefaultPosition;
     LLVector3       mDefaultScale;
 
+    // bumped on the root whenever joints are added to or removed from the
+    // hierarchy, so flattened copies (LLFlatSkeleton) know to rebuild
+    U32             mHierarchySerial;
+
 public:
     U32             mDirtyFlags;
     bool            mUpdateXform;
@@ -148,9 +154,9 @@ public:
     typedef std::vector<LLJoint*> joints_t;
     joints_t mChildren;
 
-    // debug statics
-    static S32      sNumTouches;
-    static S32      sNumUpdates;
+    // debug statics, atomic because motions are evaluated on worker threads
+    static std::atomic<S32> sNumTouches;
+    static std::atomic<S32> sNumUpdates;
     typedef std::set<std::string> debug_joint_name_t;
     static debug_joint_name_t s_debugJointNames;
     static void setDebugJointNames(const debug_joint_name_t& names);
@@ -221,6 +227,9 @@ public:
     // getRoot
     LLJoint *getRoot();
 
+    // changes whenever the hierarchy under this root is modified
+    U32 getHierarchySerial() const { return mHierarchySerial; }
+
     // search for child joints by name
     LLJoint* findJoint(std::string_view name);
 
@@ -0,0 +1,289 @@
+/**
+ * @file llkeyframecurve.cpp
+ * @brief Implementation of the compact keyframe curve classes.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include "linden_common.h"
+
+#include "llkeyframecurve.h"
+
+#include <algorithm>
+
+// forward steps to try before falling back to a binary search
+constexpr U32 MAX_CURSOR_STEPS = 4;
+
+constexpr F32 ROTATION_QUANTIZE_SCALE = 32767.f;
+
+//-----------------------------------------------------------------------------
+// LLCompactKeyframeCurve()
+//-----------------------------------------------------------------------------
+LLCompactKeyframeCurve::LLCompactKeyframeCurve() :
+    mStep(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+// initTimes()
+//-----------------------------------------------------------------------------
+void LLCompactKeyframeCurve::initTimes(const std::vector<F32>& times, bool step)
+{
+    mTimes = times;
+    mStep = step;
+
+    mInvSpans.resize(mTimes.empty() ? 0 : mTimes.size() - 1);
+    for (size_t i = 0; i < mInvSpans.size(); ++i)
+    {
+        llassert(mTimes[i + 1] > mTimes[i]);
+        mInvSpans[i] = 1.f / (mTimes[i + 1] - mTimes[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// seek()
+//-----------------------------------------------------------------------------
+F32 LLCompactKeyframeCurve::seek(F32 time, U32& cursor) const
+{
+    const U32 last = getNumKeys() - 1;
+    const F32* times = mTimes.data();
+
+    if (time <= times[0])
+    {
+        cursor = 0;
+        return 0.f;
+    }
+    if (time >= times[last])
+    {
+        cursor = last;
+        return 0.f;
+    }
+
+    // times[0] < time < times[last] from here on, so the result is a
+    // segment index in [0, last)
+    U32 i = cursor;
+    bool found = false;
+    if (i < last && times[i] <= time)
+    {
+        for (U32 steps = 0; steps < MAX_CURSOR_STEPS; ++steps)
+        {
+            if (time < times[i + 1])
+            {
+                found = true;
+                break;
+            }
+            ++i;
+        }
+    }
+
+    if (!found)
+    {
+        // went backwards or skipped ahead
+        i = (U32)(std::upper_bound(times, times + last + 1, time) - times) - 1;
+    }
+
+    cursor = i;
+    return (time - times[i]) * mInvSpans[i];
+}
+
+//-----------------------------------------------------------------------------
+// getTimesSizeInBytes()
+//-----------------------------------------------------------------------------
+size_t LLCompactKeyframeCurve::getTimesSizeInBytes() const
+{
+    return (mTimes.size() + mInvSpans.size()) * sizeof(F32);
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactVectorCurve::init()
+//-----------------------------------------------------------------------------
+void LLCompactVectorCurve::init(const std::vector<F32>& times, const std::vector<LLVector3>& values, bool step)
+{
+    llassert(times.size() == values.size());
+    initTimes(times, step);
+
+    const U32 count = getNumKeys();
+    mValues.resize(count);
+    mDeltas.resize(count ? count - 1 : 0);
+    for (U32 i = 0; i < count; ++i)
+    {
+        mValues.mArray[i].load3(values[i].mV);
+        if (i > 0)
+        {
+            mDeltas.mArray[i - 1].setSub(mValues.mArray[i], mValues.mArray[i - 1]);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactVectorCurve::sample()
+//-----------------------------------------------------------------------------
+void LLCompactVectorCurve::sample(F32 time, U32& cursor, LLVector4a& value) const
+{
+    if (isEmpty())
+    {
+        value.clear();
+        return;
+    }
+
+    F32 u = seek(time, cursor);
+    if (u == 0.f || mStep)
+    {
+        value = mValues.mArray[cursor];
+    }
+    else
+    {
+        // same as lerp(before, after, u)
+        value.setMul(mDeltas.mArray[cursor], u);
+        value.add(mValues.mArray[cursor]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactVectorCurve::getSizeInBytes()
+//-----------------------------------------------------------------------------
+size_t LLCompactVectorCurve::getSizeInBytes() const
+{
+    return getTimesSizeInBytes() + (mValues.size() + mDeltas.size()) * sizeof(LLVector4a);
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactRotationCurve::init()
+//-----------------------------------------------------------------------------
+void LLCompactRotationCurve::init(const std::vector<F32>& times, const std::vector<LLQuaternion>& rotations, bool step)
+{
+    llassert(times.size() == rotations.size());
+    initTimes(times, step);
+
+    const U32 count = getNumKeys();
+    mQuantized.resize(count * 4);
+    for (U32 i = 0; i < count; ++i)
+    {
+        for (U32 c = 0; c < 4; ++c)
+        {
+            F32 v = llclamp(rotations[i].mQ[c], -1.f, 1.f);
+            mQuantized[i * 4 + c] = (S16)ll_round(v * ROTATION_QUANTIZE_SCALE);
+        }
+    }
+
+    // Classify each segment the way nlerp() does, using the unquantized keys
+    // so that rounding can't move a segment between the two paths.
+    mSegments.resize(count ? count - 1 : 0);
+    for (U32 i = 0; i + 1 < count; ++i)
+    {
+        const LLQuaternion& a = rotations[i];
+        const LLQuaternion& b = rotations[i + 1];
+        Segment& segment = mSegments[i];
+
+        F32 cos_t = a.mQ[VX] * b.mQ[VX] + a.mQ[VY] * b.mQ[VY] + a.mQ[VZ] * b.mQ[VZ] + a.mQ[VW] * b.mQ[VW];
+        segment.mSlerp = cos_t < 0.f;
+        segment.mAngle = 0.f;
+        segment.mInvSinAngle = 0.f;
+        if (segment.mSlerp)
+        {
+            cos_t = -cos_t;
+            // same threshold as slerp() for falling back to linear weights
+            if (1.f - cos_t >= 0.00001f)
+            {
+                segment.mAngle = acosf(cos_t);
+                segment.mInvSinAngle = 1.f / sinf(segment.mAngle);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactRotationCurve::loadKey()
+//-----------------------------------------------------------------------------
+void LLCompactRotationCurve::loadKey(U32 index, LLVector4a& value) const
+{
+    // sign extend four S16 to S32 and convert
+    __m128i q = _mm_loadl_epi64((const __m128i*)&mQuantized[index * 4]);
+    q = _mm_srai_epi32(_mm_unpacklo_epi16(q, q), 16);
+    static const LLQuad scale = { 1.f / ROTATION_QUANTIZE_SCALE, 1.f / ROTATION_QUANTIZE_SCALE,
+                                  1.f / ROTATION_QUANTIZE_SCALE, 1.f / ROTATION_QUANTIZE_SCALE };
+    value = _mm_mul_ps(_mm_cvtepi32_ps(q), scale);
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactRotationCurve::sample()
+//-----------------------------------------------------------------------------
+void LLCompactRotationCurve::sample(F32 time, U32& cursor, LLQuaternion2& value) const
+{
+    LLVector4a& result = value.getVector4aRw();
+    if (isEmpty())
+    {
+        result.set(0.f, 0.f, 0.f, 1.f);
+        return;
+    }
+
+    F32 u = seek(time, cursor);
+    if (u == 0.f || mStep)
+    {
+        loadKey(cursor, result);
+        result.normalize4();
+        return;
+    }
+
+    LLVector4a before;
+    LLVector4a after;
+    loadKey(cursor, before);
+    loadKey(cursor + 1, after);
+
+    const Segment& segment = mSegments[cursor];
+    if (!segment.mSlerp)
+    {
+        // nlerp() takes the lerp path for keys in the same hemisphere
+        result.setLerp(before, after, u);
+        result.normalize4();
+        return;
+    }
+
+    // slerp() with the first key negated
+    F32 beta;
+    F32 alpha;
+    if (segment.mAngle == 0.f)
+    {
+        beta = 1.f - u;
+        alpha = u;
+    }
+    else
+    {
+        beta = sinf(segment.mAngle - u * segment.mAngle) * segment.mInvSinAngle;
+        alpha = sinf(u * segment.mAngle) * segment.mInvSinAngle;
+    }
+
+    before.mul(-beta);
+    after.mul(alpha);
+    result.setAdd(before, after);
+}
+
+//-----------------------------------------------------------------------------
+// LLCompactRotationCurve::getSizeInBytes()
+//-----------------------------------------------------------------------------
+size_t LLCompactRotationCurve::getSizeInBytes() const
+{
+    return getTimesSizeInBytes() + mQuantized.size() * sizeof(S16) + mSegments.size() * sizeof(Segment);
+}
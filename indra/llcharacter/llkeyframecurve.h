@@ -0,0 +1,143 @@
+/**
+ * @file llkeyframecurve.h
+ * @brief Compact, immutable keyframe curves for LLKeyframeMotion.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLKEYFRAMECURVE_H
+#define LL_LLKEYFRAMECURVE_H
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include <vector>
+
+#include "llmath.h"
+#include "llalignedarray.h"
+#include "llquaternion.h"
+#include "llquaternion2.h"
+#include "llvector4a.h"
+#include "v3math.h"
+
+//-----------------------------------------------------------------------------
+// class LLCompactKeyframeCurve
+//
+// Sorted key times shared by the compact curves below. Curves are built once
+// when an animation is deserialized and are never modified afterwards, so a
+// single copy can be sampled by every avatar playing the animation. Playback
+// position is kept outside the curve in a cursor owned by the caller: for the
+// usual monotonic playback the cursor only ever advances by a key or two per
+// frame, and a binary search is only needed when the time jumps backwards
+// (e.g. at a loop point).
+//
+// Sampling matches LLKeyframeMotion's map based curves: before the first key
+// or after the last the end key is returned, on a key that key is returned,
+// and in between the two neighbouring keys are interpolated.
+//-----------------------------------------------------------------------------
+class LLCompactKeyframeCurve
+{
+public:
+    LLCompactKeyframeCurve();
+
+    U32 getNumKeys() const { return (U32)mTimes.size(); }
+    bool isEmpty() const { return mTimes.empty(); }
+    bool isStep() const { return mStep; }
+
+protected:
+    void initTimes(const std::vector<F32>& times, bool step);
+
+    // Move cursor to the key at or before time and return the fraction of
+    // the way to the next key, 0 when time is on or outside the end keys.
+    F32 seek(F32 time, U32& cursor) const;
+
+    size_t getTimesSizeInBytes() const;
+
+    std::vector<F32>    mTimes;
+    std::vector<F32>    mInvSpans;  // 1 / (mTimes[i + 1] - mTimes[i])
+    bool                mStep;
+};
+
+//-----------------------------------------------------------------------------
+// class LLCompactVectorCurve
+//
+// Position or scale keys, linearly interpolated. Each segment stores its
+// delta to the next key so sampling is a single multiply-add.
+//-----------------------------------------------------------------------------
+class LLCompactVectorCurve : public LLCompactKeyframeCurve
+{
+public:
+    LLCompactVectorCurve() = default;
+
+    // times must be sorted and unique, one value per time
+    void init(const std::vector<F32>& times, const std::vector<LLVector3>& values, bool step);
+
+    void sample(F32 time, U32& cursor, LLVector4a& value) const;
+
+    size_t getSizeInBytes() const;
+
+private:
+    LLCompactVectorCurve(const LLCompactVectorCurve&) = delete;
+    LLCompactVectorCurve& operator=(const LLCompactVectorCurve&) = delete;
+
+    LLAlignedArray<LLVector4a, 16>  mValues;
+    LLAlignedArray<LLVector4a, 16>  mDeltas;    // mValues[i + 1] - mValues[i]
+};
+
+//-----------------------------------------------------------------------------
+// class LLCompactRotationCurve
+//
+// Rotation keys quantized to four signed 16 bit components. Segments record
+// whether nlerp() would take the slerp path for them (keys in opposite
+// hemispheres) along with the precomputed angle, so sampling never needs the
+// dot product, acos or the hemisphere test.
+//-----------------------------------------------------------------------------
+class LLCompactRotationCurve : public LLCompactKeyframeCurve
+{
+public:
+    LLCompactRotationCurve() = default;
+
+    // times must be sorted and unique, one rotation per time
+    void init(const std::vector<F32>& times, const std::vector<LLQuaternion>& rotations, bool step);
+
+    void sample(F32 time, U32& cursor, LLQuaternion2& value) const;
+
+    size_t getSizeInBytes() const;
+
+private:
+    LLCompactRotationCurve(const LLCompactRotationCurve&) = delete;
+    LLCompactRotationCurve& operator=(const LLCompactRotationCurve&) = delete;
+
+    void loadKey(U32 index, LLVector4a& value) const;
+
+    struct Segment
+    {
+        F32     mAngle;         // slerp angle, 0 if nearly identical keys
+        F32     mInvSinAngle;   // 1 / sin(mAngle)
+        bool    mSlerp;         // keys in opposite hemispheres
+    };
+
+    std::vector<S16>        mQuantized; // x, y, z, w per key
+    std::vector<Segment>    mSegments;
+};
+
+#endif // LL_LLKEYFRAMECURVE_H
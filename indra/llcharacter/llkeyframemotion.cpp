@@ -115,12 +115,27 @@ U32 LLKeyframeMotion::JointMotionList::dumpDiagInfo()
 
             total_size += joint_motion_p->mPositionCurve.mNumKeys * sizeof(PositionKey);
         }
+
+        size_t compact_size = joint_motion_p->mCompactPositionCurve.getSizeInBytes()
+            + joint_motion_p->mCompactRotationCurve.getSizeInBytes()
+            + joint_motion_p->mCompactScaleCurve.getSizeInBytes();
+        LL_INFOS() << "\t" << compact_size << " bytes of compact curves" << LL_ENDL;
+
+        total_size += (S32)compact_size;
     }
     LL_INFOS() << "Size: " << total_size << " bytes" << LL_ENDL;
 
     return total_size;
 }
 
+void LLKeyframeMotion::JointMotionList::buildCompactCurves()
+{
+    for (JointMotion* joint_motion : mJointMotionArray)
+    {
+        joint_motion->buildCompactCurves();
+    }
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 // ****Curve classes
@@ -378,10 +393,47 @@ LLVector3 LLKeyframeMotion::PositionCurve::interp(F32 u, PositionKey& before, Po
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// JointMotion::buildCompactCurves()
+//-----------------------------------------------------------------------------
+void LLKeyframeMotion::JointMotion::buildCompactCurves()
+{
+    std::vector<F32> times;
+    std::vector<LLVector3> values;
+    std::vector<LLQuaternion> rotations;
+
+    times.reserve(mPositionCurve.mKeys.size());
+    values.reserve(mPositionCurve.mKeys.size());
+    for (const PositionCurve::key_map_t::value_type& pos_pair : mPositionCurve.mKeys)
+    {
+        times.push_back(pos_pair.first);
+        values.push_back(pos_pair.second.mPosition);
+    }
+    mCompactPositionCurve.init(times, values, mPositionCurve.mInterpolationType == IT_STEP);
+
+    times.clear();
+    values.clear();
+    for (const ScaleCurve::key_map_t::value_type& scale_pair : mScaleCurve.mKeys)
+    {
+        times.push_back(scale_pair.first);
+        values.push_back(scale_pair.second.mScale);
+    }
+    mCompactScaleCurve.init(times, values, mScaleCurve.mInterpolationType == IT_STEP);
+
+    times.clear();
+    rotations.reserve(mRotationCurve.mKeys.size());
+    for (const RotationCurve::key_map_t::value_type& rot_pair : mRotationCurve.mKeys)
+    {
+        times.push_back(rot_pair.first);
+        rotations.push_back(rot_pair.second.mRotation);
+    }
+    mCompactRotationCurve.init(times, rotations, mRotationCurve.mInterpolationType == IT_STEP);
+}
+
 //-----------------------------------------------------------------------------
 // JointMotion::update()
 //-----------------------------------------------------------------------------
-void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time, F32 duration)
+void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time, Cursor& cursor) const
 {
     // this value being 0 is the cause of https://jira.lindenlab.com/browse/SL-22678 but I haven't
     // managed to get a stack to see how it got here. Testing for 0 here will stop the crash.
@@ -395,25 +447,33 @@ void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time,
     //-------------------------------------------------------------------------
     // update scale component of joint state
     //-------------------------------------------------------------------------
-    if ((usage & LLJointState::SCALE) && mScaleCurve.mNumKeys)
+    if ((usage & LLJointState::SCALE) && !mCompactScaleCurve.isEmpty())
     {
-        joint_state->setScale( mScaleCurve.getValue( time, duration ) );
+        LLVector4a scale;
+        mCompactScaleCurve.sample(time, cursor.mScale, scale);
+        joint_state->setScale(LLVector3(scale.getF32ptr()));
     }
 
     //-------------------------------------------------------------------------
     // update rotation component of joint state
     //-------------------------------------------------------------------------
-    if ((usage & LLJointState::ROT) && mRotationCurve.mNumKeys)
+    if ((usage & LLJointState::ROT) && !mCompactRotationCurve.isEmpty())
     {
-        joint_state->setRotation( mRotationCurve.getValue( time, duration ) );
+        LLQuaternion2 rotation;
+        mCompactRotationCurve.sample(time, cursor.mRotation, rotation);
+        const F32* q = rotation.getVector4a().getF32ptr();
+        joint_state->setRotation(LLQuaternion(q[VX], q[VY], q[VZ], q[VW]));
     }
 
     //-------------------------------------------------------------------------
     // update position component of joint state
     //-------------------------------------------------------------------------
-    if ((usage & LLJointState::POS) && mPositionCurve.mNumKeys)
+    if ((usage & LLJointState::POS) && !mCompactPositionCurve.isEmpty())
     {
-        joint_state->setPosition( mPositionCurve.getValue( time, duration ) );
+        LLVector4a position;
+        mCompactPositionCurve.sample(time, cursor.mPosition, position);
+        llassert(position.isFinite3());
+        joint_state->setPosition(LLVector3(position.getF32ptr()));
     }
 }
 
@@ -736,11 +796,16 @@ bool LLKeyframeMotion::onUpdate(F32 time, U8* joint_mask)
 void LLKeyframeMotion::applyKeyframes(F32 time)
 {
     llassert_always (mJointMotionList->getNumJointMotions() <= mJointStates.size());
+    if (mKeyframeCursors.size() != mJointMotionList->getNumJointMotions())
+    {
+        mKeyframeCursors.assign(mJointMotionList->getNumJointMotions(), JointMotion::Cursor());
+    }
+
     for (U32 i=0; i<mJointMotionList->getNumJointMotions(); i++)
     {
         mJointMotionList->getJointMotion(i)->update(mJointStates[i],
                                                       time,
-                                                      mJointMotionList->mDuration );
+                                                      mKeyframeCursors[i]);
     }
 
     LLJoint::JointPriority* pose_priority = (LLJoint::JointPriority* )mCharacter->getAnimationData("Hand Pose Priority");
@@ -2030,6 +2095,8 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
         }
     }
 
+    joint_motion_list->buildCompactCurves();
+
     // *FIX: support cleanup of old keyframe data
     mJointMotionList = joint_motion_list.release(); // release from unique_ptr to member;
     LLKeyframeDataCache::addKeyframeData(getID(),  mJointMotionList);
@@ -37,6 +37,7 @@
 #include "llbboxlocal.h"
 #include "llhandmotion.h"
 #include "lljointstate.h"
+#include "llkeyframecurve.h"
 #include "llmotion.h"
 #include "llquaternion.h"
 #include "v3dmath.h"
@@ -387,7 +388,25 @@ public:
         U32             mUsage;
         LLJoint::JointPriority  mPriority;
 
-        void update(LLJointState* joint_state, F32 time, F32 duration);
+        // immutable copies of the curves above used for playback
+        LLCompactVectorCurve    mCompactPositionCurve;
+        LLCompactRotationCurve  mCompactRotationCurve;
+        LLCompactVectorCurve    mCompactScaleCurve;
+
+        // per motion instance playback position in the compact curves
+        struct Cursor
+        {
+            Cursor() : mPosition(0), mRotation(0), mScale(0) {}
+
+            U32 mPosition;
+            U32 mRotation;
+            U32 mScale;
+        };
+
+        // call once the key maps are final
+        void buildCompactCurves();
+
+        void update(LLJointState* joint_state, F32 time, Cursor& cursor) const;
     };
 
     //-------------------------------------------------------------------------
@@ -419,6 +438,7 @@ public:
         JointMotionList();
         ~JointMotionList();
         U32 dumpDiagInfo();
+        void buildCompactCurves();
         JointMotion* getJointMotion(U32 index) const { llassert(index < mJointMotionArray.size()); return mJointMotionArray[index]; }
         U32 getNumJointMotions() const { return static_cast<U32>(mJointMotionArray.size()); }
     };
@@ -426,6 +446,7 @@ public:
 protected:
     JointMotionList*                mJointMotionList;
     std::vector<LLPointer<LLJointState> > mJointStates;
+    std::vector<JointMotion::Cursor> mKeyframeCursors;
     LLJoint*                        mPelvisp;
     LLCharacter*                    mCharacter;
     typedef std::list<JointConstraint*> constraint_list_t;
@@ -139,6 +139,8 @@ LLMotionController::LLMotionController()
       mTimeStep(0.f),
       mTimeStepCount(0),
       mLastInterp(0.f),
+      mForceUpdate(false),
+      mDeferCallbacks(false),
       mIsSelf(false),
       mLastCountAfterPurge(0)
 {
@@ -517,7 +519,7 @@ void LLMotionController::updateIdleMotion(LLMotion* motionp)
         // this will only be called when an animation stops itself (runs out of time)
         if (mLastTime <= motionp->mSendStopTimestamp)
         {
-            mCharacter->requestStopMotion( motionp );
+            requestStopMotion(motionp);
             stopMotionInstance(motionp, false);
         }
     }
@@ -619,7 +621,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // this will only be called when an animation stops itself (runs out of time)
                 if (mLastTime <= motionp->mSendStopTimestamp)
                 {
-                    mCharacter->requestStopMotion( motionp );
+                    requestStopMotion(motionp);
                     stopMotionInstance(motionp, false);
                 }
             }
@@ -700,7 +702,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // this will only be called when an animation stops itself (runs out of time)
                 if (mLastTime <= motionp->mSendStopTimestamp)
                 {
-                    mCharacter->requestStopMotion( motionp );
+                    requestStopMotion(motionp);
                     stopMotionInstance(motionp, false);
                 }
             }
@@ -746,7 +748,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // animation has stopped itself due to internal logic
                 // propagate this to the network
                 // as not all viewers are guaranteed to have access to the same logic
-                mCharacter->requestStopMotion( motionp );
+                requestStopMotion(motionp);
                 stopMotionInstance(motionp, false);
             }
 
@@ -809,6 +811,19 @@ void LLMotionController::updateLoadingMotions()
 // updateMotion()
 //-----------------------------------------------------------------------------
 void LLMotionController::updateMotions(bool force_update)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (prepareUpdate(force_update, false))
+    {
+        evaluateMotions();
+    }
+    finishUpdate();
+}
+
+//-----------------------------------------------------------------------------
+// prepareUpdate()
+//-----------------------------------------------------------------------------
+bool LLMotionController::prepareUpdate(bool force_update, bool defer_callbacks)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     // SL-763: "Distant animated objects run at super fast speed"
@@ -817,6 +832,9 @@ void LLMotionController::updateMotions(bool force_update)
     // Currently setting mTimeStep to nonzero is disabled elsewhere.
     bool use_quantum = (mTimeStep != 0.f);
 
+    mForceUpdate = force_update;
+    mDeferCallbacks = defer_callbacks;
+
     // Always update mPrevTimerElapsed
     F32 cur_time = mTimer.getElapsedTimeF32();
     F32 delta_time = cur_time - mPrevTimerElapsed;
@@ -848,7 +866,7 @@ void LLMotionController::updateMotions(bool force_update)
 
                 updateLoadingMotions();
 
-                return;
+                return false;
             }
 
             // is calculating a new keyframe pose, make sure the last one gets applied
@@ -867,9 +885,20 @@ void LLMotionController::updateMotions(bool force_update)
 
     updateLoadingMotions();
 
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// evaluateMotions()
+//-----------------------------------------------------------------------------
+void LLMotionController::evaluateMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    bool use_quantum = (mTimeStep != 0.f);
+
     resetJointSignatures();
 
-    if (mPaused && !force_update)
+    if (mPaused && !mForceUpdate)
     {
         updateIdleActiveMotions();
     }
@@ -897,6 +926,54 @@ void LLMotionController::updateMotions(bool force_update)
 //  LL_INFOS() << "Motion controller time " << motionTimer.getElapsedTimeF32() << LL_ENDL;
 }
 
+//-----------------------------------------------------------------------------
+// finishUpdate()
+//-----------------------------------------------------------------------------
+void LLMotionController::finishUpdate()
+{
+    mDeferCallbacks = false;
+
+    // callbacks may queue more callbacks
+    while (!mDeferredCallbacks.empty())
+    {
+        std::vector<std::function<void()> > callbacks;
+        callbacks.swap(mDeferredCallbacks);
+        for (const std::function<void()>& callback : callbacks)
+        {
+            callback();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// deferCallback()
+//-----------------------------------------------------------------------------
+void LLMotionController::deferCallback(const std::function<void()>& callback)
+{
+    if (mDeferCallbacks)
+    {
+        mDeferredCallbacks.push_back(callback);
+    }
+    else
+    {
+        callback();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// requestStopMotion()
+// Tell the character a motion stopped itself. The character may forward
+// this to the simulator, so it is deferred during parallel updates.
+//-----------------------------------------------------------------------------
+void LLMotionController::requestStopMotion(LLMotion* motion)
+{
+    LLCharacter* character = mCharacter;
+    deferCallback([character, motion]()
+        {
+            character->requestStopMotion(motion);
+        });
+}
+
 //-----------------------------------------------------------------------------
 // updateMotionsMinimal()
 // minimal update (e.g. while hidden)
@@ -33,6 +33,8 @@
 #include <string>
 #include <map>
 #include <deque>
+#include <functional>
+#include <vector>
 
 #include "llmotion.h"
 #include "llpose.h"
@@ -132,6 +134,22 @@ public:
     // deactivates terminated motions`
     void updateMotions(bool force_update = false);
 
+    // updateMotions() split into phases, for evaluating many characters in
+    // parallel (see LLCharacter::updateMotionsBatch()).
+    // prepareUpdate() and finishUpdate() must be called on the main thread.
+    // evaluateMotions() only touches this controller's character and may
+    // run on any thread; when defer_callbacks was passed to prepareUpdate(),
+    // work that must stay on the main thread is queued until finishUpdate().
+    // prepareUpdate() returns false if there is nothing to evaluate.
+    bool prepareUpdate(bool force_update, bool defer_callbacks);
+    void evaluateMotions();
+    void finishUpdate();
+
+    // Run callback now, or from finishUpdate() if motions are being
+    // evaluated off the main thread. For motions that need to touch state
+    // shared with other characters, e.g. updateVisualParams().
+    void deferCallback(const std::function<void()>& callback);
+
     // minimal update (e.g. while hidden)
     void updateMotionsMinimal();
 
@@ -191,6 +209,7 @@ protected:
     void updateIdleActiveMotions();
     void purgeExcessMotions();
     void deactivateStoppedMotions();
+    void requestStopMotion(LLMotion* motion);
 
 protected:
     F32                 mTimeFactor;            // 1.f for normal speed
@@ -226,6 +245,10 @@ protected:
     F32                 mTimeStep;
     S32                 mTimeStepCount;
     F32                 mLastInterp;
+    bool                mForceUpdate;
+    bool                mDeferCallbacks;
+
+    std::vector<std::function<void()> > mDeferredCallbacks;
 
     U8                  mJointSignature[2][LL_CHARACTER_MAX_ANIMATED_JOINTS];
 private:
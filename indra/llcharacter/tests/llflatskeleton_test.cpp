@@ -0,0 +1,177 @@
+/**
+ * @file llflatskeleton_test.cpp
+ * @brief LLFlatSkeleton test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../lljoint.h"
+#include "../llflatskeleton.h"
+
+#include "../test/lltut.h"
+
+namespace tut
+{
+    // Two identical hierarchies: one updated recursively, one through
+    // LLFlatSkeleton. Results must agree.
+    struct llflatskeleton_data
+    {
+        static constexpr S32 NUM_JOINTS = 64;
+
+        std::vector<LLJoint*> mReference;
+        std::vector<LLJoint*> mFlat;
+
+        llflatskeleton_data()
+        {
+            for (S32 i = 0; i < NUM_JOINTS; ++i)
+            {
+                mReference.push_back(new LLJoint());
+                mFlat.push_back(new LLJoint());
+            }
+            // deterministic, irregular tree
+            for (S32 i = 1; i < NUM_JOINTS; ++i)
+            {
+                S32 parent = (i * 7 + 3) % i;
+                mReference[parent]->addChild(mReference[i]);
+                mFlat[parent]->addChild(mFlat[i]);
+            }
+        }
+
+        ~llflatskeleton_data()
+        {
+            for (S32 i = NUM_JOINTS - 1; i >= 0; --i)
+            {
+                delete mReference[i];
+                delete mFlat[i];
+            }
+        }
+
+        void pose(S32 seed)
+        {
+            for (S32 i = 0; i < NUM_JOINTS; ++i)
+            {
+                F32 f = (F32)(i + seed);
+                LLVector3 pos(sinf(f), cosf(f * 0.5f), 0.1f * f);
+                LLQuaternion rot(f * 0.3f, LLVector3(sinf(f), 1.f, cosf(f)));
+                LLVector3 scale(1.f + 0.1f * sinf(f), 1.f, 1.f + 0.05f * cosf(f));
+                bool scale_child_offset = (i + seed) % 3 != 0;
+
+                for (LLJoint* joint : { mReference[i], mFlat[i] })
+                {
+                    joint->setPosition(pos);
+                    joint->setRotation(rot);
+                    joint->setScale(scale);
+                    joint->getXform()->setScaleChildOffset(scale_child_offset);
+                }
+            }
+        }
+
+        void ensureMatches(const std::string& msg)
+        {
+            for (S32 i = 0; i < NUM_JOINTS; ++i)
+            {
+                const F32* ref = mReference[i]->getWorldMatrix4a().getF32ptr();
+                const F32* flat = mFlat[i]->getWorldMatrix4a().getF32ptr();
+                for (S32 k = 0; k < 16; ++k)
+                {
+                    ensure_approximately_equals_range(msg.c_str(), flat[k], ref[k], 0.0001f);
+                }
+                ensure(msg + " position", dist_vec(mReference[i]->getWorldPosition(), mFlat[i]->getWorldPosition()) < 0.0001f);
+                ensure(msg + " rotation", mFlat[i]->getWorldRotation().isEqualEps(mReference[i]->getWorldRotation(), 0.0001f));
+            }
+        }
+    };
+    typedef test_group<llflatskeleton_data> llflatskeleton_test;
+    typedef llflatskeleton_test::object llflatskeleton_object;
+    tut::llflatskeleton_test llflatskeleton_testcase("LLFlatSkeleton");
+
+    template<> template<>
+    void llflatskeleton_object::test<1>()
+    {
+        LLFlatSkeleton skeleton;
+        skeleton.setRoot(mFlat[0]);
+        ensure_equals("flattened joint count", skeleton.getNumJoints(), NUM_JOINTS);
+
+        pose(0);
+        mReference[0]->updateWorldMatrixChildren();
+        skeleton.update();
+        ensureMatches("initial pose");
+
+        pose(5);
+        mReference[0]->updateWorldMatrixChildren();
+        skeleton.update();
+        ensureMatches("second pose");
+    }
+
+    template<> template<>
+    void llflatskeleton_object::test<2>()
+    {
+        // disabled subtrees are left alone, as with updateWorldMatrixChildren()
+        LLFlatSkeleton skeleton;
+        skeleton.setRoot(mFlat[0]);
+
+        pose(1);
+        mReference[3]->mUpdateXform = false;
+        mFlat[3]->mUpdateXform = false;
+        mReference[0]->updateWorldMatrixChildren();
+        skeleton.update();
+        ensure("disabled joint left dirty", mFlat[3]->mDirtyFlags & LLJoint::MATRIX_DIRTY);
+
+        mReference[3]->mUpdateXform = true;
+        mFlat[3]->mUpdateXform = true;
+        mReference[0]->updateWorldMatrixChildren();
+        skeleton.update();
+        ensureMatches("re-enabled subtree");
+    }
+
+    template<> template<>
+    void llflatskeleton_object::test<3>()
+    {
+        // reparenting a joint triggers a rebuild of the flattened order
+        LLFlatSkeleton skeleton;
+        skeleton.setRoot(mFlat[0]);
+
+        mReference[1]->addChild(mReference[NUM_JOINTS - 1]);
+        mFlat[1]->addChild(mFlat[NUM_JOINTS - 1]);
+
+        pose(2);
+        mReference[0]->updateWorldMatrixChildren();
+        skeleton.update();
+        ensureMatches("after reparent");
+    }
+
+    template<> template<>
+    void llflatskeleton_object::test<4>()
+    {
+        // batched update of several skeletons
+        LLFlatSkeleton skeleton;
+        skeleton.setRoot(mFlat[0]);
+        std::vector<LLFlatSkeleton*> batch(1, &skeleton);
+
+        pose(3);
+        mReference[0]->updateWorldMatrixChildren();
+        LLFlatSkeleton::updateBatch(batch);
+        ensureMatches("batched");
+    }
+}
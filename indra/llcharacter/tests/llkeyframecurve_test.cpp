@@ -0,0 +1,275 @@
+/**
+ * @file llkeyframecurve_test.cpp
+ * @brief LLCompactKeyframeCurve test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <map>
+
+#include "../llkeyframecurve.h"
+
+#include "../test/lltut.h"
+
+namespace tut
+{
+    // Reference curves using the same std::map lookup as
+    // LLKeyframeMotion::PositionCurve::getValue() and friends.
+    template <class T>
+    struct reference_curve
+    {
+        std::map<F32, T> mKeys;
+
+        template <class INTERP>
+        T getValue(F32 time, INTERP interp) const
+        {
+            typename std::map<F32, T>::const_iterator right = mKeys.lower_bound(time);
+            if (right == mKeys.end())
+            {
+                --right;
+                return right->second;
+            }
+            if (right == mKeys.begin() || right->first == time)
+            {
+                return right->second;
+            }
+            typename std::map<F32, T>::const_iterator left = right; --left;
+            F32 u = (time - left->first) / (right->first - left->first);
+            return interp(u, left->second, right->second);
+        }
+    };
+
+    struct llkeyframecurve_data
+    {
+        static LLVector3 lerp_vector(F32 u, const LLVector3& a, const LLVector3& b)
+        {
+            return lerp(a, b, u);
+        }
+
+        static LLQuaternion nlerp_rotation(F32 u, const LLQuaternion& a, const LLQuaternion& b)
+        {
+            return nlerp(u, a, b);
+        }
+
+        // deterministic pseudo random curves
+        static void makeKeys(U32 seed, U32 num_keys, F32 duration,
+                             std::vector<F32>& times,
+                             std::vector<LLVector3>& positions,
+                             std::vector<LLQuaternion>& rotations)
+        {
+            times.clear();
+            positions.clear();
+            rotations.clear();
+            for (U32 i = 0; i < num_keys; ++i)
+            {
+                U32 h = (i + 1) * 2654435761u + seed * 40503u;
+                times.push_back(duration * (F32)i / (F32)num_keys + (F32)(h % 7) * 0.001f);
+                positions.push_back(LLVector3((F32)(h % 101) * 0.01f - 0.5f,
+                                              (F32)(h % 37) * 0.02f,
+                                              -(F32)(h % 13) * 0.1f));
+                LLQuaternion q;
+                q.setAngleAxis((F32)(h % 360) * DEG_TO_RAD,
+                               LLVector3((F32)(h % 5) + 0.1f, (F32)(h % 3), 1.f));
+                // flip some keys into the opposite hemisphere to exercise
+                // nlerp's slerp path
+                if (h % 4 == 0)
+                {
+                    q = -q;
+                }
+                rotations.push_back(q);
+            }
+        }
+    };
+    typedef test_group<llkeyframecurve_data> llkeyframecurve_t;
+    typedef llkeyframecurve_t::object llkeyframecurve_object_t;
+    tut::llkeyframecurve_t tut_llkeyframecurve("LLCompactKeyframeCurve");
+
+    void ensure_vector(const char* msg, const LLVector3& expected, const LLVector4a& actual)
+    {
+        for (S32 c = 0; c < 3; ++c)
+        {
+            ensure_approximately_equals_range(msg, actual.getF32ptr()[c], expected.mV[c], 0.0001f);
+        }
+    }
+
+    void ensure_rotation(const char* msg, const LLQuaternion& expected, const LLQuaternion2& actual)
+    {
+        const F32* q = actual.getVector4a().getF32ptr();
+        for (S32 c = 0; c < 4; ++c)
+        {
+            ensure_approximately_equals_range(msg, q[c], expected.mQ[c], 0.001f);
+        }
+    }
+
+    // forward playback, looping playback and random access all match the
+    // map based curves
+    template<> template<>
+    void llkeyframecurve_object_t::test<1>()
+    {
+        std::vector<F32> times;
+        std::vector<LLVector3> positions;
+        std::vector<LLQuaternion> rotations;
+        makeKeys(1, 40, 2.f, times, positions, rotations);
+
+        reference_curve<LLVector3> ref_position;
+        reference_curve<LLQuaternion> ref_rotation;
+        for (size_t i = 0; i < times.size(); ++i)
+        {
+            ref_position.mKeys[times[i]] = positions[i];
+            ref_rotation.mKeys[times[i]] = rotations[i];
+        }
+
+        LLCompactVectorCurve position_curve;
+        LLCompactRotationCurve rotation_curve;
+        position_curve.init(times, positions, false);
+        rotation_curve.init(times, rotations, false);
+        ensure_equals("num keys", position_curve.getNumKeys(), (U32)times.size());
+
+        U32 position_cursor = 0;
+        U32 rotation_cursor = 0;
+        LLVector4a position;
+        LLQuaternion2 rotation;
+
+        // forward, twice round a loop, with some samples outside the curve
+        for (S32 frame = 0; frame < 1000; ++frame)
+        {
+            F32 time = fmodf((F32)frame * 0.0051f, 2.2f) - 0.1f;
+            position_curve.sample(time, position_cursor, position);
+            rotation_curve.sample(time, rotation_cursor, rotation);
+            ensure_vector("forward position", ref_position.getValue(time, lerp_vector), position);
+            ensure_rotation("forward rotation", ref_rotation.getValue(time, nlerp_rotation), rotation);
+        }
+
+        // exactly on the keys
+        for (F32 time : times)
+        {
+            position_curve.sample(time, position_cursor, position);
+            rotation_curve.sample(time, rotation_cursor, rotation);
+            ensure_vector("key position", ref_position.getValue(time, lerp_vector), position);
+            ensure_rotation("key rotation", ref_rotation.getValue(time, nlerp_rotation), rotation);
+        }
+
+        // random access
+        for (U32 i = 0; i < 500; ++i)
+        {
+            F32 time = (F32)((i * 7919u) % 2000u) * 0.001f;
+            position_curve.sample(time, position_cursor, position);
+            rotation_curve.sample(time, rotation_cursor, rotation);
+            ensure_vector("random position", ref_position.getValue(time, lerp_vector), position);
+            ensure_rotation("random rotation", ref_rotation.getValue(time, nlerp_rotation), rotation);
+        }
+    }
+
+    // step interpolation holds the earlier key
+    template<> template<>
+    void llkeyframecurve_object_t::test<2>()
+    {
+        std::vector<F32> times;
+        std::vector<LLVector3> positions;
+        std::vector<LLQuaternion> rotations;
+        makeKeys(2, 10, 1.f, times, positions, rotations);
+
+        LLCompactVectorCurve position_curve;
+        position_curve.init(times, positions, true);
+
+        U32 cursor = 0;
+        LLVector4a position;
+        for (size_t i = 0; i + 1 < times.size(); ++i)
+        {
+            F32 time = lerp(times[i], times[i + 1], 0.75f);
+            position_curve.sample(time, cursor, position);
+            ensure_vector("step", positions[i], position);
+        }
+    }
+
+    // empty and single key curves
+    template<> template<>
+    void llkeyframecurve_object_t::test<3>()
+    {
+        LLCompactVectorCurve position_curve;
+        LLCompactRotationCurve rotation_curve;
+        ensure("empty", position_curve.isEmpty());
+
+        U32 cursor = 0;
+        LLVector4a position;
+        LLQuaternion2 rotation;
+        position_curve.sample(1.f, cursor, position);
+        ensure_vector("empty position", LLVector3::zero, position);
+        rotation_curve.sample(1.f, cursor, rotation);
+        ensure_rotation("empty rotation", LLQuaternion::DEFAULT, rotation);
+
+        std::vector<F32> times(1, 0.5f);
+        std::vector<LLVector3> positions(1, LLVector3(1.f, 2.f, 3.f));
+        position_curve.init(times, positions, false);
+        position_curve.sample(0.f, cursor, position);
+        ensure_vector("single key before", positions[0], position);
+        position_curve.sample(1.f, cursor, position);
+        ensure_vector("single key after", positions[0], position);
+    }
+
+    // a curve shared by several avatars, each playing it from its own
+    // offset with its own cursor
+    template<> template<>
+    void llkeyframecurve_object_t::test<4>()
+    {
+        constexpr U32 NUM_ANIMATIONS = 2;
+        constexpr U32 NUM_JOINTS = 3;
+        constexpr U32 NUM_KEYS = 20;
+        constexpr U32 NUM_AVATARS = 5;
+        constexpr U32 NUM_FRAMES = 60;
+        constexpr F32 DURATION = 4.f;
+
+        std::vector<reference_curve<LLQuaternion> > ref_curves(NUM_ANIMATIONS * NUM_JOINTS);
+        std::vector<LLCompactRotationCurve> compact_curves(NUM_ANIMATIONS * NUM_JOINTS);
+        std::vector<F32> times;
+        std::vector<LLVector3> positions;
+        std::vector<LLQuaternion> rotations;
+        for (U32 i = 0; i < ref_curves.size(); ++i)
+        {
+            makeKeys(i, NUM_KEYS, DURATION, times, positions, rotations);
+            for (U32 k = 0; k < NUM_KEYS; ++k)
+            {
+                ref_curves[i].mKeys[times[k]] = rotations[k];
+            }
+            compact_curves[i].init(times, rotations, false);
+        }
+
+        std::vector<U32> cursors(NUM_AVATARS * NUM_JOINTS, 0);
+        for (U32 frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            for (U32 avatar = 0; avatar < NUM_AVATARS; ++avatar)
+            {
+                U32 anim = avatar % NUM_ANIMATIONS;
+                F32 time = fmodf((F32)frame / 15.f + (F32)avatar * 0.37f, DURATION);
+                for (U32 joint = 0; joint < NUM_JOINTS; ++joint)
+                {
+                    U32 curve = anim * NUM_JOINTS + joint;
+                    LLQuaternion2 q;
+                    compact_curves[curve].sample(time, cursors[avatar * NUM_JOINTS + joint], q);
+                    ensure_rotation("shared rotation", ref_curves[curve].getValue(time, nlerp_rotation), q);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,357 @@
+/**
+ * @file llmotioncontroller_test.cpp
+ * @brief LLMotionController parallel update test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "../llcharacter.h"
+#include "../llkeyframemotion.h"
+#include "lldatapacker.h"
+#include "llquantize.h"
+#include "llframetimer.h"
+#include "lltimer.h"
+#include "threadpool.h"
+
+#include "../test/lltut.h"
+
+namespace
+{
+    // name, parent index
+    const struct { const char* mName; S32 mParent; } TEST_SKELETON[] =
+    {
+        { "mPelvis",        -1 },
+        { "mTorso",          0 },
+        { "mChest",          1 },
+        { "mNeck",           2 },
+        { "mHead",           3 },
+        { "mCollarLeft",     2 },
+        { "mShoulderLeft",   5 },
+        { "mElbowLeft",      6 },
+        { "mWristLeft",      7 },
+        { "mCollarRight",    2 },
+        { "mShoulderRight",  9 },
+        { "mElbowRight",    10 },
+        { "mWristRight",    11 },
+        { "mHipLeft",        0 },
+        { "mKneeLeft",      13 },
+        { "mAnkleLeft",     14 },
+        { "mHipRight",       0 },
+        { "mKneeRight",     16 },
+        { "mAnkleRight",    17 },
+    };
+    constexpr S32 NUM_TEST_JOINTS = LL_ARRAY_SIZE(TEST_SKELETON);
+
+    // Minimal headless character: a small skeleton and nothing else.
+    class LLTestCharacter : public LLCharacter
+    {
+    public:
+        LLTestCharacter()
+        :   mRoot("mRoot")
+        {
+            mID.generate();
+            for (S32 i = 0; i < NUM_TEST_JOINTS; ++i)
+            {
+                LLJoint* parent = TEST_SKELETON[i].mParent < 0 ? &mRoot : mJoints[TEST_SKELETON[i].mParent];
+                LLJoint* joint = new LLJoint(TEST_SKELETON[i].mName, parent);
+                joint->setJointNum(i);
+                joint->setPosition(LLVector3(0.f, 0.f, 0.1f));
+                mJoints.push_back(joint);
+            }
+        }
+
+        ~LLTestCharacter()
+        {
+            // motions hold joint states, release them before the joints
+            flushAllMotions();
+            for (S32 i = NUM_TEST_JOINTS - 1; i >= 0; --i)
+            {
+                delete mJoints[i];
+            }
+        }
+
+        const char* getAnimationPrefix() override { return "avatar"; }
+        LLJoint* getRootJoint() override { return &mRoot; }
+        LLVector3 getCharacterPosition() override { return LLVector3::zero; }
+        LLQuaternion getCharacterRotation() override { return LLQuaternion::DEFAULT; }
+        LLVector3 getCharacterVelocity() override { return LLVector3::zero; }
+        LLVector3 getCharacterAngularVelocity() override { return LLVector3::zero; }
+        void getGround(const LLVector3& in_pos, LLVector3& out_pos, LLVector3& out_norm) override
+        {
+            out_pos = in_pos;
+            out_pos.mV[VZ] = 0.f;
+            out_norm = LLVector3::z_axis;
+        }
+        LLJoint* getCharacterJoint(U32 i) override { return i < (U32)NUM_TEST_JOINTS ? mJoints[i] : NULL; }
+        F32 getTimeDilation() override { return 1.f; }
+        F32 getPixelArea() const override { return 10000.f; }
+        LLPolyMesh* getHeadMesh() override { return NULL; }
+        LLPolyMesh* getUpperBodyMesh() override { return NULL; }
+        LLVector3d getPosGlobalFromAgent(const LLVector3& position) override { return LLVector3d(position); }
+        LLVector3 getPosAgentFromGlobal(const LLVector3d& position) override { return LLVector3(position); }
+        void addDebugText(const std::string& text) override {}
+        const LLUUID& getID() const override { return mID; }
+
+        LLJoint                 mRoot;
+        std::vector<LLJoint*>   mJoints;
+        LLUUID                  mID;
+    };
+
+    // Write a looping .anim asset in the format LLKeyframeMotion::deserialize()
+    // reads, with a rotation curve on every joint of the test skeleton and a
+    // position curve on the pelvis.
+    std::vector<U8> make_anim(U32 seed, S32 num_keys, F32 duration)
+    {
+        std::vector<U8> buffer(64 * 1024);
+        LLDataPackerBinaryBuffer dp(buffer.data(), (S32)buffer.size());
+        dp.packU16(KEYFRAME_MOTION_VERSION, "version");
+        dp.packU16(KEYFRAME_MOTION_SUBVERSION, "sub_version");
+        dp.packS32(3, "base_priority");
+        dp.packF32(duration, "duration");
+        dp.packString("", "emote_name");
+        dp.packF32(0.f, "loop_in_point");
+        dp.packF32(duration, "loop_out_point");
+        dp.packS32(1, "loop");
+        dp.packF32(0.3f, "ease_in_duration");
+        dp.packF32(0.3f, "ease_out_duration");
+        dp.packU32(0, "hand_pose");
+        dp.packU32(NUM_TEST_JOINTS, "num_joints");
+        for (S32 j = 0; j < NUM_TEST_JOINTS; ++j)
+        {
+            dp.packString(TEST_SKELETON[j].mName, "joint_name");
+            dp.packS32(3, "joint_priority");
+            dp.packS32(num_keys, "num_rot_keys");
+            for (S32 k = 0; k < num_keys; ++k)
+            {
+                F32 f = (F32)(seed * 31 + j * 7 + k);
+                LLQuaternion q(0.6f * sinf(f), LLVector3(sinf(f * 0.3f), cosf(f * 0.7f), 0.5f));
+                LLVector3 packed = q.packToVector3();
+                dp.packU16(F32_to_U16((F32)k / (F32)(num_keys - 1) * duration, 0.f, duration), "time");
+                dp.packU16(F32_to_U16(packed.mV[VX], -1.f, 1.f), "rot_angle_x");
+                dp.packU16(F32_to_U16(packed.mV[VY], -1.f, 1.f), "rot_angle_y");
+                dp.packU16(F32_to_U16(packed.mV[VZ], -1.f, 1.f), "rot_angle_z");
+            }
+            S32 num_pos_keys = (j == 0) ? num_keys : 0;
+            dp.packS32(num_pos_keys, "num_pos_keys");
+            for (S32 k = 0; k < num_pos_keys; ++k)
+            {
+                F32 f = (F32)(seed + k);
+                dp.packU16(F32_to_U16((F32)k / (F32)(num_keys - 1) * duration, 0.f, duration), "time");
+                dp.packU16(F32_to_U16(0.1f * sinf(f), -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET), "pos_x");
+                dp.packU16(F32_to_U16(0.1f * cosf(f), -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET), "pos_y");
+                dp.packU16(F32_to_U16(0.05f * sinf(f * 2.f), -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET), "pos_z");
+            }
+        }
+        dp.packS32(0, "num_constraints");
+        buffer.resize(dp.getCurrentSize());
+        return buffer;
+    }
+
+    // Deserialize an asset into LLKeyframeDataCache so that every character
+    // starting the motion shares the decoded data, as in the viewer.
+    bool cache_anim(LLCharacter& character, const LLUUID& id, std::vector<U8>& buffer)
+    {
+        LLKeyframeMotion loader(id);
+        loader.setCharacter(&character);
+        LLDataPackerBinaryBuffer dp(buffer.data(), (S32)buffer.size());
+        return loader.deserialize(dp, id, true);
+    }
+}
+
+namespace tut
+{
+    struct llmotioncontroller_data
+    {
+        std::vector<LLUUID> mAnimations;
+
+        ~llmotioncontroller_data()
+        {
+            for (const LLUUID& id : mAnimations)
+            {
+                LLKeyframeDataCache::removeKeyframeData(id);
+            }
+        }
+
+        // Synthetic animations, followed by any .anim files found in the
+        // directory named by LL_TEST_ANIM_DIR.
+        void loadAnimations(LLCharacter& character, U32 num_synthetic)
+        {
+            for (U32 i = 0; i < num_synthetic; ++i)
+            {
+                std::vector<U8> buffer = make_anim(i, 30, 2.f + (F32)i * 0.25f);
+                LLUUID id;
+                id.generate();
+                ensure("synthetic animation deserialized", cache_anim(character, id, buffer));
+                mAnimations.push_back(id);
+            }
+
+            const char* anim_dir = getenv("LL_TEST_ANIM_DIR");
+            if (!anim_dir || !*anim_dir)
+            {
+                return;
+            }
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(anim_dir))
+            {
+                if (entry.path().extension() != ".anim")
+                {
+                    continue;
+                }
+                std::ifstream file(entry.path(), std::ios::binary);
+                std::vector<U8> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                LLUUID id;
+                id.generate();
+                // joints the test skeleton lacks are skipped
+                if (!buffer.empty() && cache_anim(character, id, buffer))
+                {
+                    mAnimations.push_back(id);
+                }
+            }
+        }
+
+        void startAnimations(std::vector<LLTestCharacter*>& characters)
+        {
+            for (size_t i = 0; i < characters.size(); ++i)
+            {
+                const LLUUID& id = mAnimations[i % mAnimations.size()];
+                characters[i]->registerMotion(id, LLKeyframeMotion::create);
+                characters[i]->startMotion(id, (F32)i * 0.1f);
+            }
+        }
+
+        static void deleteCharacters(std::vector<LLTestCharacter*>& characters)
+        {
+            for (LLTestCharacter* character : characters)
+            {
+                delete character;
+            }
+            characters.clear();
+        }
+    };
+    typedef test_group<llmotioncontroller_data> llmotioncontroller_t;
+    typedef llmotioncontroller_t::object llmotioncontroller_object_t;
+    tut::llmotioncontroller_t tut_llmotioncontroller("LLMotionController");
+
+    // updateMotionsBatch() poses every character exactly as updateMotions()
+    template<> template<>
+    void llmotioncontroller_object_t::test<1>()
+    {
+        constexpr S32 NUM_CHARACTERS = 24;
+        constexpr S32 NUM_FRAMES = 30;
+
+        LL::ThreadPool pool("General", 3);
+        pool.start();
+
+        LLTestCharacter loader;
+        loadAnimations(loader, 4);
+
+        std::vector<LLTestCharacter*> serial;
+        std::vector<LLTestCharacter*> batched;
+        for (S32 i = 0; i < NUM_CHARACTERS; ++i)
+        {
+            serial.push_back(new LLTestCharacter);
+            batched.push_back(new LLTestCharacter);
+        }
+        startAnimations(serial);
+        startAnimations(batched);
+        std::vector<LLCharacter*> batch(batched.begin(), batched.end());
+
+        for (S32 frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            ms_sleep(2);
+            LLFrameTimer::updateFrameTime();
+
+            for (LLTestCharacter* character : serial)
+            {
+                character->updateMotions(LLCharacter::NORMAL_UPDATE);
+            }
+            LLCharacter::updateMotionsBatch(batch, LLCharacter::NORMAL_UPDATE);
+
+            for (S32 i = 0; i < NUM_CHARACTERS; ++i)
+            {
+                for (S32 j = 0; j < NUM_TEST_JOINTS; ++j)
+                {
+                    LLJoint* expected = serial[i]->mJoints[j];
+                    LLJoint* actual = batched[i]->mJoints[j];
+                    ensure_equals("rotation", actual->getRotation(), expected->getRotation());
+                    ensure_equals("position", actual->getPosition(), expected->getPosition());
+                }
+            }
+        }
+
+        deleteCharacters(serial);
+        deleteCharacters(batched);
+        pool.close();
+    }
+
+    // characters can switch between updateMotions() and updateMotionsBatch()
+    // from one frame to the next
+    template<> template<>
+    void llmotioncontroller_object_t::test<2>()
+    {
+        constexpr S32 NUM_CHARACTERS = 8;
+        constexpr S32 NUM_FRAMES = 10;
+
+        LL::ThreadPool pool("General", 3);
+        pool.start();
+
+        LLTestCharacter loader;
+        loadAnimations(loader, 4);
+
+        std::vector<LLTestCharacter*> characters;
+        for (S32 i = 0; i < NUM_CHARACTERS; ++i)
+        {
+            characters.push_back(new LLTestCharacter);
+        }
+        startAnimations(characters);
+        std::vector<LLCharacter*> batch(characters.begin(), characters.end());
+
+        for (S32 frame = 0; frame < NUM_FRAMES; ++frame)
+        {
+            ms_sleep(1);
+            LLFrameTimer::updateFrameTime();
+            if (frame % 2)
+            {
+                LLCharacter::updateMotionsBatch(batch, LLCharacter::NORMAL_UPDATE);
+            }
+            else
+            {
+                for (LLCharacter* character : batch)
+                {
+                    character->updateMotions(LLCharacter::NORMAL_UPDATE);
+                }
+            }
+        }
+
+        for (S32 i = 0; i < NUM_CHARACTERS; ++i)
+        {
+            ensure("looping motion active", characters[i]->isMotionActive(mAnimations[i % mAnimations.size()]));
+        }
+
+        deleteCharacters(characters);
+        pool.close();
+    }
+}
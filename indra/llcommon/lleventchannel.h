@@ -0,0 +1,266 @@
+/**
+ * @file   lleventchannel.h
+ * @date   2026-10-18
+ * @brief  LLEventChannel: LLEventStream for typed events pushed from any
+ *         thread without locking
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLEVENTCHANNEL_H)
+#define LL_LLEVENTCHANNEL_H
+
+#include "llevents.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * LLEventChannel is an LLEventStream for one kind of event that gets posted
+ * often, possibly from other threads.
+ *
+ * push() accepts a T from any thread. It links a queue node in with a single
+ * atomic exchange: no mutex, no LLSD, no boost::signals2. flush() hands
+ * everything pushed so far to the listenTyped() listeners, on the thread
+ * calling flush(). The channel flushes itself on "mainloop", so typed
+ * listeners run on the main thread once per frame, and a worker thread
+ * doesn't need to queue a task to the main thread just to post an event.
+ *
+ * The channel registers with LLEventPumps under its name like any other
+ * LLEventStream: obtain() finds it, and LLSD listen() and post() work as
+ * usual. Given a converter, flush() also posts each typed event to LLSD
+ * listeners, so an event only gets boxed into LLSD when an LLSD listener
+ * exists.
+ *
+ * Construct, destroy, listen and flush on the main thread. Only push() is
+ * thread-safe.
+ */
+template <typename T>
+class LLEventChannel: public LLEventStream
+{
+public:
+    typedef std::function<void(const T&)> Listener;
+    typedef std::function<LLSD(const T&)> Converter;
+
+    LLEventChannel(const std::string& name, const Converter& converter=Converter(), bool tweak=false):
+        LLEventStream(name, tweak),
+        mConverter(converter),
+        mHead(&mStub),
+        mTail(&mStub),
+        mPending(0)
+    {
+        mMainloop = LLEventPumps::instance().obtain("mainloop").listen(
+            LLEventPump::inventName("LLEventChannel"),
+            [this](const LLSD&)
+            {
+                flush();
+                return false;
+            });
+    }
+
+    virtual ~LLEventChannel()
+    {
+        mMainloop.disconnect();
+        while (Node* node = pop())
+        {
+            delete node;
+        }
+    }
+
+    /// Queue an event for the next flush(). Safe from any thread.
+    void push(T event)
+    {
+        Node* node = new Node(std::move(event));
+        mPending.fetch_add(1, std::memory_order_relaxed);
+        link(node);
+    }
+
+    /// Events pushed but not yet delivered
+    size_t pending() const { return mPending.load(std::memory_order_relaxed); }
+
+    /// Register a typed listener. A listener of the same name gets replaced.
+    void listenTyped(const std::string& name, const Listener& listener)
+    {
+        for (auto& entry : mListeners)
+        {
+            if (entry.first == name)
+            {
+                entry.second = listener;
+                return;
+            }
+        }
+        mListeners.emplace_back(name, listener);
+    }
+
+    void stopListeningTyped(const std::string& name)
+    {
+        for (auto& entry : mListeners)
+        {
+            if (entry.first == name)
+            {
+                // erased once no flush() is walking mListeners
+                entry.second = Listener();
+                mRemoved = true;
+            }
+        }
+        if (!mFlushing)
+        {
+            compactListeners();
+        }
+    }
+
+    /**
+     * Deliver the events pushed so far. Events pushed while delivering,
+     * e.g. by a listener, wait for the next flush(). Events are dropped
+     * while the channel is disabled, as post() does.
+     */
+    virtual void flush() override
+    {
+        size_t budget = mPending.load(std::memory_order_acquire);
+        if (!budget || mFlushing)
+        {
+            return;
+        }
+
+        mFlushing = true;
+        size_t delivered = 0;
+        while (delivered < budget)
+        {
+            Node* node = pop();
+            if (!node)
+            {
+                // a push() halfway done, the rest come next time
+                break;
+            }
+            ++delivered;
+            if (mEnabled)
+            {
+                deliver(node->mEvent);
+            }
+            delete node;
+        }
+        mPending.fetch_sub(delivered, std::memory_order_relaxed);
+        mFlushing = false;
+
+        if (mRemoved)
+        {
+            compactListeners();
+        }
+    }
+
+private:
+    struct NodeBase
+    {
+        std::atomic<NodeBase*> mNext{ nullptr };
+    };
+
+    struct Node: public NodeBase
+    {
+        Node(T&& event): mEvent(std::move(event)) {}
+        T mEvent;
+    };
+
+    void deliver(const T& event)
+    {
+        // by index: listeners may add listeners
+        for (size_t i = 0; i < mListeners.size(); ++i)
+        {
+            if (mListeners[i].second)
+            {
+                mListeners[i].second(event);
+            }
+        }
+        if (mConverter && mSignal && ! mSignal->empty())
+        {
+            LLEventStream::post(mConverter(event));
+        }
+    }
+
+    void compactListeners()
+    {
+        mListeners.erase(std::remove_if(mListeners.begin(), mListeners.end(),
+                                        [](const auto& entry) { return !entry.second; }),
+                         mListeners.end());
+        mRemoved = false;
+    }
+
+    // Multiple producer, single consumer queue of nodes (Dmitry Vyukov's
+    // intrusive MPSC queue). Producers only touch mHead, the consumer walks
+    // from mTail. mStub keeps the queue from ever being empty of nodes.
+    void link(NodeBase* node)
+    {
+        node->mNext.store(nullptr, std::memory_order_relaxed);
+        NodeBase* prev = mHead.exchange(node, std::memory_order_acq_rel);
+        prev->mNext.store(node, std::memory_order_release);
+    }
+
+    Node* pop()
+    {
+        NodeBase* tail = mTail;
+        NodeBase* next = tail->mNext.load(std::memory_order_acquire);
+        if (tail == &mStub)
+        {
+            if (!next)
+            {
+                return nullptr;
+            }
+            mTail = next;
+            tail = next;
+            next = next->mNext.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            mTail = next;
+            return static_cast<Node*>(tail);
+        }
+        if (tail != mHead.load(std::memory_order_acquire))
+        {
+            // a producer swapped mHead but hasn't linked its node yet
+            return nullptr;
+        }
+        // tail is the last node: put the stub behind it so it can be taken
+        link(&mStub);
+        next = tail->mNext.load(std::memory_order_acquire);
+        if (next)
+        {
+            mTail = next;
+            return static_cast<Node*>(tail);
+        }
+        return nullptr;
+    }
+
+    Converter mConverter;
+    std::vector<std::pair<std::string, Listener>> mListeners;
+    bool mFlushing = false;
+    bool mRemoved = false;
+    LLTempBoundListener mMainloop;
+
+    NodeBase mStub;
+    std::atomic<NodeBase*> mHead;
+    NodeBase* mTail;
+    std::atomic<size_t> mPending;
+};
+
+#endif /* ! defined(LL_LLEVENTCHANNEL_H) */
@@ -0,0 +1,107 @@
+/**
+ * @file   llframearena.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llframearena.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llframearena.h"
+// STL headers
+#include <algorithm>
+// other Linden headers
+#include "llthread.h"
+
+bool LLFrameArena::sEnabled = true;
+size_t LLFrameArena::sLastFrameBytes = 0;
+size_t LLFrameArena::sLastFrameHeapBytes = 0;
+size_t LLFrameArena::sFrameBytes = 0;
+size_t LLFrameArena::sFrameHeapBytes = 0;
+
+namespace
+{
+    LLFrameArena sArenas[2];
+    U32 sCurrentArena = 0;
+}
+
+LLFrameArena::LLFrameArena(size_t block_size)
+    : mBlockSize(block_size)
+{
+}
+
+LLFrameArena::~LLFrameArena()
+{
+    for (Block& block : mBlocks)
+    {
+        ::operator delete(block.mData);
+    }
+}
+
+void* LLFrameArena::allocate(size_t size, size_t alignment)
+{
+    llassert(alignment && !(alignment & (alignment - 1)));
+
+    while (mBlock < mBlocks.size())
+    {
+        Block& block = mBlocks[mBlock];
+        // align the address, block.mData itself is only aligned to 16
+        size_t offset = ((size_t)(block.mData + mOffset) + alignment - 1) & ~(alignment - 1);
+        offset -= (size_t)block.mData;
+        if (offset + size <= block.mSize)
+        {
+            mOffset = offset + size;
+            mBytesUsed += size;
+            return block.mData + offset;
+        }
+        // the rest of this block is wasted until the next reset()
+        ++mBlock;
+        mOffset = 0;
+    }
+
+    // operator new memory is aligned for any fundamental type, larger
+    // alignments get slack
+    size_t block_size = std::max(mBlockSize, size + alignment);
+    Block block{ static_cast<char*>(::operator new(block_size)), block_size };
+    mBlocks.push_back(block);
+    mBytesReserved += block_size;
+    LLFrameArena::sFrameHeapBytes += block_size;
+
+    mBlock = mBlocks.size() - 1;
+    size_t offset = ((size_t)block.mData + alignment - 1) & ~(alignment - 1);
+    offset -= (size_t)block.mData;
+    mOffset = offset + size;
+    mBytesUsed += size;
+    return block.mData + offset;
+}
+
+void LLFrameArena::reset()
+{
+    mBlock = 0;
+    mOffset = 0;
+    mBytesUsed = 0;
+}
+
+//static
+LLFrameArena& LLFrameArena::current()
+{
+    llassert(on_main_thread());
+    return sArenas[sCurrentArena];
+}
+
+//static
+void LLFrameArena::endFrame()
+{
+    llassert(on_main_thread());
+    sCurrentArena = 1 - sCurrentArena;
+    sArenas[sCurrentArena].reset();
+
+    sLastFrameBytes = sFrameBytes;
+    sLastFrameHeapBytes = sFrameHeapBytes;
+    sFrameBytes = 0;
+    sFrameHeapBytes = 0;
+}
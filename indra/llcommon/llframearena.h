@@ -0,0 +1,135 @@
+/**
+ * @file   llframearena.h
+ * @date   2026-10-18
+ * @brief  Linear allocator for memory that only lives for a frame or two.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLFRAMEARENA_H)
+#define LL_LLFRAMEARENA_H
+
+#include <cstddef>
+#include <list>
+#include <vector>
+
+/**
+ * LLFrameArena hands out memory from large blocks by bumping an offset, and
+ * takes all of it back at once in reset(). Blocks are kept across resets, so
+ * once the arena has grown to what a frame needs, allocating from it no longer
+ * touches the heap.
+ *
+ * The viewer keeps two arenas for the main thread and switches between them
+ * in endFrame(), so memory from current() stays valid until the end of the
+ * frame after the one it was allocated in.
+ */
+class LLFrameArena
+{
+public:
+    LLFrameArena(size_t block_size = 256 * 1024);
+    ~LLFrameArena();
+
+    LLFrameArena(const LLFrameArena&) = delete;
+    LLFrameArena& operator=(const LLFrameArena&) = delete;
+
+    // never returns nullptr, alignment must be a power of two
+    void* allocate(size_t size, size_t alignment);
+    // forget every allocation, keeping the blocks for reuse
+    void reset();
+
+    // bytes handed out since the last reset()
+    size_t getBytesUsed() const     { return mBytesUsed; }
+    // bytes held in blocks
+    size_t getBytesReserved() const { return mBytesReserved; }
+
+    // Arena of the current frame. Main thread only.
+    static LLFrameArena& current();
+    // Switch current() to the other arena and reset it. Called once per frame.
+    static void endFrame();
+
+    // when false, LLFrameAllocators created from now on use the heap
+    static bool sEnabled;
+
+    // bytes requested through LLFrameAllocators during the last complete frame,
+    // and how many of those bytes came from the heap
+    static size_t sLastFrameBytes;
+    static size_t sLastFrameHeapBytes;
+    // running totals for the frame in progress, see LLFrameAllocator
+    static size_t sFrameBytes;
+    static size_t sFrameHeapBytes;
+
+private:
+    struct Block
+    {
+        char*   mData;
+        size_t  mSize;
+    };
+
+    std::vector<Block>  mBlocks;
+    size_t              mBlock = 0;     // index of the block being allocated from
+    size_t              mOffset = 0;    // first free byte of that block
+    size_t              mBlockSize;
+    size_t              mBytesUsed = 0;
+    size_t              mBytesReserved = 0;
+};
+
+/**
+ * STL allocator drawing from LLFrameArena::current(), or from the heap when
+ * LLFrameArena::sEnabled was false at construction. deallocate() does nothing
+ * for arena memory, so containers using it must not outlive the frame after
+ * the one they were created in.
+ */
+template <typename T>
+class LLFrameAllocator
+{
+public:
+    typedef T value_type;
+
+    LLFrameAllocator() noexcept
+        : mArena(LLFrameArena::sEnabled ? &LLFrameArena::current() : nullptr)
+    {}
+
+    template <typename U>
+    LLFrameAllocator(const LLFrameAllocator<U>& other) noexcept
+        : mArena(other.mArena)
+    {}
+
+    T* allocate(size_t n)
+    {
+        size_t bytes = n * sizeof(T);
+        LLFrameArena::sFrameBytes += bytes;
+        if (mArena)
+        {
+            return static_cast<T*>(mArena->allocate(bytes, alignof(T)));
+        }
+        LLFrameArena::sFrameHeapBytes += bytes;
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void deallocate(T* p, size_t) noexcept
+    {
+        if (!mArena)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const LLFrameAllocator<U>& other) const noexcept { return mArena == other.mArena; }
+    template <typename U>
+    bool operator!=(const LLFrameAllocator<U>& other) const noexcept { return mArena != other.mArena; }
+
+private:
+    template <typename U> friend class LLFrameAllocator;
+
+    LLFrameArena* mArena;
+};
+
+template <typename T>
+using LLFrameVector = std::vector<T, LLFrameAllocator<T>>;
+template <typename T>
+using LLFrameList = std::list<T, LLFrameAllocator<T>>;
+
+#endif /* ! defined(LL_LLFRAMEARENA_H) */
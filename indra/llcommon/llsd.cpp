@@ -37,6 +37,9 @@
 #include "llsdserialize.h"
 #include "stringize.h"
 
+#include <atomic>
+#include <new>
+#include <cmath>
 #include <limits>
 
 // Defend against a caller forcibly passing a negative number into an unsigned
@@ -98,11 +101,21 @@ protected:
 
     virtual ~Impl();
 
-    bool shared() const                         { return (mUseCount > 1) && (mUseCount != STATIC_USAGE_COUNT); }
+    bool shared() const                         { return mUseCount > 1; }
+        ///< static Impls count as shared, nothing modifies them in place
 
     U32 mUseCount;
+    bool mInArena;
+        ///< allocated from a CompactStorage arena block, not on its own
 
 public:
+    static void* operator new(size_t size);
+        ///< from the thread's arena block while a CompactStorage is active
+    static void operator delete(Impl* impl, std::destroying_delete_t);
+        ///< frees to wherever operator new took the memory from
+    static void operator delete(void* ptr);
+        ///< only used when a constructor throws
+
     static void reset(Impl*& var, Impl* impl);
         ///< safely set var to refer to the new impl (possibly shared)
 
@@ -186,8 +199,61 @@ public:
 
     static U32 sAllocationCount;
     static U32 sOutstandingCount;
+    static std::atomic<U32> sArenaAllocationCount;
+    static std::atomic<U32> sArenaBlockCount;
+    static std::atomic<size_t> sRetainedBytes;
 };
 
+#ifdef NAME_UNNAMED_NAMESPACE
+namespace LLSDUnnamedNamespace
+#else
+namespace
+#endif
+{
+    constexpr size_t ARENA_BLOCK_BYTES = 16 * 1024;
+
+    // Memory Impls get carved out of while a CompactStorage is active.
+    // Blocks are aligned to their size, so an Impl finds its block from its
+    // own address and needs no header.
+    struct alignas(ARENA_BLOCK_BYTES) ArenaBlock
+    {
+        static constexpr size_t SIZE = ARENA_BLOCK_BYTES - 16;
+
+        // live Impls in the block, plus one while it's the current block
+        std::atomic<U32> mRefs{ 1 };
+        U32 mUsed{ 0 };
+        alignas(16) char mData[SIZE];
+
+        static ArenaBlock* of(const void* ptr)
+        {
+            return reinterpret_cast<ArenaBlock*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t)(ARENA_BLOCK_BYTES - 1));
+        }
+
+        void release()
+        {
+            if (mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                LLSD::Impl::sRetainedBytes.fetch_sub(sizeof(ArenaBlock), std::memory_order_relaxed);
+                delete this;
+            }
+        }
+    };
+    static_assert(sizeof(ArenaBlock) == ARENA_BLOCK_BYTES, "ArenaBlock must fill its alignment");
+
+    struct CompactState
+    {
+        U32 mDepth = 0;
+        ArenaBlock* mBlock = nullptr;
+        // operator new just took memory from mBlock, for the Impl constructor
+        bool mNewInArena = false;
+    };
+
+    thread_local CompactState sCompact;
+    std::atomic<bool> sCompactEnabled{ true };
+
+    inline bool compact() { return sCompact.mDepth != 0; }
+}
+
 #ifdef NAME_UNNAMED_NAMESPACE
 namespace LLSDUnnamedNamespace
 #else
@@ -208,6 +274,7 @@ namespace
     public:
         ImplBase(DataRef value) : mValue(value) { }
         ImplBase(DataMove value) : mValue(std::move(value)) { }
+        ImplBase(DataRef value, StaticAllocationMarker marker) : Impl(marker), mValue(value) { }
 
         virtual LLSD::Type type() const { return T; }
 
@@ -240,6 +307,9 @@ namespace
     {
     public:
         ImplBoolean(LLSD::Boolean v) : Base(v) { }
+        ImplBoolean(LLSD::Boolean v, StaticAllocationMarker marker) : Base(v, marker) { }
+
+        static Impl* constant(LLSD::Boolean v);
 
         virtual LLSD::Boolean   asBoolean() const   { return mValue; }
         virtual LLSD::Integer   asInteger() const   { return mValue ? 1 : 0; }
@@ -257,12 +327,23 @@ namespace
         // as "everything else seems to work that way".
         { return mValue ? "true" : ""; }
 
+    // Shared values are never freed, so LLSD in static storage can hold them
+    LLSD::Impl* ImplBoolean::constant(LLSD::Boolean v)
+    {
+        static ImplBoolean* const sTrue = ::new ImplBoolean(true, STATIC_USAGE_COUNT);
+        static ImplBoolean* const sFalse = ::new ImplBoolean(false, STATIC_USAGE_COUNT);
+        return v ? sTrue : sFalse;
+    }
+
 
     class ImplInteger final
         : public ImplBase<LLSD::TypeInteger, LLSD::Integer, LLSD::Integer, LLSD::Integer&&>
     {
     public:
         ImplInteger(LLSD::Integer v) : Base(v) { }
+        ImplInteger(LLSD::Integer v, StaticAllocationMarker marker) : Base(v, marker) { }
+
+        static Impl* constant(LLSD::Integer v); ///< null if v isn't small
 
         virtual LLSD::Boolean   asBoolean() const   { return mValue != 0; }
         virtual LLSD::Integer   asInteger() const   { return mValue; }
@@ -275,12 +356,35 @@ namespace
     LLSD::String ImplInteger::asString() const
         { return llformat("%d", mValue); }
 
+    LLSD::Impl* ImplInteger::constant(LLSD::Integer v)
+    {
+        constexpr LLSD::Integer SMALL_MIN = -1;
+        constexpr LLSD::Integer SMALL_MAX = 255;
+        if (v < SMALL_MIN || v > SMALL_MAX)
+        {
+            return nullptr;
+        }
+        static ImplInteger* const* const sSmall = []()
+        {
+            ImplInteger** values = ::new ImplInteger*[SMALL_MAX - SMALL_MIN + 1];
+            for (LLSD::Integer i = SMALL_MIN; i <= SMALL_MAX; ++i)
+            {
+                values[i - SMALL_MIN] = ::new ImplInteger(i, STATIC_USAGE_COUNT);
+            }
+            return values;
+        }();
+        return sSmall[v - SMALL_MIN];
+    }
+
 
     class ImplReal final
         : public ImplBase<LLSD::TypeReal, LLSD::Real, LLSD::Real, LLSD::Real&&>
     {
     public:
         ImplReal(LLSD::Real v) : Base(v) { }
+        ImplReal(LLSD::Real v, StaticAllocationMarker marker) : Base(v, marker) { }
+
+        static Impl* constant(LLSD::Real v);    ///< null unless v is 0.0
 
         virtual LLSD::Boolean   asBoolean() const;
         virtual LLSD::Integer   asInteger() const;
@@ -299,6 +403,12 @@ namespace
     LLSD::String ImplReal::asString() const
         { return llformat("%lg", mValue); }
 
+    LLSD::Impl* ImplReal::constant(LLSD::Real v)
+    {
+        static ImplReal* const sZero = ::new ImplReal(0.0, STATIC_USAGE_COUNT);
+        return (v == 0.0 && !std::signbit(v)) ? sZero : nullptr;
+    }
+
 
     class ImplString final
         : public ImplBase<LLSD::TypeString, LLSD::String, const LLSD::String&, LLSD::String&&>
@@ -306,6 +416,9 @@ namespace
     public:
         ImplString(const LLSD::String& v) : Base(v) { }
         ImplString(LLSD::String&& v) : Base(std::move(v)) {}
+        ImplString(const LLSD::String& v, StaticAllocationMarker marker) : Base(v, marker) { }
+
+        static Impl* empty();
 
         virtual LLSD::Boolean   asBoolean() const   { return !mValue.empty(); }
         virtual LLSD::Integer   asInteger() const;
@@ -359,6 +472,12 @@ namespace
         return ((EOF ==c) ? v : 0.0);
     }
 
+    LLSD::Impl* ImplString::empty()
+    {
+        static ImplString* const sEmpty = ::new ImplString(LLSD::String(), STATIC_USAGE_COUNT);
+        return sEmpty;
+    }
+
 
     class ImplUUID final
         : public ImplBase<LLSD::TypeUUID, LLSD::UUID, const LLSD::UUID&, LLSD::UUID&&>
@@ -366,6 +485,9 @@ namespace
     public:
         ImplUUID(const LLSD::UUID& v) : Base(v) { }
         ImplUUID(LLSD::UUID&& v) : Base(std::move(v)) { }
+        ImplUUID(const LLSD::UUID& v, StaticAllocationMarker marker) : Base(v, marker) { }
+
+        static Impl* null();
 
         virtual LLSD::String    asString() const{ return mValue.asString(); }
         virtual LLSD::UUID      asUUID() const  { return mValue; }
@@ -373,6 +495,12 @@ namespace
         virtual LLSD::String asXMLRPCValue() const { return "<string>" + mValue.asString() + "</string>"; }
     };
 
+    LLSD::Impl* ImplUUID::null()
+    {
+        static ImplUUID* const sNull = ::new ImplUUID(LLUUID::null, STATIC_USAGE_COUNT);
+        return sNull;
+    }
+
 
     class ImplDate final
         : public ImplBase<LLSD::TypeDate, LLSD::Date, const LLSD::Date&, LLSD::Date&&>
@@ -747,14 +875,17 @@ namespace
 }
 
 LLSD::Impl::Impl()
-    : mUseCount(0)
+    : mUseCount(0),
+      mInArena(sCompact.mNewInArena)
 {
+    sCompact.mNewInArena = false;
     ++sAllocationCount;
     ++sOutstandingCount;
 }
 
 LLSD::Impl::Impl(StaticAllocationMarker)
-    : mUseCount(0)
+    : mUseCount(STATIC_USAGE_COUNT),
+      mInArena(false)
 {
 }
 
@@ -763,6 +894,69 @@ LLSD::Impl::~Impl()
     --sOutstandingCount;
 }
 
+void* LLSD::Impl::operator new(size_t size)
+{
+    if (!compact())
+    {
+        return ::operator new(size);
+    }
+
+    // keep every Impl in the block aligned for F64
+    size_t total = (size + alignof(F64) - 1) / alignof(F64) * alignof(F64);
+    if (total > ArenaBlock::SIZE / 8)
+    {
+        return ::operator new(size);
+    }
+
+    ArenaBlock* block = sCompact.mBlock;
+    if (!block || block->mUsed + total > ArenaBlock::SIZE)
+    {
+        if (block)
+        {
+            block->release();
+        }
+        block = sCompact.mBlock = new ArenaBlock;
+        sArenaBlockCount.fetch_add(1, std::memory_order_relaxed);
+        sRetainedBytes.fetch_add(sizeof(ArenaBlock), std::memory_order_relaxed);
+    }
+    void* ptr = block->mData + block->mUsed;
+    block->mUsed += (U32)total;
+    block->mRefs.fetch_add(1, std::memory_order_relaxed);
+    sArenaAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    sCompact.mNewInArena = true;
+    return ptr;
+}
+
+void LLSD::Impl::operator delete(Impl* impl, std::destroying_delete_t)
+{
+    bool in_arena = impl->mInArena;
+    impl->~Impl();
+    if (in_arena)
+    {
+        ArenaBlock::of(impl)->release();
+    }
+    else
+    {
+        ::operator delete(impl);
+    }
+}
+
+void LLSD::Impl::operator delete(void* ptr)
+{
+    // A constructor threw right after operator new, so the memory can only
+    // have come from this thread's current block or the heap.
+    sCompact.mNewInArena = false;
+    ArenaBlock* block = sCompact.mBlock;
+    if (block && ArenaBlock::of(ptr) == block)
+    {
+        block->release();
+    }
+    else
+    {
+        ::operator delete(ptr);
+    }
+}
+
 void LLSD::Impl::reset(Impl*& var, Impl* impl)
 {
     if (impl && impl->mUseCount != STATIC_USAGE_COUNT)
@@ -826,32 +1020,34 @@ void LLSD::Impl::assignUndefined(Impl*& var)
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Boolean v)
 {
-    reset(var, new ImplBoolean(v));
+    reset(var, compact() ? ImplBoolean::constant(v) : new ImplBoolean(v));
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Integer v)
 {
-    reset(var, new ImplInteger(v));
+    Impl* constant = compact() ? ImplInteger::constant(v) : nullptr;
+    reset(var, constant ? constant : new ImplInteger(v));
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Real v)
 {
-    reset(var, new ImplReal(v));
+    Impl* constant = compact() ? ImplReal::constant(v) : nullptr;
+    reset(var, constant ? constant : new ImplReal(v));
 }
 
 void LLSD::Impl::assign(Impl*& var, const char* v)
 {
-    reset(var, new ImplString(v));
+    reset(var, (compact() && !*v) ? ImplString::empty() : new ImplString(v));
 }
 
 void LLSD::Impl::assign(Impl*& var, const LLSD::String& v)
 {
-    reset(var, new ImplString(v));
+    reset(var, (compact() && v.empty()) ? ImplString::empty() : new ImplString(v));
 }
 
 void LLSD::Impl::assign(Impl*& var, const LLSD::UUID& v)
 {
-    reset(var, new ImplUUID(v));
+    reset(var, (compact() && v.isNull()) ? ImplUUID::null() : new ImplUUID(v));
 }
 
 void LLSD::Impl::assign(Impl*& var, const LLSD::Date& v)
@@ -871,12 +1067,12 @@ void LLSD::Impl::assign(Impl*& var, const LLSD::Binary& v)
 
 void LLSD::Impl::assign(Impl*& var, LLSD::String&& v)
 {
-    reset(var, new ImplString(std::move(v)));
+    reset(var, (compact() && v.empty()) ? ImplString::empty() : new ImplString(std::move(v)));
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::UUID&& v)
 {
-    reset(var, new ImplUUID(std::move(v)));
+    reset(var, (compact() && v.isNull()) ? ImplUUID::null() : new ImplUUID(std::move(v)));
 }
 
 void LLSD::Impl::assign(Impl*& var, LLSD::Date&& v)
@@ -940,6 +1136,9 @@ void LLSD::Impl::calcStats(S32 type_counts[], S32 share_counts[]) const
 
 U32 LLSD::Impl::sAllocationCount = 0;
 U32 LLSD::Impl::sOutstandingCount = 0;
+std::atomic<U32> LLSD::Impl::sArenaAllocationCount(0);
+std::atomic<U32> LLSD::Impl::sArenaBlockCount(0);
+std::atomic<size_t> LLSD::Impl::sRetainedBytes(0);
 
 
 
@@ -972,6 +1171,30 @@ LLSD& LLSD::operator=(LLSD&& other) noexcept { Impl::move(impl, other.impl); ret
 
 void LLSD::clear()                      { Impl::assignUndefined(impl); }
 
+LLSD::CompactStorage::CompactStorage()
+    : mActive(sCompactEnabled.load(std::memory_order_relaxed))
+{
+    if (mActive)
+    {
+        ++sCompact.mDepth;
+    }
+}
+
+LLSD::CompactStorage::~CompactStorage()
+{
+    if (mActive && --sCompact.mDepth == 0 && sCompact.mBlock)
+    {
+        // the values in it keep it alive
+        sCompact.mBlock->release();
+        sCompact.mBlock = nullptr;
+    }
+}
+
+// static
+void LLSD::CompactStorage::setEnabled(bool enabled) { sCompactEnabled = enabled; }
+// static
+bool LLSD::CompactStorage::isEnabled()              { return sCompactEnabled; }
+
 LLSD::Type LLSD::type() const           { return safe(impl).type(); }
 
 // Scalar Constructors
@@ -1145,6 +1368,9 @@ namespace llsd
 
 U32 allocationCount()                               { return LLSD::Impl::sAllocationCount; }
 U32 outstandingCount()                              { return LLSD::Impl::sOutstandingCount; }
+U32 arenaAllocationCount()                          { return LLSD::Impl::sArenaAllocationCount.load(std::memory_order_relaxed); }
+U32 arenaBlockCount()                               { return LLSD::Impl::sArenaBlockCount.load(std::memory_order_relaxed); }
+size_t retainedBytes()                              { return LLSD::Impl::sRetainedBytes.load(std::memory_order_relaxed); }
 
 // Diagnostic dump of contents in an LLSD object
 void dumpStats(const LLSD& llsd)                    { LLSD::Impl::getImpl(llsd).dumpStats(); }
@@ -170,6 +170,41 @@ public:
 
     void clear();   ///< resets to Undefined
 
+    /** @name Compact Storage
+        While a CompactStorage exists on a thread, values created on that
+        thread are stored compactly: true, false, small integers, 0.0, the
+        empty string and the null UUID share one immutable implementation
+        instead of allocating their own, and everything else is carved out
+        of arena blocks rather than allocated one at a time.
+
+        The values are ordinary LLSD. They may outlive the scope and be
+        handed to or destroyed on other threads. An arena block is freed
+        once the last value in it is gone, so a value kept from a parsed
+        document keeps its whole block alive.
+
+        Open one only around parsing a document whose values live and die
+        together, like the settings files or an AIS response, not one a few
+        values get picked out of and kept. Scopes nest.
+    */
+    //@{
+        class LL_COMMON_API CompactStorage
+        {
+        public:
+            CompactStorage();
+            ~CompactStorage();
+
+            CompactStorage(const CompactStorage&) = delete;
+            CompactStorage& operator=(const CompactStorage&) = delete;
+
+            /// For every thread; on by default
+            static void setEnabled(bool enabled);
+            static bool isEnabled();
+
+        private:
+            bool mActive;
+        };
+    //@}
+
 
     /** @name Scalar Types
         The scalar types, and how they map onto C++
@@ -524,6 +559,9 @@ namespace llsd
     /// These counts track LLSD::Impl (hidden) objects.
     LL_COMMON_API U32 allocationCount();    ///< how many Impls have been made
     LL_COMMON_API U32 outstandingCount();   ///< how many Impls are still alive
+    LL_COMMON_API U32 arenaAllocationCount();   ///< how many Impls were allocated from compact storage blocks
+    LL_COMMON_API U32 arenaBlockCount();        ///< how many compact storage blocks have been made
+    LL_COMMON_API size_t retainedBytes();       ///< bytes held by live compact storage blocks
 
     /// These counts track LLSD (public) objects.
     LL_COMMON_API extern S32 sLLSDAllocationCount;  ///< Number of LLSD objects ever created
@@ -0,0 +1,109 @@
+/**
+ * @file   parallelfor.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for parallelfor.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "parallelfor.h"
+// STL headers
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+// other Linden headers
+#include "threadpool.h"
+#include "workqueue.h"
+
+namespace
+{
+    // Shared between the caller and any helper tasks. Helpers may run after
+    // the caller has returned (finding no work left), so this is held by
+    // shared_ptr; func is only dereferenced after successfully claiming a
+    // chunk, which guarantees the caller is still waiting.
+    struct ParallelForState
+    {
+        const std::function<void(size_t, size_t)>* mFunc = nullptr;
+        size_t mCount = 0;
+        size_t mGrain = 1;
+        size_t mChunks = 0;
+        std::atomic<size_t> mNext{ 0 };
+        std::atomic<size_t> mDone{ 0 };
+        std::mutex mMutex;
+        std::condition_variable mCond;
+
+        // claim and run chunks until none are left
+        void work()
+        {
+            size_t chunk;
+            while ((chunk = mNext.fetch_add(1)) < mChunks)
+            {
+                size_t begin = chunk * mGrain;
+                size_t end = std::min(begin + mGrain, mCount);
+                (*mFunc)(begin, end);
+
+                if (mDone.fetch_add(1) + 1 == mChunks)
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mCond.notify_all();
+                }
+            }
+        }
+    };
+} // anonymous namespace
+
+void LL::parallelFor(const std::string& pool_name, size_t count, size_t grain,
+                     const std::function<void(size_t begin, size_t end)>& func)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    grain = std::max(grain, size_t(1));
+    size_t chunks = (count + grain - 1) / grain;
+
+    WorkQueue::ptr_t queue;
+    if (chunks > 1)
+    {
+        queue = WorkQueue::getInstance(pool_name);
+    }
+
+    if (!queue)
+    {
+        func(0, count);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->mFunc = &func;
+    state->mCount = count;
+    state->mGrain = grain;
+    state->mChunks = chunks;
+
+    // one helper per pool thread at most, and never more than the number of
+    // chunks the caller won't get to first
+    size_t helpers = std::min(chunks - 1, ThreadPoolBase::getWidth(pool_name, 1));
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        if (!queue->tryPost([state]() { state->work(); }))
+        {
+            // queue full or closed: the caller will pick up the slack
+            break;
+        }
+    }
+
+    state->work();
+
+    std::unique_lock<std::mutex> lock(state->mMutex);
+    state->mCond.wait(lock, [&state]() { return state->mDone.load() == state->mChunks; });
+}
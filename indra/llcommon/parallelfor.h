@@ -0,0 +1,41 @@
+/**
+ * @file   parallelfor.h
+ * @date   2026-10-18
+ * @brief  Split an index range into chunks and run them on a ThreadPool.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_PARALLELFOR_H)
+#define LL_PARALLELFOR_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace LL
+{
+    /**
+     * parallelFor() calls func(begin, end) for consecutive, non-overlapping
+     * sub-ranges of [0, count), each at most grain elements long, and
+     * returns once every sub-range has been processed.
+     *
+     * Chunks are handed out from a shared counter. The calling thread
+     * processes chunks itself, and up to (width of the named ThreadPool)
+     * helper tasks are posted to that pool's WorkQueue to claim the rest.
+     * If no WorkQueue by that name exists (e.g. in headless tests, or
+     * before the pool is started), or there is only a single chunk, the
+     * whole range is processed on the calling thread. Because the caller
+     * participates, it is safe to call this from a thread belonging to the
+     * same pool.
+     *
+     * func must be safe to call concurrently on different sub-ranges.
+     * Exceptions must not escape func.
+     */
+    void parallelFor(const std::string& pool_name, size_t count, size_t grain,
+                     const std::function<void(size_t begin, size_t end)>& func);
+} // namespace LL
+
+#endif /* ! defined(LL_PARALLELFOR_H) */
@@ -0,0 +1,181 @@
+/**
+ * @file   lleventchannel_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for lleventchannel.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "lleventchannel.h"
+// STL headers
+#include <thread>
+#include <vector>
+// other Linden headers
+#include "llsdutil.h"
+#include "../test/lltut.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct lleventchannel_data
+    {
+        struct Event
+        {
+            U32 mProducer;
+            U32 mSequence;
+        };
+
+        static LLSD toLLSD(const Event& event)
+        {
+            return llsd::map("producer", LLSD::Integer(event.mProducer),
+                             "sequence", LLSD::Integer(event.mSequence));
+        }
+
+        // what the receiving end saw
+        struct Received
+        {
+            Received(U32 producers): mNext(producers, 0) {}
+
+            void operator()(const Event& event)
+            {
+                if (event.mSequence != mNext[event.mProducer])
+                {
+                    ++mOutOfOrder;
+                }
+                mNext[event.mProducer] = event.mSequence + 1;
+                ++mCount;
+            }
+
+            std::vector<U32> mNext;
+            size_t mCount = 0;
+            size_t mOutOfOrder = 0;
+        };
+
+        // producers pushing events while the calling thread flushes
+        static void runProducers(LLEventChannel<Event>& channel, U32 producers, U32 events, Received& received)
+        {
+            channel.listenTyped("received", std::ref(received));
+            std::vector<std::thread> threads;
+            for (U32 p = 0; p < producers; ++p)
+            {
+                threads.emplace_back([&channel, p, events]()
+                    {
+                        for (U32 i = 0; i < events; ++i)
+                        {
+                            channel.push(Event{ p, i });
+                        }
+                    });
+            }
+            size_t total = (size_t)producers * events;
+            while (received.mCount < total)
+            {
+                channel.flush();
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+            channel.stopListeningTyped("received");
+        }
+    };
+    typedef test_group<lleventchannel_data> lleventchannel_group;
+    typedef lleventchannel_group::object object;
+    lleventchannel_group lleventchannelgrp("lleventchannel");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("typed and LLSD delivery");
+        LLEventChannel<Event> channel("lleventchannel_test1", &toLLSD);
+        ensure("registered", &LLEventPumps::instance().obtain("lleventchannel_test1") == &channel);
+
+        Received received(1);
+        channel.listenTyped("received", std::ref(received));
+        std::vector<LLSD> posted;
+        LLTempBoundListener connection(
+            LLEventPumps::instance().obtain("lleventchannel_test1").listen(
+                "posted",
+                [&posted](const LLSD& event)
+                {
+                    posted.push_back(event);
+                    return false;
+                }));
+
+        for (U32 i = 0; i < 10; ++i)
+        {
+            channel.push(Event{ 0, i });
+        }
+        ensure_equals("pending", channel.pending(), size_t(10));
+        ensure_equals("nothing before flush", received.mCount, size_t(0));
+        channel.flush();
+        ensure_equals("pending after flush", channel.pending(), size_t(0));
+        ensure_equals("typed count", received.mCount, size_t(10));
+        ensure_equals("in order", received.mOutOfOrder, size_t(0));
+        ensure_equals("LLSD count", posted.size(), size_t(10));
+        ensure_equals("converted", posted[3]["sequence"].asInteger(), 3);
+
+        // plain LLSD post() still works
+        channel.post(llsd::map("sequence", 42));
+        ensure_equals("post", posted.back()["sequence"].asInteger(), 42);
+        ensure_equals("post isn't typed", received.mCount, size_t(10));
+
+        // events pushed by a listener wait for the next flush
+        channel.listenTyped("echo",
+            [&channel](const Event& event)
+            {
+                if (event.mProducer == 0)
+                {
+                    channel.push(Event{ 1, event.mSequence });
+                }
+            });
+        channel.stopListeningTyped("received");
+        posted.clear();
+        channel.push(Event{ 0, 0 });
+        channel.flush();
+        ensure_equals("echo waits", channel.pending(), size_t(1));
+        ensure_equals("one delivered", posted.size(), size_t(1));
+        channel.flush();
+        ensure_equals("echo delivered", posted.size(), size_t(2));
+        ensure_equals("from echo", posted[1]["producer"].asInteger(), 1);
+        ensure_equals("stopped listener", received.mCount, size_t(10));
+        channel.stopListeningTyped("echo");
+
+        // "mainloop" flushes
+        channel.push(Event{ 0, 1 });
+        LLEventPumps::instance().obtain("mainloop").post(LLSD());
+        ensure_equals("mainloop", posted.size(), size_t(3));
+
+        // disabled drops
+        channel.enable(false);
+        channel.push(Event{ 0, 2 });
+        channel.flush();
+        channel.enable(true);
+        ensure_equals("dropped", posted.size(), size_t(3));
+        ensure_equals("nothing pending", channel.pending(), size_t(0));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("multiple producers");
+        constexpr U32 PRODUCERS = 4;
+        constexpr U32 EVENTS = 10000;
+        LLEventChannel<Event> channel("lleventchannel_test2");
+        Received received(PRODUCERS);
+        runProducers(channel, PRODUCERS, EVENTS, received);
+        ensure_equals("count", received.mCount, size_t(PRODUCERS) * EVENTS);
+        ensure_equals("each producer in order", received.mOutOfOrder, size_t(0));
+        for (U32 p = 0; p < PRODUCERS; ++p)
+        {
+            ensure_equals("last of producer", received.mNext[p], EVENTS);
+        }
+        ensure_equals("nothing pending", channel.pending(), size_t(0));
+    }
+} // namespace tut
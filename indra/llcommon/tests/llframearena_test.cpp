@@ -0,0 +1,138 @@
+/**
+ * @file   llframearena_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llframearena.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llframearena.h"
+// STL headers
+#include <cstdint>
+#include <cstring>
+#include <vector>
+// other Linden headers
+#include "../test/lltut.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llframearena_data
+    {
+    };
+    typedef test_group<llframearena_data> llframearena_group;
+    typedef llframearena_group::object object;
+    llframearena_group llframearenagrp("llframearena");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("allocations are aligned and don't overlap");
+        LLFrameArena arena(1024);
+        std::vector<std::pair<unsigned char*, size_t>> allocs;
+        for (size_t i = 1; i < 200; ++i)
+        {
+            size_t alignment = size_t(1) << (i % 7);
+            unsigned char* p = static_cast<unsigned char*>(arena.allocate(i, alignment));
+            ensure("misaligned", (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0);
+            memset(p, int(i), i);
+            allocs.emplace_back(p, i);
+        }
+        // a later allocation overlapping an earlier one would have clobbered it
+        for (const auto& alloc : allocs)
+        {
+            for (size_t j = 0; j < alloc.second; ++j)
+            {
+                ensure_equals("overlapping allocations", size_t(alloc.first[j]), alloc.second);
+            }
+        }
+        ensure("allocated past the first block", arena.getBytesReserved() > 1024);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("reset reuses blocks");
+        LLFrameArena arena(4096);
+        void* first = arena.allocate(100, 8);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            arena.allocate(100, 8);
+        }
+        size_t reserved = arena.getBytesReserved();
+        ensure_equals("bytes used", arena.getBytesUsed(), size_t(101 * 100));
+
+        arena.reset();
+        ensure_equals("bytes used after reset", arena.getBytesUsed(), size_t(0));
+        ensure("first allocation not reused", arena.allocate(100, 8) == first);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            arena.allocate(100, 8);
+        }
+        ensure_equals("arena grew after reset", arena.getBytesReserved(), reserved);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("oversized allocation");
+        LLFrameArena arena(256);
+        char* p = static_cast<char*>(arena.allocate(10000, 64));
+        ensure("misaligned", (reinterpret_cast<uintptr_t>(p) & 63) == 0);
+        memset(p, 0, 10000);
+        ensure("block too small", arena.getBytesReserved() >= 10000);
+        // the next small allocation still fits somewhere
+        ensure("small allocation", arena.allocate(16, 16) != nullptr);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("containers and frame accounting");
+        LLFrameArena::endFrame();
+        {
+            LLFrameVector<int> values;
+            for (int i = 0; i < 1000; ++i)
+            {
+                values.push_back(i);
+            }
+            LLFrameList<double> list;
+            list.push_back(1.0);
+            list.push_front(0.0);
+            ensure_equals("vector contents", values[999], 999);
+            ensure_equals("list contents", list.front(), 0.0);
+        }
+        ensure("arena used", LLFrameArena::current().getBytesUsed() >= 1000 * sizeof(int));
+        LLFrameArena::endFrame();
+        ensure("frame bytes", LLFrameArena::sLastFrameBytes >= 1000 * sizeof(int));
+
+        // warmed up: the same work again takes nothing from the heap
+        LLFrameArena::endFrame();
+        {
+            LLFrameVector<int> values;
+            for (int i = 0; i < 1000; ++i)
+            {
+                values.push_back(i);
+            }
+        }
+        LLFrameArena::endFrame();
+        ensure_equals("heap bytes with arena", LLFrameArena::sLastFrameHeapBytes, size_t(0));
+
+        // disabled: everything goes to the heap
+        LLFrameArena::sEnabled = false;
+        {
+            LLFrameVector<int> values(100);
+            ensure("arena used while disabled", LLFrameArena::current().getBytesUsed() == 0);
+        }
+        LLFrameArena::endFrame();
+        LLFrameArena::sEnabled = true;
+        ensure_equals("heap bytes without arena", LLFrameArena::sLastFrameHeapBytes, LLFrameArena::sLastFrameBytes);
+    }
+} // namespace tut
@@ -25,7 +25,8 @@
  * $/LicenseInfo$
  */
 
-
+// for llsd::arenaAllocationCount()
+#define LLSD_DEBUG_INFO
 #include "linden_common.h"
 
 #if LL_WINDOWS
@@ -58,6 +59,7 @@ typedef U32 uint32_t;
 #include "stringize.h"
 #include "StringVec.h"
 #include <functional>
+#include <thread>
 
 typedef std::function<void(const LLSD& data, std::ostream& str)> FormatterFunction;
 typedef std::function<bool(std::istream& istr, LLSD& data, llssize max_bytes)> ParserFunction;
@@ -2194,4 +2196,148 @@ namespace tut
                         { return LLSDSerialize::fromBinary(data, istr, max_bytes) > 0; });
     }
 |*==========================================================================*/
+
+    struct TestLLSDCompactStorage
+    {
+        // something like a capability response: lots of small maps
+        static LLSD makeResponse(S32 items)
+        {
+            LLSD response = LLSD::emptyArray();
+            for (S32 i = 0; i < items; ++i)
+            {
+                LLUUID id;
+                id.generate();
+                LLSD item;
+                item["item_id"] = id;
+                item["owner_id"] = LLUUID::null;
+                item["name"] = llformat("Object %d", i);
+                item["desc"] = "";
+                item["flags"] = i % 4;
+                item["sale_price"] = 10 * i;
+                item["for_sale"] = (i % 3) == 0;
+                item["scale"] = i % 2 ? 0.0 : 0.5 * i;
+                item["permissions"] = llsd::array(i % 256, 0, 1, "");
+                response.append(item);
+            }
+            return response;
+        }
+
+        static LLSD parse(const std::string& text, bool compact)
+        {
+            LLSD::CompactStorage::setEnabled(compact);
+            LLSD parsed;
+            {
+                LLSD::CompactStorage scope;
+                std::istringstream istr(text);
+                LLSDSerialize::fromXML(parsed, istr);
+            }
+            LLSD::CompactStorage::setEnabled(true);
+            return parsed;
+        }
+    };
+
+    typedef tut::test_group<TestLLSDCompactStorage> TestLLSDCompactStorageGroup;
+    typedef TestLLSDCompactStorageGroup::object TestLLSDCompactStorageObject;
+    TestLLSDCompactStorageGroup compactstorage("LLSD compact storage");
+
+    template<> template<>
+    void TestLLSDCompactStorageObject::test<1>()
+    {
+        set_test_name("compact values behave like any other");
+        LLSD expected = makeResponse(50);
+
+        std::ostringstream xml, notation, binary;
+        LLSDSerialize::toXML(expected, xml);
+        LLSDSerialize::toNotation(expected, notation);
+        LLSDSerialize::toBinary(expected, binary);
+
+        LLSD parsed = parse(xml.str(), true);
+        ensure("XML", llsd_equals(parsed, expected));
+        ensure("XML without", llsd_equals(parse(xml.str(), false), expected));
+        LLSD from_notation, from_binary;
+        {
+            LLSD::CompactStorage compact;
+            std::istringstream notation_in(notation.str());
+            LLSDSerialize::fromNotation(from_notation, notation_in, LLSDSerialize::SIZE_UNLIMITED);
+            std::istringstream binary_in(binary.str());
+            LLSDSerialize::fromBinary(from_binary, binary_in, LLSDSerialize::SIZE_UNLIMITED);
+        }
+        ensure("notation", llsd_equals(from_notation, expected));
+        ensure("binary", llsd_equals(from_binary, expected));
+
+        // parsing alone doesn't store compactly
+        U32 blocks_before = llsd::arenaBlockCount();
+        LLSD plain;
+        std::istringstream plain_in(xml.str());
+        LLSDSerialize::fromXML(plain, plain_in);
+        ensure_equals("no scope, no blocks", llsd::arenaBlockCount(), blocks_before);
+
+        // shared values get replaced, not changed
+        LLSD& flags = parsed[4]["flags"];
+        ensure_equals("small integer", flags.asInteger(), 0);
+        flags = 7;
+        flags.assign(LLSD::Integer(9));
+        ensure_equals("assigned", parsed[4]["flags"].asInteger(), 9);
+        ensure_equals("others unchanged", parsed[8]["flags"].asInteger(), 0);
+        parsed[0]["desc"] = "changed";
+        ensure_equals("empty string unchanged", parsed[1]["desc"].asString(), std::string());
+        parsed[0]["for_sale"] = false;
+        ensure("true unchanged", parsed[3]["for_sale"].asBoolean());
+
+        {
+            LLSD::CompactStorage compact;
+            LLSD one(1), other_one(1), big(100000), zero(0.0), negative_zero(-0.0);
+            ensure_equals("one", one.asInteger(), 1);
+            ensure_equals("big", big.asInteger(), 100000);
+            ensure("negative zero", std::signbit(negative_zero.asReal()));
+            other_one = 2;
+            ensure_equals("one unchanged", one.asInteger(), 1);
+            parsed[2]["kept"] = big;
+        }
+
+        // outlives the scope and the thread that made it
+        LLSD made_on_thread;
+        std::thread([&made_on_thread, &xml]()
+            {
+                made_on_thread = parse(xml.str(), true);
+            }).join();
+        ensure("made on thread", llsd_equals(made_on_thread, expected));
+        ensure_equals("kept", parsed[2]["kept"].asInteger(), 100000);
+        LLSD kept = made_on_thread[10];
+        made_on_thread.clear();
+        std::thread([&kept]() { kept.clear(); }).join();
+        parsed.clear();
+    }
+
+    template<> template<>
+    void TestLLSDCompactStorageObject::test<2>()
+    {
+        set_test_name("compact parse allocates less");
+        constexpr S32 ITEMS = 200;
+
+        std::ostringstream xml;
+        LLSDSerialize::toXML(makeResponse(ITEMS), xml);
+        std::string text = xml.str();
+
+        U32 heap_before = llsd::allocationCount() - llsd::arenaAllocationCount();
+        parse(text, false);
+        U32 plain_allocations = llsd::allocationCount() - llsd::arenaAllocationCount() - heap_before;
+
+        heap_before = llsd::allocationCount() - llsd::arenaAllocationCount();
+        U32 blocks_before = llsd::arenaBlockCount();
+        parse(text, true);
+        U32 compact_allocations = llsd::allocationCount() - llsd::arenaAllocationCount() - heap_before
+                                  + llsd::arenaBlockCount() - blocks_before;
+        ensure("fewer allocations", compact_allocations * 10 < plain_allocations);
+
+        // a kept value keeps its whole block, but no more than that
+        size_t before = llsd::retainedBytes();
+        LLSD parsed = parse(text, true);
+        ensure("blocks held", llsd::retainedBytes() > before);
+        LLSD item = parsed[ITEMS / 2];
+        parsed.clear();
+        size_t kept = llsd::retainedBytes() - before;
+        ensure("kept item pins a block", kept > 0);
+        ensure("kept item pins no more than its blocks", kept < 3 * 16 * 1024);
+    }
 }
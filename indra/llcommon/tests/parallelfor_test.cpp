@@ -0,0 +1,78 @@
+/**
+ * @file   parallelfor_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for parallelfor.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "parallelfor.h"
+// STL headers
+#include <atomic>
+#include <vector>
+// other Linden headers
+#include "../test/lltut.h"
+#include "threadpool.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct parallelfor_data
+    {
+        // every index in [0, count) must be visited exactly once
+        static void check(const std::string& pool, size_t count, size_t grain)
+        {
+            std::vector<std::atomic<int>> visits(count);
+            std::atomic<bool> empty_chunk(false);
+            // func may run on worker threads: record, don't throw
+            LL::parallelFor(pool, count, grain,
+                            [&visits, &empty_chunk](size_t begin, size_t end)
+                            {
+                                if (begin >= end)
+                                {
+                                    empty_chunk = true;
+                                }
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    ++visits[i];
+                                }
+                            });
+            ensure("empty chunk", ! empty_chunk);
+            for (size_t i = 0; i < count; ++i)
+            {
+                ensure_equals("index visited wrong number of times", visits[i].load(), 1);
+            }
+        }
+    };
+    typedef test_group<parallelfor_data> parallelfor_group;
+    typedef parallelfor_group::object object;
+    parallelfor_group parallelforgrp("parallelfor");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("no pool");
+        // with no such WorkQueue, everything runs on the calling thread
+        check("parallelfor_missing", 1000, 7);
+        check("parallelfor_missing", 0, 7);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("pool");
+        LL::ThreadPool pool("parallelfor_pool", 3);
+        pool.start();
+        check("parallelfor_pool", 10000, 13);
+        check("parallelfor_pool", 5, 100);
+        check("parallelfor_pool", 64, 1);
+        pool.close();
+    }
+} // namespace tut
@@ -296,6 +296,130 @@ S32 LLCamera::AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVec
     return AABBInFrustumNoFarClip(center, radius, mRegionPlanes);
 }
 
+void LLCamera::AABBInFrustum4(const LLVector4a* center, const LLVector4a* radius, S32* results,
+                              bool far_clip, bool region_space) const
+{
+    const LLPlane* planes = region_space ? mRegionPlanes : mAgentPlanes;
+
+    LLVector4Logical outside;
+    LLVector4Logical partial;
+    outside.clear();
+    partial.clear();
+
+    U32 max_planes = llmin(mPlaneCount, (U32) AGENT_PLANE_USER_CLIP_NUM);       // mAgentPlanes[] size is 7
+    for (U32 i = 0; i < max_planes; i++)
+    {
+        U8 mask = mPlaneMask[i];
+        if (mask >= PLANE_MASK_NUM || (!far_clip && i == AGENT_PLANE_FAR))
+        {
+            continue;
+        }
+
+        // same operations in the same order as AABBInFrustum(), so that the
+        // results match it exactly
+        const LLPlane& p(planes[i]);
+        const LLVector4a& scaler = sFrustumScaler[mask];
+        LLVector4a d;
+        d.splat(-p[3]);
+
+        LLVector4a dot_min, dot_max;
+        for (U32 axis = 0; axis < 3; axis++)
+        {
+            LLVector4a n, s, rscale, minp, maxp;
+            n.splat(p[axis]);
+            s.splat(scaler[axis]);
+            rscale.setMul(radius[axis], s);
+            minp.setSub(center[axis], rscale);
+            maxp.setAdd(center[axis], rscale);
+            minp.mul(n);
+            maxp.mul(n);
+            if (axis == 0)
+            {
+                dot_min = minp;
+                dot_max = maxp;
+            }
+            else
+            {
+                dot_min.add(minp);
+                dot_max.add(maxp);
+            }
+        }
+
+        outside = _mm_or_ps(outside, dot_min.greaterThan(d));
+        if (outside.areAllSet())
+        {
+            break;
+        }
+        partial = _mm_or_ps(partial, dot_max.greaterThan(d));
+    }
+
+    U32 outside_bits = outside.getGatheredBits();
+    U32 partial_bits = partial.getGatheredBits();
+    for (U32 i = 0; i < 4; i++)
+    {
+        U32 bit = 1 << i;
+        results[i] = (outside_bits & bit) ? 0 : ((partial_bits & bit) ? 1 : 2);
+    }
+}
+
+void LLCamera::calcPixelRadius4(const LLVector4a* center, const LLVector4a* size, F32 pixels_per_radian,
+                                F32* dist, F32* cos_angle, F32* radius) const
+{
+    const LLVector3 at_axis = getAtAxis();
+
+    LLVector4a dist_squared, size_squared, at_dot;
+    dist_squared.clear();
+    size_squared.clear();
+    at_dot.clear();
+
+    for (U32 axis = 0; axis < 3; axis++)
+    {
+        LLVector4a origin, at, look_at, t;
+        origin.splat(mOrigin.mV[axis]);
+        at.splat(at_axis.mV[axis]);
+        look_at.setSub(center[axis], origin);
+
+        t.setMul(look_at, look_at);
+        dist_squared.add(t);
+        t.setMul(size[axis], size[axis]);
+        size_squared.add(t);
+        t.setMul(look_at, at);
+        at_dot.add(t);
+    }
+
+    LLVector4a center_dist(_mm_sqrt_ps(dist_squared));
+    LLVector4a size_length(_mm_sqrt_ps(size_squared));
+
+    // distance to the bounding sphere, kept away from zero as the camera
+    // gets inside it
+    LLVector4a min_dist(0.001f);
+    LLVector4a sphere_dist;
+    sphere_dist.setSub(center_dist, size_length);
+    sphere_dist.setMax(sphere_dist, min_dist);
+
+    LLVector4a tan_angle;
+    tan_angle.setDiv(size_length, sphere_dist);
+
+    // a center at the origin is straight ahead
+    LLVector4a cos_at;
+    cos_at.setDiv(at_dot, center_dist);
+    cos_at.setSelectWithMask(center_dist.greaterThan(min_dist), cos_at, LLVector4a(1.f));
+
+    LL_ALIGN_16(F32 out_dist[4]);
+    LL_ALIGN_16(F32 out_cos[4]);
+    LL_ALIGN_16(F32 out_tan[4]);
+    sphere_dist.store4a(out_dist);
+    cos_at.store4a(out_cos);
+    tan_angle.store4a(out_tan);
+
+    for (U32 i = 0; i < 4; i++)
+    {
+        dist[i] = out_dist[i];
+        cos_angle[i] = out_cos[i];
+        radius[i] = atanf(out_tan[i]) * pixels_per_radian;
+    }
+}
+
 int LLCamera::sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius)
 {
     LLVector3 dist = sphere_center-mFrustCenter;
@@ -202,6 +202,21 @@ public:
     S32 AABBInFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius, const LLPlane* planes = NULL);
     S32 AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius);
 
+    // AABBInFrustum(), or AABBInFrustumNoFarClip() if !far_clip, for four
+    // boxes at once, using mRegionPlanes if region_space. center and radius
+    // each hold three vectors with the x, y and z of the four boxes, one box
+    // per lane. Writes 0, 1 or 2 for each box to results.
+    void AABBInFrustum4(const LLVector4a* center, const LLVector4a* radius, S32* results,
+                        bool far_clip, bool region_space = false) const;
+
+    // For four boxes laid out as in AABBInFrustum4(), with half sizes in
+    // size, writes the distance from the origin to the bounding sphere of
+    // each box, the cosine of the angle between the at axis and each center,
+    // and the apparent radius of each bounding sphere in pixels for the given
+    // pixels per radian.
+    void calcPixelRadius4(const LLVector4a* center, const LLVector4a* size, F32 pixels_per_radian,
+                          F32* dist, F32* cos_angle, F32* radius) const;
+
     //does a quick 'n dirty sphere-sphere check
     S32 sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius);
 
@@ -75,6 +75,10 @@ public:
     // Set this quaternion to the conjugate of src
     inline void setConjugate(const LLQuaternion2& src);
 
+    // Set this quaternion to a * b, using the same ordering convention as
+    // LLQuaternion's operator* (i.e. rotate by a, then by b)
+    inline void setMul(const LLQuaternion2& a, const LLQuaternion2& b);
+
     // Renormalizes the quaternion. Assumes it has nonzero length.
     inline void normalize();
 
@@ -61,6 +61,34 @@ inline void LLQuaternion2::setConjugate(const LLQuaternion2& src)
     mQ = _mm_xor_ps(src.mQ, *reinterpret_cast<const LLQuad*>(&F_QUAT_INV_MASK_4A));
 }
 
+// Set this quaternion to a * b (rotate by a, then by b)
+inline void LLQuaternion2::setMul(const LLQuaternion2& a, const LLQuaternion2& b)
+{
+    static LL_ALIGN_16( const U32 F_QUAT_MUL_MASK_X_4A[4] ) = { 0x00000000, 0x80000000, 0x00000000, 0x80000000 };
+    static LL_ALIGN_16( const U32 F_QUAT_MUL_MASK_Y_4A[4] ) = { 0x00000000, 0x00000000, 0x80000000, 0x80000000 };
+    static LL_ALIGN_16( const U32 F_QUAT_MUL_MASK_Z_4A[4] ) = { 0x80000000, 0x00000000, 0x00000000, 0x80000000 };
+
+    // Hamilton product b.a, one column of the product matrix per component of b
+    const LLQuad q = a.mQ;
+    const LLQuad p = b.mQ;
+
+    LLQuad res = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)), q);
+
+    LLQuad col = _mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 1, 2, 3));
+    col = _mm_xor_ps(col, *reinterpret_cast<const LLQuad*>(&F_QUAT_MUL_MASK_X_4A));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)), col));
+
+    col = _mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 0, 3, 2));
+    col = _mm_xor_ps(col, *reinterpret_cast<const LLQuad*>(&F_QUAT_MUL_MASK_Y_4A));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)), col));
+
+    col = _mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 3, 0, 1));
+    col = _mm_xor_ps(col, *reinterpret_cast<const LLQuad*>(&F_QUAT_MUL_MASK_Z_4A));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)), col));
+
+    mQ = res;
+}
+
 // Renormalizes the quaternion. Assumes it has nonzero length.
 inline void LLQuaternion2::normalize()
 {
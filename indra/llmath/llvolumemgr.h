@@ -51,6 +51,8 @@ public:
     bool cleanupRefs();
 
     static S32 getDetailFromTan(const F32 tan_angle);
+    // getDetailFromTan() returns the first detail level whose threshold is not below tan_angle
+    static F32 getDetailThreshold(const S32 detail) { return mDetailThresholds[detail]; }
     static void getDetailProximity(const F32 tan_angle, F32 &to_lower, F32& to_higher);
     static F32 getVolumeScaleFromDetail(const S32 detail);
     static S32 getVolumeDetailFromScale(F32 scale);
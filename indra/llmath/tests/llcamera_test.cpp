@@ -0,0 +1,205 @@
+/**
+ * @file llcamera_test.cpp
+ * @brief Test cases for LLCamera frustum culling and pixel areas.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../llmath.h"
+#include "../llcamera.h"
+
+namespace tut
+{
+    struct LLCameraData
+    {
+        LLCamera mCamera;
+        std::vector<LLVector4a> mCenters;
+        std::vector<LLVector4a> mRadii;
+
+        LLCameraData()
+        {
+            mCamera.lookAt(LLVector3(40.f, 60.f, 25.f), LLVector3(120.f, 90.f, 20.f));
+
+            // frustum corners in the order LLViewerCamera::updateFrustumPlanes()
+            // unprojects them: near bottom left, bottom right, top right, top
+            // left, then the same on the far plane
+            LLVector3 frust[8];
+            const F32 dist[2] = { 0.5f, 128.f };
+            for (U32 i = 0; i < 2; ++i)
+            {
+                LLVector3 at = mCamera.getOrigin() + mCamera.getAtAxis() * dist[i];
+                LLVector3 left = mCamera.getLeftAxis() * (dist[i] * 0.7f);
+                LLVector3 up = mCamera.getUpAxis() * (dist[i] * 0.5f);
+                frust[i * 4 + 0] = at + left - up;
+                frust[i * 4 + 1] = at - left - up;
+                frust[i * 4 + 2] = at - left + up;
+                frust[i * 4 + 3] = at + left + up;
+            }
+            mCamera.calcAgentFrustumPlanes(frust);
+            mCamera.calcRegionFrustumPlanes(LLVector3(0.f, 256.f, 0.f), 96.f);
+        }
+
+        // boxes scattered around the camera, from small objects to whole
+        // octree branches, so that some are in, some out and some cross
+        // the frustum planes
+        void makeBoxes(U32 count)
+        {
+            mCenters.resize(count);
+            mRadii.resize(count);
+            U32 seed = 12345;
+            auto rand01 = [&seed]()
+            {
+                seed = seed * 1664525u + 1013904223u;
+                return (F32)(seed >> 8) / (F32)(1 << 24);
+            };
+            for (U32 i = 0; i < count; ++i)
+            {
+                mCenters[i].set(rand01() * 256.f - 40.f, rand01() * 256.f - 40.f, rand01() * 64.f, 0.f);
+                F32 size = (i % 16 == 0) ? 32.f : 4.f;
+                mRadii[i].set(rand01() * size, rand01() * size, rand01() * size, 0.f);
+            }
+        }
+
+        // copies four boxes starting at first to SoA blocks
+        void gather(U32 first, LLVector4a* center, LLVector4a* radius)
+        {
+            for (U32 axis = 0; axis < 3; ++axis)
+            {
+                center[axis].set(mCenters[first][axis], mCenters[first + 1][axis],
+                                 mCenters[first + 2][axis], mCenters[first + 3][axis]);
+                radius[axis].set(mRadii[first][axis], mRadii[first + 1][axis],
+                                 mRadii[first + 2][axis], mRadii[first + 3][axis]);
+            }
+        }
+
+        // compares AABBInFrustum4() to the per box tests in every mode,
+        // returns how many boxes got each result
+        void compareAll(U32 counts[3])
+        {
+            counts[0] = counts[1] = counts[2] = 0;
+            for (U32 mode = 0; mode < 4; ++mode)
+            {
+                bool far_clip = mode & 1;
+                bool region = mode & 2;
+                for (U32 i = 0; i < mCenters.size(); i += 4)
+                {
+                    LLVector4a center[3];
+                    LLVector4a radius[3];
+                    gather(i, center, radius);
+                    S32 results[4];
+                    mCamera.AABBInFrustum4(center, radius, results, far_clip, region);
+
+                    for (U32 j = 0; j < 4; ++j)
+                    {
+                        S32 expected;
+                        if (region)
+                        {
+                            expected = far_clip ? mCamera.AABBInRegionFrustum(mCenters[i + j], mRadii[i + j])
+                                                : mCamera.AABBInRegionFrustumNoFarClip(mCenters[i + j], mRadii[i + j]);
+                        }
+                        else
+                        {
+                            expected = far_clip ? mCamera.AABBInFrustum(mCenters[i + j], mRadii[i + j])
+                                                : mCamera.AABBInFrustumNoFarClip(mCenters[i + j], mRadii[i + j]);
+                        }
+                        ensure_equals("AABBInFrustum4 result", results[j], expected);
+                        counts[expected]++;
+                    }
+                }
+            }
+        }
+    };
+
+    typedef test_group<LLCameraData> factory;
+    typedef factory::object object;
+}
+
+namespace
+{
+    tut::factory llcamera_test_factory("LLCamera");
+}
+
+namespace tut
+{
+    // AABBInFrustum4() matches the per box tests
+    template<> template<>
+    void object::test<1>()
+    {
+        makeBoxes(4096);
+        U32 counts[3];
+        compareAll(counts);
+        ensure("some boxes outside", counts[0] > 0);
+        ensure("some boxes partially inside", counts[1] > 0);
+        ensure("some boxes fully inside", counts[2] > 0);
+    }
+
+    // ignored planes and user clip planes are handled the same way
+    template<> template<>
+    void object::test<2>()
+    {
+        makeBoxes(1024);
+        mCamera.ignoreAgentFrustumPlane(LLCamera::AGENT_PLANE_NEAR);
+        LLPlane clip(LLVector3(80.f, 0.f, 0.f), LLVector3(-1.f, 0.f, 0.f));
+        mCamera.setUserClipPlane(clip);
+        U32 counts[3];
+        compareAll(counts);
+        ensure("some boxes outside", counts[0] > 0);
+    }
+
+    // calcPixelRadius4() matches the one box at a time math it batches
+    template<> template<>
+    void object::test<3>()
+    {
+        constexpr F32 PIXELS_PER_RADIAN = 600.f;
+        makeBoxes(1024);
+        // one box around the camera
+        mCenters[5].load3(mCamera.getOrigin().mV);
+
+        for (U32 i = 0; i < mCenters.size(); i += 4)
+        {
+            LLVector4a center[3];
+            LLVector4a size[3];
+            gather(i, center, size);
+            F32 dist[4];
+            F32 cos_angle[4];
+            F32 radius[4];
+            mCamera.calcPixelRadius4(center, size, PIXELS_PER_RADIAN, dist, cos_angle, radius);
+
+            for (U32 j = 0; j < 4; ++j)
+            {
+                LLVector3 look_at = LLVector3(mCenters[i + j].getF32ptr()) - mCamera.getOrigin();
+                F32 size_length = LLVector3(mRadii[i + j].getF32ptr()).length();
+                F32 expected_dist = llmax(look_at.length() - size_length, 0.001f);
+                F32 expected_radius = atanf(size_length / expected_dist) * PIXELS_PER_RADIAN;
+                F32 expected_cos = look_at.length() > 0.001f ? look_at * mCamera.getAtAxis() / look_at.length() : 1.f;
+
+                ensure_approximately_equals("distance", dist[j], expected_dist, 10);
+                ensure_approximately_equals("radius", radius[j], expected_radius, 8);
+                ensure_approximately_equals("cos angle", cos_angle[j], expected_cos, 12);
+            }
+        }
+    }
+}
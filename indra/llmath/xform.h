@@ -139,6 +139,15 @@ public:
     const LLMatrix4&    getWorldMatrix() const      { return mWorldMatrix; }
     void setWorldMatrix (const LLMatrix4& mat)   { mWorldMatrix = mat; }
 
+    // Store a world transform computed elsewhere (e.g. by a batched
+    // skeleton update) as if update() and updateMatrix() had been called.
+    void setWorldTransform(const LLVector3& pos, const LLQuaternion& rot, const LLMatrix4& mat)
+    {
+        mWorldPosition = pos;
+        mWorldRotation = rot;
+        mWorldMatrix = mat;
+    }
+
     void init()
     {
         mWorldMatrix.setIdentity();
@@ -43,6 +43,7 @@
 #include "llstring.h"
 
 // Third party library includes
+#include <boost/functional/hash.hpp>
 #include <boost/tokenizer.hpp>
 
 #if LL_WINDOWS
@@ -70,9 +71,14 @@ F32 LLFontGL::sCurDepth;
 std::vector<std::pair<LLCoordGL, F32> > LLFontGL::sOriginStack;
 
 const F32 PAD_UVY = 0.5f; // half of vertical padding between glyphs in the glyph texture
+// Glyph runs kept per font, and the most characters in one
+constexpr size_t GLYPH_RUN_CACHE_SIZE = 1024;
+constexpr S32 GLYPH_RUN_MAX_LENGTH = 128;
 const F32 DROP_SHADOW_SOFT_STRENGTH = 0.3f;
 
 LLFontGL::LLFontGL()
+:   mGlyphRunGeneration(-1),
+    mGlyphRunClock(0)
 {
 }
 
@@ -82,6 +88,7 @@ LLFontGL::~LLFontGL()
 
 void LLFontGL::reset()
 {
+    mGlyphRuns.clear();
     mFontFreetype->reset(sVertDPI, sHorizDPI);
 }
 
@@ -256,13 +263,6 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
 
     const LLFontBitmapCache* font_bitmap_cache = mFontFreetype->getFontBitmapCache();
 
-    // This looks wrong, value is dynamic.
-    // LLFontBitmapCache::nextOpenPos can alter these values when
-    // new characters get added to cache, which affects whole string.
-    // Todo: Perhaps value should update after symbols were added?
-    F32 inv_width = 1.f / font_bitmap_cache->getBitmapWidth();
-    F32 inv_height = 1.f / font_bitmap_cache->getBitmapHeight();
-
     const S32 LAST_CHARACTER = LLFontFreetype::LAST_CHAR_FULL;
 
     bool draw_ellipses = false;
@@ -279,7 +279,14 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         }
     }
 
-    const LLFontGlyphInfo* next_glyph = NULL;
+    // Glyphs for the first run of characters get added to the bitmap
+    // cache before its size is taken, later runs can still add some.
+    const EFontGlyphType glyph_type = use_color ? EFontGlyphType::Color : EFontGlyphType::Grayscale;
+    const GlyphRun* run = getGlyphRun(wstr.c_str() + begin_offset, length, glyph_type);
+    S32 run_start = begin_offset;
+
+    F32 inv_width = 1.f / font_bitmap_cache->getBitmapWidth();
+    F32 inv_height = 1.f / font_bitmap_cache->getBitmapHeight();
 
     // string can have more than one glyph per char (ex: bold or shadow),
     // make sure that GLYPH_BATCH_SIZE won't end up with half a symbol.
@@ -302,12 +309,12 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
     {
         llwchar wch = wstr[i];
 
-        const LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
+        if (i - run_start >= (S32)run->mGlyphs.size())
         {
-            fgi = mFontFreetype->getGlyphInfo(wch, (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color);
+            run_start = i;
+            run = getGlyphRun(wstr.c_str() + i, begin_offset + length - i, glyph_type);
         }
+        const LLFontGlyphInfo* fgi = run->mGlyphs[i - run_start];
         if (!fgi)
         {
             LL_ERRS() << "Missing Glyph Info" << LL_ENDL;
@@ -382,8 +389,7 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         if (next_char && (next_char < LAST_CHARACTER))
         {
             // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(next_char, (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            cur_x += getRunKerning(*run, i - run_start, next_char);
         }
 
         // Round after kerning.
@@ -528,19 +534,18 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
     F32 cur_x = 0;
     const S32 max_index = begin_offset + max_chars;
 
-    const LLFontGlyphInfo* next_glyph = NULL;
+    const GlyphRun* run = NULL;
+    S32 run_start = begin_offset;
 
     F32 width_padding = 0.f;
     for (S32 i = begin_offset; i < max_index && wchars[i] != 0; i++)
     {
-        llwchar wch = wchars[i];
-
-        const LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
+        if (!run || i - run_start >= (S32)run->mGlyphs.size())
         {
-            fgi = mFontFreetype->getGlyphInfo(wch, EFontGlyphType::Unspecified);
+            run_start = i;
+            run = getGlyphRun(wchars + i, max_index - i, EFontGlyphType::Unspecified);
         }
+        const LLFontGlyphInfo* fgi = run->mGlyphs[i - run_start];
 
         F32 advance = mFontFreetype->getXAdvance(fgi);
 
@@ -562,8 +567,7 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
             && (next_char < LAST_CHARACTER))
         {
             // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(next_char, EFontGlyphType::Unspecified);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            cur_x += getRunKerning(*run, i - run_start, next_char);
         }
         // Round after kerning.
         cur_x = (F32)ll_round(cur_x);
@@ -587,6 +591,83 @@ void LLFontGL::generateASCIIglyphs()
     }
 }
 
+const LLFontGL::GlyphRun* LLFontGL::getGlyphRun(const llwchar* wchars, S32 length, EFontGlyphType glyph_type) const
+{
+    // Stop before a null, measuring ends there and drawing starts a new run with it
+    S32 run_length = 0;
+    while (run_length < llmin(length, GLYPH_RUN_MAX_LENGTH) && (wchars[run_length] || run_length == 0))
+    {
+        ++run_length;
+    }
+
+    size_t key = boost::hash_range(wchars, wchars + run_length);
+    boost::hash_combine(key, (U32)glyph_type);
+
+    if (getCacheGeneration() == mGlyphRunGeneration)
+    {
+        auto found = mGlyphRuns.find(key);
+        if (found != mGlyphRuns.end()
+            && found->second.mGlyphType == glyph_type
+            && found->second.mText.compare(0, LLWString::npos, wchars, run_length) == 0)
+        {
+            found->second.mLastUsed = ++mGlyphRunClock;
+            return &found->second;
+        }
+    }
+
+    GlyphRun run;
+    run.mText.assign(wchars, run_length);
+    run.mGlyphType = glyph_type;
+    run.mGlyphs.resize(run_length);
+    run.mKerning.assign(run_length, 0.f);
+    for (S32 i = 0; i < run_length; ++i)
+    {
+        run.mGlyphs[i] = mFontFreetype->getGlyphInfo(wchars[i], glyph_type);
+    }
+    for (S32 i = 0; i + 1 < run_length; ++i)
+    {
+        run.mKerning[i] = mFontFreetype->getXKerning(run.mGlyphs[i], run.mGlyphs[i + 1]);
+    }
+    run.mLastUsed = ++mGlyphRunClock;
+
+    if (getCacheGeneration() != mGlyphRunGeneration)
+    {
+        // Adding a glyph can replace one of another type for the same
+        // character, and a reset deletes them all
+        mGlyphRuns.clear();
+        mGlyphRunGeneration = getCacheGeneration();
+    }
+    else if (mGlyphRuns.size() >= GLYPH_RUN_CACHE_SIZE)
+    {
+        // Each lookup uses one run, so this frees at least half of them
+        for (auto it = mGlyphRuns.begin(); it != mGlyphRuns.end();)
+        {
+            if (mGlyphRunClock - it->second.mLastUsed > GLYPH_RUN_CACHE_SIZE / 2)
+            {
+                it = mGlyphRuns.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Replaces whatever had the same hash
+    GlyphRun& stored = mGlyphRuns[key];
+    stored = std::move(run);
+    return &stored;
+}
+
+F32 LLFontGL::getRunKerning(const GlyphRun& run, S32 index, llwchar next_char) const
+{
+    if (index + 1 < (S32)run.mGlyphs.size())
+    {
+        return run.mKerning[index];
+    }
+    return mFontFreetype->getXKerning(run.mGlyphs[index], mFontFreetype->getGlyphInfo(next_char, run.mGlyphType));
+}
+
 // Returns the max number of complete characters from text (up to max_chars) that can be drawn in max_pixels
 S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_chars, EWordWrapStyle end_on_word_boundary) const
 {
@@ -609,7 +690,8 @@ S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_ch
     F32 scaled_max_pixels = max_pixels * sScaleX;
     F32 width_padding = 0.f;
 
-    LLFontGlyphInfo* next_glyph = NULL;
+    const GlyphRun* run = NULL;
+    S32 run_start = 0;
 
     S32 i;
     for (i=0; (i < max_chars); i++)
@@ -653,16 +735,15 @@ S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_ch
             }
         }
 
-        LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
+        if (!run || i - run_start >= (S32)run->mGlyphs.size())
         {
-            fgi = mFontFreetype->getGlyphInfo(wch, EFontGlyphType::Unspecified);
-
-            if (NULL == fgi)
-            {
-                return 0;
-            }
+            run_start = i;
+            run = getGlyphRun(wchars + i, max_chars - i, EFontGlyphType::Unspecified);
+        }
+        const LLFontGlyphInfo* fgi = run->mGlyphs[i - run_start];
+        if (NULL == fgi)
+        {
+            return 0;
         }
 
         // account for glyphs that run beyond the starting point for the next glyphs
@@ -682,8 +763,7 @@ S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_ch
         if (((i+1) < max_chars) && wchars[i+1])
         {
             // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(wchars[i+1], EFontGlyphType::Unspecified);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            cur_x += getRunKerning(*run, i - run_start, wchars[i+1]);
         }
 
         // Round after kerning.
@@ -35,7 +35,11 @@
 #include "llrect.h"
 #include "v2math.h"
 
+#include <unordered_map>
+
 class LLColor4;
+struct LLFontGlyphInfo;
+enum class EFontGlyphType : U32;
 // Key used to request a font.
 class LLFontDescriptor;
 class LLFontFreetype;
@@ -240,6 +244,28 @@ private:
     LLFontDescriptor mFontDescriptor;
     LLPointer<LLFontFreetype> mFontFreetype;
 
+    // Glyphs of a piece of text and the kerning between them, kept so that
+    // text drawn or measured every frame (name tags, labels) doesn't look up
+    // each glyph and kerning pair again.
+    struct GlyphRun
+    {
+        LLWString                           mText;
+        EFontGlyphType                      mGlyphType;
+        std::vector<const LLFontGlyphInfo*> mGlyphs;    // NULL where the font has no glyph
+        std::vector<F32>                    mKerning;   // between glyph i and i + 1
+        U32                                 mLastUsed;
+    };
+
+    // Run for the first length characters of wchars, at most GLYPH_RUN_MAX_LENGTH of them.
+    // Only valid until the next call, callers walk longer text one run at a time.
+    const GlyphRun* getGlyphRun(const llwchar* wchars, S32 length, EFontGlyphType glyph_type) const;
+    // Kerning between glyph index of run and next_char, which may be past the end of the run
+    F32 getRunKerning(const GlyphRun& run, S32 index, llwchar next_char) const;
+
+    mutable std::unordered_map<size_t, GlyphRun> mGlyphRuns;
+    mutable S32 mGlyphRunGeneration;
+    mutable U32 mGlyphRunClock;
+
     void renderTriangle(LLVector4a* vertex_out, LLVector2* uv_out, LLColor4U* colors_out, const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4U& color, F32 slant_amt) const;
     void drawGlyph(S32& glyph_count, LLVector4a* vertex_out, LLVector2* uv_out, LLColor4U* colors_out, const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4U& color, U8 style, ShadowType shadow, F32 drop_shadow_fade) const;
 
@@ -681,6 +681,11 @@ U32 LLVertexBuffer::sGLRenderBuffer = 0;
 U32 LLVertexBuffer::sGLRenderIndices = 0;
 U32 LLVertexBuffer::sLastMask = 0;
 U32 LLVertexBuffer::sVertexCount = 0;
+U32 LLVertexBuffer::sMultiDrawMode = LLVertexBuffer::MULTI_DRAW_OFF;
+U32 LLVertexBuffer::sDrawCallCount = 0;
+
+// GL_DRAW_INDIRECT_BUFFER used by drawRanges()
+static GLuint sIndirectBuffer = 0;
 
 
 //NOTE: each component must be AT LEAST 4 bytes in size to avoid a performance penalty on AMD hardware
@@ -907,12 +912,108 @@ void LLVertexBuffer::drawRange(U32 mode, U32 start, U32 end, U32 count, U32 indi
     glDrawRangeElements(sGLMode[mode], start, end, count, mIndicesType,
         (GLvoid*) (indices_offset * (size_t) mIndicesStride));
     STOP_GLERROR;
+    ++sDrawCallCount;
 }
 
 void LLVertexBuffer::drawRangeFast(U32 mode, U32 start, U32 end, U32 count, U32 indices_offset) const
 {
     glDrawRangeElements(sGLMode[mode], start, end, count, mIndicesType,
         (GLvoid*)(indices_offset * (size_t)mIndicesStride));
+    ++sDrawCallCount;
+}
+
+//static
+U32 LLVertexBuffer::coalesceRanges(U32* counts, U32* indices_offsets, U32 range_count)
+{
+    if (range_count == 0)
+    {
+        return 0;
+    }
+
+    U32 last = 0;
+    for (U32 i = 1; i < range_count; ++i)
+    {
+        if (indices_offsets[last] + counts[last] == indices_offsets[i])
+        {
+            counts[last] += counts[i];
+        }
+        else
+        {
+            ++last;
+            counts[last] = counts[i];
+            indices_offsets[last] = indices_offsets[i];
+        }
+    }
+
+    return last + 1;
+}
+
+void LLVertexBuffer::drawRanges(U32 mode, U32 start, U32 end, U32* counts, U32* indices_offsets, U32 range_count) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VERTEX;
+    if (sMultiDrawMode != MULTI_DRAW_OFF)
+    {
+        range_count = coalesceRanges(counts, indices_offsets, range_count);
+    }
+
+    if (sMultiDrawMode != MULTI_DRAW_INDIRECT || range_count < 2)
+    {
+        for (U32 i = 0; i < range_count; ++i)
+        {
+            drawRange(mode, start, end, counts[i], indices_offsets[i]);
+        }
+        return;
+    }
+
+    llassert(mGLBuffer == sGLRenderBuffer);
+    llassert(mGLIndices == sGLRenderIndices);
+    gGL.syncMatrices();
+    STOP_GLERROR;
+
+#if !LL_DARWIN
+    if (gGLManager.mGLVersion >= 4.29f)
+    {
+        // count, instance count, first index, base vertex, base instance
+        static std::vector<U32> commands;
+        commands.resize(range_count * 5);
+        for (U32 i = 0; i < range_count; ++i)
+        {
+            llassert(validateRange(start, end, counts[i], indices_offsets[i]));
+            U32* command = &commands[i * 5];
+            command[0] = counts[i];
+            command[1] = 1;
+            command[2] = indices_offsets[i];
+            command[3] = 0;
+            command[4] = 0;
+        }
+
+        if (!sIndirectBuffer)
+        {
+            glGenBuffers(1, &sIndirectBuffer);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, sIndirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(U32), commands.data(), GL_STREAM_DRAW);
+        glMultiDrawElementsIndirect(sGLMode[mode], mIndicesType, nullptr, range_count, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        STOP_GLERROR;
+        ++sDrawCallCount;
+        return;
+    }
+#endif
+
+    static std::vector<GLsizei> gl_counts;
+    static std::vector<const GLvoid*> gl_offsets;
+    gl_counts.resize(range_count);
+    gl_offsets.resize(range_count);
+    for (U32 i = 0; i < range_count; ++i)
+    {
+        llassert(validateRange(start, end, counts[i], indices_offsets[i]));
+        gl_counts[i] = counts[i];
+        gl_offsets[i] = (GLvoid*)(indices_offsets[i] * (size_t)mIndicesStride);
+    }
+    glMultiDrawElements(sGLMode[mode], gl_counts.data(), mIndicesType, gl_offsets.data(), range_count);
+    STOP_GLERROR;
+    ++sDrawCallCount;
 }
 
 
@@ -932,6 +1033,7 @@ void LLVertexBuffer::drawArrays(U32 mode, U32 first, U32 count) const
     STOP_GLERROR;
     glDrawArrays(sGLMode[mode], first, count);
     STOP_GLERROR;
+    ++sDrawCallCount;
 }
 
 //static
@@ -977,6 +1079,12 @@ void LLVertexBuffer::cleanupClass()
 {
     unbind();
 
+    if (sIndirectBuffer)
+    {
+        glDeleteBuffers(1, &sIndirectBuffer);
+        sIndirectBuffer = 0;
+    }
+
     delete sVBOPool;
     sVBOPool = nullptr;
 
@@ -1282,7 +1390,7 @@ U8* LLVertexBuffer::mapVertexBuffer(LLVertexBuffer::AttributeType type, U32 inde
         count = mNumVerts - index;
     }
 
-    if (!gGLManager.mIsApple)
+    if (!gGLManager.mIsApple && !mMappedWhole)
     {
         U32 start = mOffsets[type] + sTypeSize[type] * index;
         U32 end = start + sTypeSize[type] * count-1;
@@ -1319,7 +1427,7 @@ U8* LLVertexBuffer::mapIndexBuffer(U32 index, S32 count)
         count = mNumIndices-index;
     }
 
-    if (!gGLManager.mIsApple)
+    if (!gGLManager.mIsApple && !mMappedWhole)
     {
         U32 start = sizeof(U16) * index;
         U32 end = start + sizeof(U16) * count-1;
@@ -1395,6 +1503,30 @@ void LLVertexBuffer::unmapBuffer()
     flushBuffers();
 }
 
+void LLVertexBuffer::mapWholeBuffer()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VERTEX;
+    _mapBuffer();
+
+    if (!gGLManager.mIsApple)
+    {
+        mMappedVertexRegions.clear();
+        mMappedIndexRegions.clear();
+
+        if (mSize > 0)
+        {
+            mMappedVertexRegions.push_back({ 0, mSize - 1 });
+        }
+
+        if (mIndicesSize > 0)
+        {
+            mMappedIndexRegions.push_back({ 0, mIndicesSize - 1 });
+        }
+    }
+
+    mMappedWhole = true;
+}
+
 void LLVertexBuffer::_mapBuffer()
 {
     if (!mMapped)
@@ -1412,6 +1544,8 @@ void LLVertexBuffer::_unmapBuffer()
         return;
     }
 
+    mMappedWhole = false;
+
     struct SortMappedRegion
     {
         bool operator()(const MappedRegion& lhs, const MappedRegion& rhs)
@@ -202,6 +202,12 @@ public:
     // synonym for flushBuffers
     void    unmapBuffer();
 
+    // Map the entire buffer for writing until the next flushBuffers.  Until then,
+    // mapVertexBuffer/mapIndexBuffer and the getFooStrider accessors only compute
+    // addresses, so other threads may fill disjoint ranges of the buffer
+    // concurrently.  Must be called from the main thread.
+    void    mapWholeBuffer();
+
     // set for rendering
     // assumes (and will assert on) the following:
     //      - this buffer has no pending unmapBuffer call
@@ -276,6 +282,15 @@ public:
     // since the last call to syncMatrices, this is much faster than drawRange
     void drawRangeFast(U32 mode, U32 start, U32 end, U32 count, U32 indices_offset) const;
 
+    // draw range_count index ranges, as if by calling drawRange(mode, start, end, counts[i], indices_offsets[i])
+    // for each, with as few GL calls as sMultiDrawMode allows. start and end must bound the vertices
+    // of every range. The arrays are modified by the coalescing, see coalesceRanges().
+    void drawRanges(U32 mode, U32 start, U32 end, U32* counts, U32* indices_offsets, U32 range_count) const;
+
+    // merge each range into the previous one when it starts where the previous one ends,
+    // returns the number of ranges left at the front of the arrays
+    static U32 coalesceRanges(U32* counts, U32* indices_offsets, U32 range_count);
+
     //for debugging, validate data in given range is valid
     bool validateRange(U32 start, U32 end, U32 count, U32 offset) const;
 
@@ -328,6 +343,7 @@ private:
     // add to set of mapped buffers
     void _mapBuffer();
     bool mMapped = false;
+    bool mMappedWhole = false; // see mapWholeBuffer
 
 public:
 
@@ -338,6 +354,19 @@ public:
     static U32 sGLRenderIndices;
     static U32 sLastMask;
     static U32 sVertexCount;
+
+    // how drawRanges() issues the ranges it is given
+    enum eMultiDrawMode
+    {
+        MULTI_DRAW_OFF = 0,         // one glDrawRangeElements per range
+        MULTI_DRAW_COALESCE,        // merge adjacent ranges, then one glDrawRangeElements per range
+        MULTI_DRAW_INDIRECT,        // merge adjacent ranges, then one glMultiDrawElementsIndirect call
+                                    // (glMultiDrawElements where GL 4.3 is not available)
+    };
+    static U32 sMultiDrawMode;
+
+    // number of draw calls issued by vertex buffers, never reset
+    static U32 sDrawCallCount;
 };
 
 #if LL_PROFILER_ENABLE_RENDER_DOC
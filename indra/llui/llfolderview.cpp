@@ -180,6 +180,9 @@ LLFolderView::LLFolderView(const Params& p)
     mShowSelectionContext(false),
     mShowSingleSelection(false),
     mArrangeGeneration(0),
+    mArrangeBandTop(0),
+    mArrangeBandBottom(S32_MAX),
+    mArrangeSkippedItems(false),
     mSignalSelectCallback(0),
     mMinWidth(0),
     mDragAndDropThisFrame(false),
@@ -326,6 +329,7 @@ S32 LLFolderView::arrange( S32* unused_width, S32* unused_height )
     mMinWidth = 0;
     S32 target_height;
 
+    updateArrangeBand();
     LLFolderViewFolder::arrange(&mMinWidth, &target_height);
 
     LLRect scroll_rect = (mScrollContainer ? mScrollContainer->getContentWindowRect() : LLRect());
@@ -343,6 +347,36 @@ S32 LLFolderView::arrange( S32* unused_width, S32* unused_height )
     return ll_round(mTargetHeight);
 }
 
+void LLFolderView::updateArrangeBand()
+{
+    mArrangeSkippedItems = false;
+    if (!mScrollContainer)
+    {
+        mArrangeBandTop = 0;
+        mArrangeBandBottom = S32_MAX;
+        return;
+    }
+
+    // a page above and below the visible part, so that
+    // scrolling a little doesn't need another arrange
+    LLRect visible_rect = getVisibleRect();
+    S32 visible_top = getRect().getHeight() - visible_rect.mTop;
+    S32 visible_height = visible_rect.getHeight();
+    mArrangeBandTop = visible_top - visible_height;
+    mArrangeBandBottom = visible_top + visible_height * 2;
+}
+
+bool LLFolderView::needsBandArrange()
+{
+    if (!mArrangeSkippedItems || !mScrollContainer)
+    {
+        return false;
+    }
+    LLRect visible_rect = getVisibleRect();
+    S32 visible_top = getRect().getHeight() - visible_rect.mTop;
+    return visible_top < mArrangeBandTop || visible_top + visible_rect.getHeight() > mArrangeBandBottom;
+}
+
 void LLFolderView::filter( LLFolderViewFilter& filter )
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
@@ -1796,6 +1830,11 @@ void LLFolderView::update()
   if ( is_visible )
   {
     sanitizeSelection();
+    if (needsBandArrange())
+    {
+        // scrolled to items that haven't been laid out yet
+        arrangeAll();
+    }
     if( needsArrange() )
     {
       S32 height = 0;
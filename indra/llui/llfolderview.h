@@ -144,6 +144,16 @@ public:
     void arrangeAll() { mArrangeGeneration++; }
     S32 getArrangeGeneration() const { return mArrangeGeneration; }
 
+    // Rows between these distances from the top of the view get fully
+    // arranged, big folders leave the rest for when they scroll closer.
+    // update() arranges again once the visible part leaves the band.
+    // Only layout is bounded this way, every item still has its widget.
+    bool isInArrangeBand(S32 top_offset, S32 height) const
+    {
+        return top_offset < mArrangeBandBottom && top_offset + height > mArrangeBandTop;
+    }
+    void setArrangeSkippedItems() { mArrangeSkippedItems = true; }
+
     // applies filters to control visibility of items
     virtual void filter( LLFolderViewFilter& filter);
 
@@ -267,6 +277,9 @@ public:
 private:
     void updateMenuOptions(LLMenuGL* menu);
     void updateRenamerPosition();
+    void updateArrangeBand();
+    // whether the visible part of the view has scrolled out of the arranged band
+    bool needsBandArrange();
     static void onIdleUpdateMenu(void* user_data);
 
 protected:
@@ -322,6 +335,9 @@ protected:
     std::string                     mSearchString;
     LLFrameTimer                    mMultiSelectionFadeTimer;
     S32                             mArrangeGeneration;
+    S32                             mArrangeBandTop;
+    S32                             mArrangeBandBottom;
+    bool                            mArrangeSkippedItems;
 
     signal_t                        mSelectSignal;
     signal_t                        mReshapeSignal;
@@ -75,6 +75,8 @@ const LLColor4U DEFAULT_WHITE(255, 255, 255);
 
 constexpr S32 FAVORITE_IMAGE_SIZE = 14;
 constexpr S32 FAVORITE_IMAGE_PAD = 3;
+// folders with more items than this only arrange the ones near the visible area
+constexpr size_t ARRANGE_BAND_MIN_ITEMS = 100;
 
 
 //static
@@ -1191,6 +1193,7 @@ LLFolderViewFolder::LLFolderViewFolder( const LLFolderViewItem::Params& p ):
     mAreChildrenInited(false), // folder might have children that are not built yet.
     mLastArrangeGeneration( -1 ),
     mLastCalculatedWidth(0),
+    mArrangeTopOffset(0),
     mFavoritesDirtyFlags(0)
 {
 }
@@ -1327,6 +1330,7 @@ S32 LLFolderViewFolder::arrange( S32* width, S32* height )
                     S32 child_height = 0;
                     S32 child_top = parent_item_height - ll_round(running_height);
 
+                    folderp->mArrangeTopOffset = mArrangeTopOffset + ll_round(running_height);
                     target_height += folderp->arrange( &child_width, &child_height );
 
                     running_height += (F32)child_height;
@@ -1334,13 +1338,42 @@ S32 LLFolderViewFolder::arrange( S32* width, S32* height )
                     folderp->setOrigin( 0, child_top - folderp->getRect().getHeight() );
                 }
             }
+            // In big folders only lay out the items near the visible part of
+            // the root, the others just get stacked at their usual height
+            static LLUICachedControl<bool> arrange_band("FolderViewArrangeVisibleOnly", true);
+            LLFolderView* root = getRoot();
+            bool skip_offscreen = arrange_band && mItems.size() > ARRANGE_BAND_MIN_ITEMS;
+            bool use_ellipses = root->getUseEllipses();
+
             for(items_t::iterator iit = mItems.begin();
                 iit != mItems.end(); ++iit)
             {
                 LLFolderViewItem* itemp = (*iit);
                 itemp->setVisible(itemp->isPotentiallyVisible());
 
-                if (itemp->getVisible())
+                if (itemp->getVisible()
+                    && skip_offscreen
+                    && !root->isInArrangeBand(mArrangeTopOffset + ll_round(running_height), itemp->getItemHeight()))
+                {
+                    S32 child_height = itemp->getItemHeight();
+                    S32 child_top = parent_item_height - ll_round(running_height);
+                    if (itemp->getRect().getHeight() != child_height)
+                    {
+                        itemp->reshape( itemp->getRect().getWidth(), child_height);
+                    }
+
+                    target_height += child_height;
+                    running_height += (F32)child_height;
+                    // label width from the last time this item got arranged
+                    *width = llmax(*width, itemp->getLabelWidth());
+                    if (use_ellipses)
+                    {
+                        *width = llmin(*width, root->getRect().getWidth());
+                    }
+                    itemp->setOrigin( 0, child_top - child_height );
+                    root->setArrangeSkippedItems();
+                }
+                else if (itemp->getVisible())
                 {
                     S32 child_width = *width;
                     S32 child_height = 0;
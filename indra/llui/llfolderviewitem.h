@@ -279,6 +279,8 @@ public:
     virtual const LLFolderView* getRoot() const;
     bool            isDescendantOf( const LLFolderViewFolder* potential_ancestor );
     S32             getIndentation() const { return mIndentation; }
+    // width needed for the label as of the last arrange()
+    S32             getLabelWidth() const { return mLabelWidth; }
 
     virtual bool    passedFilter(S32 filter_generation = -1);
     virtual bool    isPotentiallyVisible(S32 filter_generation = -1);
@@ -362,6 +364,7 @@ protected:
     F32         mAutoOpenCountdown;
     S32         mLastArrangeGeneration;
     S32         mLastCalculatedWidth;
+    S32         mArrangeTopOffset; // distance from the top of the root when last arranged
     bool        mIsFolderComplete; // indicates that some children were not loaded/added yet
     bool        mAreChildrenInited; // indicates that no children were initialized
 
@@ -345,6 +345,7 @@ LLScrollListCtrl::~LLScrollListCtrl()
 
     std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
     mItemList.clear();
+    mOrder.resortAll();
     clearColumns(); //clears columns and deletes headers
     delete mIsFriendSignal;
 
@@ -396,6 +397,7 @@ void LLScrollListCtrl::clearRows()
 {
     std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
     mItemList.clear();
+    mOrder.resortAll();
     //mItemCount = 0;
 
     // Scroll the bar back up to the top.
@@ -585,7 +587,9 @@ bool LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, bool r
         case ADD_DEFAULT:
         case ADD_BOTTOM:
             mItemList.push_back(item);
-            setNeedsSort();
+            mSorted = false;
+            // with incremental sorting, items already there keep their order
+            mOrder.appended(mItemList);
             break;
 
         default:
@@ -899,7 +903,7 @@ bool LLScrollListCtrl::selectItemRange(S32 first_index, S32 last_index)
         LLScrollListItem *itemp = *iter;
         if (!itemp)
         {
-            iter = mItemList.erase(iter);
+            iter = eraseItem(iter);
             continue;
         }
 
@@ -942,6 +946,7 @@ void LLScrollListCtrl::swapWithNext(S32 index)
     LLScrollListItem *cur_itemp = mItemList[index];
     mItemList[index] = mItemList[index + 1];
     mItemList[index + 1] = cur_itemp;
+    mOrder.resortAll();
 }
 
 
@@ -956,6 +961,7 @@ void LLScrollListCtrl::swapWithPrevious(S32 index)
     LLScrollListItem *cur_itemp = mItemList[index];
     mItemList[index] = mItemList[index - 1];
     mItemList[index - 1] = cur_itemp;
+    mOrder.resortAll();
 }
 
 
@@ -975,7 +981,7 @@ void LLScrollListCtrl::deleteSingleItem(S32 target_index)
         mLastSelected = NULL;
     }
     delete itemp;
-    mItemList.erase(mItemList.begin() + target_index);
+    eraseItem(mItemList.begin() + target_index);
     dirtyColumns();
 }
 
@@ -993,7 +999,7 @@ void LLScrollListCtrl::deleteItems(const LLSD& sd)
                 mLastSelected = NULL;
             }
             delete itemp;
-            iter = mItemList.erase(iter);
+            iter = eraseItem(iter);
         }
         else
         {
@@ -1013,7 +1019,7 @@ void LLScrollListCtrl::deleteSelectedItems()
         if (itemp->getSelected())
         {
             delete itemp;
-            iter = mItemList.erase(iter);
+            iter = eraseItem(iter);
         }
         else
         {
@@ -1075,37 +1081,34 @@ S32 LLScrollListCtrl::selectMultiple( uuid_vec_t ids )
 S32 LLScrollListCtrl::getItemIndex( LLScrollListItem* target_item ) const
 {
     updateSort();
-
-    S32 index = 0;
-    item_list::const_iterator iter;
-    for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
-    {
-        LLScrollListItem *itemp = *iter;
-        if (target_item == itemp)
-        {
-            return index;
-        }
-        index++;
-    }
-    return -1;
+    return mOrder.find(mItemList, target_item);
 }
 
 S32 LLScrollListCtrl::getItemIndex( const LLUUID& target_id ) const
 {
     updateSort();
+    return mOrder.find(mItemList, target_id);
+}
 
-    S32 index = 0;
-    item_list::const_iterator iter;
-    for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
+LLScrollListCtrl::item_list::iterator LLScrollListCtrl::eraseItem(item_list::iterator iter)
+{
+    mOrder.erasing(iter - mItemList.begin());
+    return mItemList.erase(iter);
+}
+
+void LLScrollListCtrl::setNeedsSort(bool val)
+{
+    mSorted = !val;
+    if (val)
     {
-        LLScrollListItem *itemp = *iter;
-        if (target_id == itemp->getUUID())
-        {
-            return index;
-        }
-        index++;
+        // sort criteria or cell values changed, everything needs sorting
+        mOrder.resortAll();
     }
-    return -1;
+}
+
+void LLScrollListCtrl::setIncrementalSort(bool incremental)
+{
+    mOrder.setIncremental(incremental);
 }
 
 void LLScrollListCtrl::selectPrevItem( bool extend_selection)
@@ -2762,11 +2765,9 @@ void LLScrollListCtrl::updateSort() const
 {
     if (hasSortOrder() && !isSorted())
     {
-        // do stable sort to preserve any previous sorts
-        std::stable_sort(
-            mItemList.begin(),
-            mItemList.end(),
-            SortScrollListItem(mSortColumns,mSortCallback, mAlternateSort));
+        // do stable sort to preserve any previous sorts, of only what was
+        // added since the last one if sorting is incremental
+        mOrder.sort(mItemList, SortScrollListItem(mSortColumns, mSortCallback, mAlternateSort));
 
         mSorted = true;
     }
@@ -2783,6 +2784,7 @@ void LLScrollListCtrl::sortOnce(S32 column, bool ascending)
         mItemList.begin(),
         mItemList.end(),
         SortScrollListItem(sort_column,mSortCallback,mAlternateSort));
+    mOrder.resortAll();
 }
 
 void LLScrollListCtrl::dirtyColumns()
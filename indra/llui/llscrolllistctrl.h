@@ -37,6 +37,7 @@
 #include "llfontgl.h"
 #include "llui.h"
 #include "llstring.h"   // LLWString
+#include "llscrolllistorder.h"
 #include "lleditmenuhandler.h"
 #include "llframetimer.h"
 
@@ -416,7 +417,10 @@ public:
     void            sortOnce(S32 column, bool ascending);
 
     // manually call this whenever editing list items in place to flag need for resorting
-    void            setNeedsSort(bool val = true) { mSorted = !val; }
+    void            setNeedsSort(bool val = true);
+    // only sort what was added at the bottom since the last sort and merge it
+    // in, for lists that never edit sort column cells without setNeedsSort()
+    void            setIncrementalSort(bool incremental);
     void            dirtyColumns(); // some operation has potentially affected column layout or ordering
 
     bool highlightMatchingItems(const std::string& filter_str);
@@ -456,6 +460,9 @@ protected:
 private:
     void            drawItems();
 
+    // removes the item from mItemList, keeping sort and index bookkeeping right
+    item_list::iterator eraseItem(item_list::iterator iter);
+
     void            updateLineHeightInsert(LLScrollListItem* item);
     void            reportInvalidInput();
     bool            isRepeatedChars(const LLWString& string) const;
@@ -539,6 +546,7 @@ private:
     S32             mTotalColumnPadding;
 
     mutable bool    mSorted;
+    mutable LLScrollListOrder<LLScrollListItem> mOrder;
 
     typedef std::map<std::string, LLScrollListColumn*> column_map_t;
     column_map_t mColumns;
@@ -0,0 +1,154 @@
+/**
+ * @file llscrolllistorder.h
+ * @brief Sort and index bookkeeping for the items of a scroll list
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSCROLLLISTORDER_H
+#define LL_LLSCROLLLISTORDER_H
+
+#include "lluuid.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+// Keeps track of how many leading items of a list are in sort order and
+// where every item is, for LLScrollListCtrl.  Apart from the control so that
+// it can be tested without any UI.
+//
+// With incremental sorting, items appended since the last sort get sorted
+// among themselves and merged in.  Both steps are stable, so the result is
+// what stable sorting the whole list gives, as long as nobody changed the
+// sort values of the items already sorted without calling resortAll().
+// Without it, every sort after an append sorts the whole list again.
+//
+// ITEM needs getUUID().
+template <typename ITEM>
+class LLScrollListOrder
+{
+public:
+    typedef std::deque<ITEM*> item_list;
+
+    void setIncremental(bool incremental)
+    {
+        mIncremental = incremental;
+        mSortedCount = 0;
+    }
+    bool isIncremental() const { return mIncremental; }
+
+    // items.back() was just appended
+    void appended(const item_list& items)
+    {
+        if (!mIncremental)
+        {
+            mSortedCount = 0;
+        }
+        if (!mIndexDirty)
+        {
+            S32 index = (S32)items.size() - 1;
+            mUUIDIndex.emplace(items.back()->getUUID(), index);
+            mItemIndex.emplace(items.back(), index);
+        }
+    }
+
+    // the item at index is about to be erased
+    void erasing(size_t index)
+    {
+        if (index < mSortedCount)
+        {
+            // the rest of the sorted items are still sorted
+            mSortedCount--;
+        }
+        mIndexDirty = true;
+    }
+
+    // items moved in a way the bookkeeping can't follow, or sort values or
+    // criteria changed: the next sort sorts everything
+    void resortAll()
+    {
+        mSortedCount = 0;
+        mIndexDirty = true;
+    }
+
+    // items moved, but those sorted are still sorted
+    void reindex() { mIndexDirty = true; }
+
+    template <typename COMPARE>
+    void sort(item_list& items, const COMPARE& compare)
+    {
+        typename item_list::iterator sorted_end = items.begin() + std::min(mSortedCount, items.size());
+        std::stable_sort(sorted_end, items.end(), compare);
+        std::inplace_merge(items.begin(), sorted_end, items.end(), compare);
+        mSortedCount = items.size();
+        mIndexDirty = true;
+    }
+
+    size_t getSortedCount() const { return mSortedCount; }
+
+    // -1 if not in items
+    S32 find(const item_list& items, const ITEM* item)
+    {
+        updateIndex(items);
+        auto found = mItemIndex.find(item);
+        return found != mItemIndex.end() ? found->second : -1;
+    }
+
+    // first item with id, -1 if none
+    S32 find(const item_list& items, const LLUUID& id)
+    {
+        updateIndex(items);
+        auto found = mUUIDIndex.find(id);
+        return found != mUUIDIndex.end() ? found->second : -1;
+    }
+
+private:
+    void updateIndex(const item_list& items)
+    {
+        if (!mIndexDirty)
+        {
+            return;
+        }
+        mUUIDIndex.clear();
+        mItemIndex.clear();
+        mUUIDIndex.reserve(items.size());
+        mItemIndex.reserve(items.size());
+        S32 index = 0;
+        for (const ITEM* item : items)
+        {
+            // emplace keeps the first item with an id
+            mUUIDIndex.emplace(item->getUUID(), index);
+            mItemIndex.emplace(item, index);
+            index++;
+        }
+        mIndexDirty = false;
+    }
+
+    bool    mIncremental = false;
+    size_t  mSortedCount = 0;
+    bool    mIndexDirty = true;
+    std::unordered_map<LLUUID, S32> mUUIDIndex;
+    std::unordered_map<const ITEM*, S32> mItemIndex;
+};
+
+#endif // LL_LLSCROLLLISTORDER_H
@@ -46,6 +46,7 @@
 #include "llview.h"
 #include "llwindow.h"
 #include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
 
 const F32   CURSOR_FLASH_DELAY = 1.0f;  // in seconds
 const S32   CURSOR_THICKNESS = 2;
@@ -1808,6 +1809,9 @@ void LLTextBase::reflow()
     first_char_rect.mTop = mVisibleTextRect.mTop - first_char_rect.mTop;
     first_char_rect.mBottom = mVisibleTextRect.mTop - first_char_rect.mBottom;
 
+    static LLUICachedControl<bool> use_paragraph_cache("TextParagraphLayoutCache", true);
+    ++mReflowCount;
+
     S32 reflow_count = 0;
     while(mReflowIndex < S32_MAX)
     {
@@ -1840,6 +1844,7 @@ void LLTextBase::reflow()
         const F32 text_available_width = (F32)(mVisibleTextRect.getWidth() - mHPad);  // reserve room for margin
         F32 remaining_pixels = text_available_width;
         S32 line_count = 0;
+        bool paragraph_start = true;
 
         // find and erase line info structs starting at start_index and going to end of document
         if (!mLineInfoList.empty())
@@ -1851,6 +1856,7 @@ void LLTextBase::reflow()
                 line_start_index = iter->mDocIndexStart;
                 line_count = iter->mLineNum;
                 cur_top = iter->mRect.mTop;
+                paragraph_start = iter == mLineInfoList.begin() || (iter - 1)->mLineNum != iter->mLineNum;
                 getSegmentAndOffset(iter->mDocIndexStart, &seg_iter, &seg_offset);
                 mLineInfoList.erase(iter, mLineInfoList.end());
             }
@@ -1859,8 +1865,54 @@ void LLTextBase::reflow()
         S32 line_height = 0;
         S32 seg_line_offset = line_count + 1;
 
+        // Paragraph being laid out, its lines get cached when it ends as expected
+        size_t paragraph_key = 0;
+        paragraph_layout paragraph;
+        S32 paragraph_doc_start = 0;
+        S32 paragraph_length = 0;
+        size_t paragraph_first_line = 0;
+
         while(seg_iter != mSegments.end())
         {
+            if (paragraph_start)
+            {
+                paragraph_start = false;
+                segment_set_t::iterator next_seg_iter;
+                paragraph_key = use_paragraph_cache
+                    ? getParagraphLayoutKey(seg_iter, seg_offset, text_available_width, paragraph, next_seg_iter)
+                    : 0;
+                paragraph_doc_start = line_start_index;
+                paragraph_length = (S32)paragraph.mText.size();
+                paragraph_first_line = mLineInfoList.size();
+
+                auto found = paragraph_key ? mParagraphLayouts.find(paragraph_key) : mParagraphLayouts.end();
+                if (found != mParagraphLayouts.end() && found->second.sameSource(paragraph))
+                {
+                    // same text, segments and width as a paragraph laid out before
+                    found->second.mLastReflow = mReflowCount;
+                    for (const paragraph_layout::line& line : found->second.mLines)
+                    {
+                        S32 text_left = getLeftOffset(line.mWidth);
+                        mLineInfoList.push_back(line_info(
+                                                    paragraph_doc_start + line.mStart,
+                                                    paragraph_doc_start + line.mEnd,
+                                                    LLRect(text_left, cur_top, text_left + line.mWidth, cur_top - line.mHeight),
+                                                    line_count));
+                        cur_top -= ll_round((F32)line.mHeight * mLineSpacingMult) + mLineSpacingPixels;
+                    }
+
+                    // continue after the line break that ended it
+                    line_start_index = paragraph_doc_start + paragraph_length;
+                    seg_iter = next_seg_iter;
+                    seg_offset = 0;
+                    line_count++;
+                    seg_line_offset = line_count;
+                    paragraph_key = 0;
+                    paragraph_start = true;
+                    continue;
+                }
+            }
+
             LLTextSegmentPtr segment = *seg_iter;
 
             // track maximum height of any segment on this line
@@ -1934,6 +1986,28 @@ void LLTextBase::reflow()
                     cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                     line_height = 0;
                     remaining_pixels = text_available_width;
+
+                    if (paragraph_key && line_start_index == paragraph_doc_start + paragraph_length)
+                    {
+                        // replaces a different paragraph with the same key
+                        paragraph_layout& layout = mParagraphLayouts[paragraph_key];
+                        layout.mText = paragraph.mText;
+                        layout.mSegments = paragraph.mSegments;
+                        layout.mAvailableWidth = paragraph.mAvailableWidth;
+                        layout.mWordWrap = paragraph.mWordWrap;
+                        layout.mScaleX = paragraph.mScaleX;
+                        layout.mResolutionGeneration = paragraph.mResolutionGeneration;
+                        layout.mLastReflow = mReflowCount;
+                        layout.mLines.clear();
+                        for (size_t i = paragraph_first_line; i < mLineInfoList.size(); ++i)
+                        {
+                            const line_info& info = mLineInfoList[i];
+                            layout.mLines.push_back({ info.mDocIndexStart - paragraph_doc_start,
+                                                      info.mDocIndexEnd - paragraph_doc_start,
+                                                      info.mRect.getWidth(),
+                                                      info.mRect.getHeight() });
+                        }
+                    }
                 }
                 ++seg_iter;
                 seg_offset = 0;
@@ -1942,6 +2016,24 @@ void LLTextBase::reflow()
             if (force_newline)
             {
                 line_count++;
+                paragraph_key = 0;
+                paragraph_start = true;
+            }
+        }
+
+        if (mParagraphLayouts.size() > mLineInfoList.size() * 2 + 100)
+        {
+            // forget paragraphs that were edited or scrolled away from
+            for (auto it = mParagraphLayouts.begin(); it != mParagraphLayouts.end();)
+            {
+                if (it->second.mLastReflow != mReflowCount)
+                {
+                    it = mParagraphLayouts.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
             }
         }
 
@@ -1994,6 +2086,59 @@ void LLTextBase::reflow()
     updateCursorXPos();
 }
 
+size_t LLTextBase::getParagraphLayoutKey(segment_set_t::iterator seg_iter, S32 seg_offset, F32 available_width,
+                                         paragraph_layout& paragraph, segment_set_t::iterator& next_seg_iter) const
+{
+    paragraph.mText.clear();
+    paragraph.mSegments.clear();
+    if (seg_iter == mSegments.end())
+    {
+        return 0;
+    }
+
+    const S32 start = (*seg_iter)->getStart() + seg_offset;
+    paragraph.mAvailableWidth = available_width;
+    paragraph.mWordWrap = getWordWrap();
+    paragraph.mScaleX = LLFontGL::sScaleX;
+    paragraph.mResolutionGeneration = LLFontGL::sResolutionGeneration;
+    size_t key = 0;
+    boost::hash_combine(key, available_width);
+    boost::hash_combine(key, paragraph.mWordWrap);
+    boost::hash_combine(key, paragraph.mScaleX);
+    boost::hash_combine(key, paragraph.mResolutionGeneration);
+
+    for (; seg_iter != mSegments.end(); ++seg_iter)
+    {
+        const LLTextSegmentPtr& segment = *seg_iter;
+        size_t segment_key = segment->getLayoutKey();
+        if (!segment_key)
+        {
+            return 0;
+        }
+        paragraph.mSegments.push_back({ segment_key, llmax(segment->getStart(), start) - start, segment->getEnd() - start });
+        boost::hash_combine(key, segment_key);
+        boost::hash_combine(key, paragraph.mSegments.back().mStart);
+        boost::hash_combine(key, paragraph.mSegments.back().mEnd);
+
+        if (segment->endsLine())
+        {
+            next_seg_iter = seg_iter;
+            ++next_seg_iter;
+            S32 length = segment->getEnd() - start;
+            const LLWString& text = getWText();
+            // the last line of the document always gets laid out
+            if (next_seg_iter == mSegments.end() || start + length > (S32)text.size())
+            {
+                return 0;
+            }
+            paragraph.mText.assign(text, start, length);
+            boost::hash_range(key, paragraph.mText.begin(), paragraph.mText.end());
+            return key ? key : 1;
+        }
+    }
+    return 0;
+}
+
 LLRect LLTextBase::getTextBoundingRect()
 {
     reflow();
@@ -3902,6 +4047,18 @@ S32 LLNormalTextSegment::getNumChars(S32 num_pixels, S32 segment_offset, S32 lin
     return num_chars;
 }
 
+size_t LLNormalTextSegment::getLayoutKey() const
+{
+    if (mStyle->getImage().notNull())
+    {
+        // changes size once loaded
+        return 0;
+    }
+    size_t key = (size_t)mStyle->getFont();
+    boost::hash_combine(key, mFontHeight);
+    return key;
+}
+
 void LLNormalTextSegment::updateLayout(const class LLTextBase& editor)
 {
     LLTextSegment::updateLayout(editor);
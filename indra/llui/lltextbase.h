@@ -40,6 +40,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include <boost/signals2.hpp>
 
@@ -86,6 +87,14 @@ public:
     * @return number of chars that will fit into current line
     */
     virtual S32                 getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
+    /**
+    * Same for segments that measure the same characters the same way, so that
+    * LLTextBase::reflow() can reuse line breaks of unchanged paragraphs.
+    * 0 when the size can change without the text changing (widgets, images).
+    */
+    virtual size_t              getLayoutKey() const { return 0; }
+    // true for segments that always end their line
+    virtual bool                endsLine() const { return false; }
     virtual void                updateLayout(const class LLTextBase& editor);
     virtual F32                 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     virtual bool                canEdit() const;
@@ -142,6 +151,7 @@ public:
     /*virtual*/ bool                getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     /*virtual*/ S32                 getOffset(S32 segment_local_x_coord, S32 start_offset, S32 num_chars, bool round) const;
     /*virtual*/ S32                 getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
+    /*virtual*/ size_t              getLayoutKey() const;
     /*virtual*/ void                updateLayout(const class LLTextBase& editor);
     /*virtual*/ F32                 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     /*virtual*/ bool                canEdit() const { return mCanEdit; }
@@ -194,6 +204,8 @@ public:
     LLLabelTextSegment( LLStyleConstSP style, S32 start, S32 end, LLTextBase& editor );
     LLLabelTextSegment( const LLUIColor& color, S32 start, S32 end, LLTextBase& editor, bool is_visible = true);
     /*virtual*/ LLTextSegmentPtr clone(LLTextBase& target) const;
+    // measures the label, not the document text
+    /*virtual*/ size_t getLayoutKey() const { return 0; }
 
 protected:
 
@@ -281,6 +293,8 @@ public:
     /*virtual*/ LLTextSegmentPtr clone(LLTextBase& target) const;
     /*virtual*/ bool        getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     S32         getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
+    size_t      getLayoutKey() const { return (size_t)mFontHeight + 1; }
+    bool        endsLine() const { return true; }
     F32         draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
 
 private:
@@ -574,6 +588,46 @@ protected:
     struct line_end_compare;
     typedef std::vector<LLTextSegmentPtr> segment_vec_t;
 
+    // Lines of a paragraph as reflow() broke them, relative to its start
+    struct paragraph_layout
+    {
+        struct line
+        {
+            S32 mStart;
+            S32 mEnd;
+            S32 mWidth;
+            S32 mHeight;
+        };
+        struct segment
+        {
+            size_t mLayoutKey;
+            S32 mStart;
+            S32 mEnd;
+            bool operator==(const segment& other) const
+            {
+                return mLayoutKey == other.mLayoutKey && mStart == other.mStart && mEnd == other.mEnd;
+            }
+        };
+
+        // what the lines were laid out for, the map key is only a hash of it
+        LLWString mText;
+        std::vector<segment> mSegments;
+        F32 mAvailableWidth = 0.f;
+        bool mWordWrap = false;
+        F32 mScaleX = 0.f;
+        S32 mResolutionGeneration = 0;
+
+        std::vector<line> mLines;
+        U32 mLastReflow = 0;
+
+        bool sameSource(const paragraph_layout& other) const
+        {
+            return mAvailableWidth == other.mAvailableWidth && mWordWrap == other.mWordWrap
+                && mScaleX == other.mScaleX && mResolutionGeneration == other.mResolutionGeneration
+                && mSegments == other.mSegments && mText == other.mText;
+        }
+    };
+
     // Abstract inner base class representing an undoable editor command.
     // Concrete sub-classes can be defined for operations such as insert, remove, etc.
     // Used as arguments to the execute() method below.
@@ -663,6 +717,10 @@ protected:
     std::pair<S32, S32>             getVisibleLines(bool fully_visible = false);
     S32                             getLeftOffset(S32 width);
     void                            reflow();
+    // Key for the paragraph starting at seg_iter, 0 if its lines can't be reused.
+    // Fills in what its lines depend on and sets the first segment after it.
+    size_t                          getParagraphLayoutKey(segment_set_t::iterator seg_iter, S32 seg_offset, F32 available_width,
+                                                          paragraph_layout& paragraph, segment_set_t::iterator& next_seg_iter) const;
 
     // cursor
     void                            updateCursorXPos();
@@ -703,6 +761,8 @@ protected:
     // text segmentation and flow
     segment_set_t               mSegments;
     line_list_t                 mLineInfoList;
+    std::unordered_map<size_t, paragraph_layout> mParagraphLayouts;   // by getParagraphLayoutKey()
+    U32                         mReflowCount = 0;
     LLRect                      mVisibleTextRect;           // The rect in which text is drawn.  Excludes borders.
     LLRect                      mTextBoundingRect;
 
@@ -43,6 +43,7 @@
 
 // this library includes
 #include "llpanel.h"
+#include "llxuicache.h"
 
 //-----------------------------------------------------------------------------
 
@@ -102,7 +103,7 @@ void LLUICtrlFactory::loadWidgetTemplate(const std::string& widget_tag, LLInitPa
     {
         LLUICtrlFactory::instance().pushFileName(base_filename);
 
-        if (!LLXMLNode::getLayeredXMLNode(root_node, search_paths))
+        if (!LLXUICache::instance().getLayeredXMLNode(search_paths, root_node))
         {
             LL_WARNS() << "Couldn't parse widget from: " << base_filename << LL_ENDL;
             return;
@@ -169,7 +170,7 @@ bool LLUICtrlFactory::getLayeredXMLNode(const std::string &xui_filename, LLXMLNo
         paths.push_back(xui_filename);
     }
 
-    return LLXMLNode::getLayeredXMLNode(root, paths);
+    return LLXUICache::instance().getLayeredXMLNode(paths, root);
 }
 
 
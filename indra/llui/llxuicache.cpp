@@ -0,0 +1,176 @@
+/**
+ * @file llxuicache.cpp
+ * @brief Cache of parsed and layered XUI files
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llxuicache.h"
+
+#include "llcontrol.h"
+#include "lldir.h"
+#include "llfile.h"
+#include "llui.h"
+
+#include <boost/algorithm/string/join.hpp>
+
+// change when the layout of cached entries or of LLXMLNode::writeBinary() changes
+constexpr U32 XUI_CACHE_VERSION = 1;
+static const char XUI_CACHE_MAGIC[] = "LLXUI";
+
+LLXUICache::LLXUICache()
+:   mHits(0),
+    mMisses(0)
+{
+}
+
+bool LLXUICache::getLayeredXMLNode(const std::vector<std::string>& paths, LLXMLNodePtr& root)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+    static LLUICachedControl<bool> use_cache("XUIParseCache", true);
+    std::string stamps;
+    if (!use_cache || paths.empty() || !getStamps(paths, stamps))
+    {
+        return LLXMLNode::getLayeredXMLNode(root, paths);
+    }
+
+    std::string key = boost::algorithm::join(paths, "\n");
+    Entry& entry = mEntries[key];
+    if (entry.mStamps != stamps)
+    {
+        // not in memory or out of date, try the cache directory
+        std::string filename = getFilename(key);
+        if (filename.empty() || !loadEntry(filename, entry) || entry.mStamps != stamps)
+        {
+            ++mMisses;
+            if (!LLXMLNode::getLayeredXMLNode(root, paths))
+            {
+                mEntries.erase(key);
+                return false;
+            }
+            entry.mStamps = stamps;
+            entry.mTree.clear();
+            root->writeBinary(entry.mTree);
+            if (!filename.empty())
+            {
+                saveEntry(filename, entry);
+            }
+            return true;
+        }
+    }
+
+    if (!LLXMLNode::readBinary(entry.mTree.data(), entry.mTree.size(), root))
+    {
+        LL_WARNS() << "Discarding bad cache entry for " << paths.front() << LL_ENDL;
+        mEntries.erase(key);
+        return LLXMLNode::getLayeredXMLNode(root, paths);
+    }
+    ++mHits;
+    return true;
+}
+
+//static
+bool LLXUICache::getStamps(const std::vector<std::string>& paths, std::string& stamps)
+{
+    std::ostringstream out;
+    // parser flags change the resulting tree
+    out << XUI_CACHE_VERSION << ' ' << LLXMLNode::sStripEscapedStrings << LLXMLNode::sStripWhitespaceValues << '\n';
+    for (const std::string& path : paths)
+    {
+        if (path.empty())
+        {
+            continue;
+        }
+        llstat stat_data;
+        if (LLFile::stat(path, &stat_data) != 0)
+        {
+            // leave complaining about it to the parser
+            return false;
+        }
+        out << path << ' ' << (U64)stat_data.st_size << ' ' << (U64)stat_data.st_mtime << '\n';
+    }
+    stamps = out.str();
+    return true;
+}
+
+//static
+std::string LLXUICache::getFilename(const std::string& key)
+{
+    std::string cache_dir = gDirUtilp->getCacheDir();
+    if (cache_dir.empty())
+    {
+        return std::string();
+    }
+    std::string dir = gDirUtilp->add(cache_dir, "xui");
+    if (!LLFile::isdir(dir))
+    {
+        LLFile::mkdir(dir);
+    }
+    // entries remember their paths, so a hash collision is just a miss
+    return gDirUtilp->add(dir, llformat("%016llx.xuib", (unsigned long long)std::hash<std::string>()(key)));
+}
+
+//static
+bool LLXUICache::loadEntry(const std::string& filename, Entry& entry)
+{
+    std::string contents = LLFile::getContents(filename);
+    const size_t magic_size = sizeof(XUI_CACHE_MAGIC);
+    U32 stamps_size = 0;
+    if (contents.size() < magic_size + sizeof(U32)
+        || memcmp(contents.data(), XUI_CACHE_MAGIC, magic_size) != 0)
+    {
+        return false;
+    }
+    memcpy(&stamps_size, contents.data() + magic_size, sizeof(U32));
+    size_t tree_start = magic_size + sizeof(U32) + stamps_size;
+    if (contents.size() < tree_start)
+    {
+        return false;
+    }
+    entry.mStamps.assign(contents, magic_size + sizeof(U32), stamps_size);
+    entry.mTree.assign(contents, tree_start, std::string::npos);
+    return true;
+}
+
+//static
+void LLXUICache::saveEntry(const std::string& filename, const Entry& entry)
+{
+    // write a temporary file and rename it, another viewer could be reading
+    std::string temp_filename = filename + ".tmp";
+    LLFILE* fp = LLFile::fopen(temp_filename, "wb");
+    if (!fp)
+    {
+        return;
+    }
+    U32 stamps_size = (U32)entry.mStamps.size();
+    bool written = fwrite(XUI_CACHE_MAGIC, sizeof(XUI_CACHE_MAGIC), 1, fp) == 1
+        && fwrite(&stamps_size, sizeof(U32), 1, fp) == 1
+        && fwrite(entry.mStamps.data(), 1, stamps_size, fp) == stamps_size
+        && fwrite(entry.mTree.data(), 1, entry.mTree.size(), fp) == entry.mTree.size();
+    fclose(fp);
+    if (!written || LLFile::rename(temp_filename, filename) != 0)
+    {
+        LLFile::remove(temp_filename);
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file llxuicache.h
+ * @brief Cache of parsed and layered XUI files
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLXUICACHE_H
+#define LL_LLXUICACHE_H
+
+#include "llsingleton.h"
+#include "llxmlnode.h"
+
+#include <unordered_map>
+
+// Keeps XUI files merged with their skin and language layers in the binary
+// form of LLXMLNode::writeBinary(), in memory and in the cache directory, so
+// that opening a floater again, or starting the viewer again, doesn't parse
+// and merge the XML again.
+//
+// An entry is used while every layer file has the size and modification time
+// it had when the entry was made. Callers get a new tree every time, so they
+// are free to change it.
+class LLXUICache : public LLSingleton<LLXUICache>
+{
+    LLSINGLETON(LLXUICache);
+
+public:
+    // Same as LLXMLNode::getLayeredXMLNode(), from the cache when possible
+    bool getLayeredXMLNode(const std::vector<std::string>& paths, LLXMLNodePtr& root);
+
+    // Forgets entries in memory, files in the cache directory stay
+    void clear() { mEntries.clear(); }
+
+    U32 getHits() const { return mHits; }
+    U32 getMisses() const { return mMisses; }
+
+private:
+    struct Entry
+    {
+        std::string mStamps;    // layer paths, sizes and times
+        std::string mTree;
+    };
+
+    static bool getStamps(const std::vector<std::string>& paths, std::string& stamps);
+    // file in the cache directory for these layers, empty if there is no cache directory
+    static std::string getFilename(const std::string& key);
+    static bool loadEntry(const std::string& filename, Entry& entry);
+    static void saveEntry(const std::string& filename, const Entry& entry);
+
+    std::unordered_map<std::string, Entry> mEntries;
+    U32 mHits;
+    U32 mMisses;
+};
+
+#endif // LL_LLXUICACHE_H
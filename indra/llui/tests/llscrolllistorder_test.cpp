@@ -0,0 +1,235 @@
+/**
+ * @file llscrolllistorder_test.cpp
+ * @brief LLScrollListOrder test cases.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llscrolllistorder.h"
+#include "lltut.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace tut
+{
+    struct scrolllistorder_test
+    {
+        // stands in for LLScrollListItem
+        struct Item
+        {
+            LLUUID mID;
+            S32 mValue;
+            const LLUUID& getUUID() const { return mID; }
+        };
+
+        typedef LLScrollListOrder<Item> order_t;
+
+        struct Compare
+        {
+            bool operator()(const Item* a, const Item* b) const { return a->mValue < b->mValue; }
+        };
+
+        Item* newItem(S32 value)
+        {
+            mItems.emplace_back(new Item{ LLUUID::generateNewID(), value });
+            return mItems.back().get();
+        }
+
+        void append(order_t& order, order_t::item_list& list, S32 value)
+        {
+            list.push_back(newItem(value));
+            order.appended(list);
+        }
+
+        void erase(order_t& order, order_t::item_list& list, size_t index)
+        {
+            order.erasing(index);
+            list.erase(list.begin() + index);
+        }
+
+        // what a full stable sort of the same list gives
+        static order_t::item_list fullSort(order_t::item_list list)
+        {
+            std::stable_sort(list.begin(), list.end(), Compare());
+            return list;
+        }
+
+        static void ensureIndexed(const std::string& msg, order_t& order, const order_t::item_list& list)
+        {
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                ensure_equals(msg + " item index", order.find(list, list[i]), (S32)i);
+                ensure_equals(msg + " uuid index", order.find(list, list[i]->getUUID()), (S32)i);
+            }
+        }
+
+        std::vector<std::unique_ptr<Item>> mItems;
+        std::mt19937 mRandom{ 1234 };
+    };
+    typedef test_group<scrolllistorder_test> scrolllistorder_t;
+    typedef scrolllistorder_t::object scrolllistorder_object_t;
+    tut::scrolllistorder_t tut_scrolllistorder("LLScrollListOrder");
+
+    template<> template<>
+    void scrolllistorder_object_t::test<1>()
+    {
+        set_test_name("incremental sort matches a full sort");
+        order_t order;
+        order.setIncremental(true);
+        order_t::item_list list;
+        std::uniform_int_distribution<S32> value(0, 50);
+
+        for (S32 round = 0; round < 50; ++round)
+        {
+            // append, with plenty of equal values so stability matters
+            S32 count = value(mRandom);
+            for (S32 i = 0; i < count; ++i)
+            {
+                append(order, list, value(mRandom));
+            }
+            // delete from anywhere, sorted part or not
+            S32 erase_count = list.empty() ? 0 : value(mRandom) % (S32)list.size();
+            for (S32 i = 0; i < erase_count; ++i)
+            {
+                erase(order, list, mRandom() % list.size());
+            }
+            ensure("sorted count within list", order.getSortedCount() <= list.size());
+
+            order_t::item_list expected = fullSort(list);
+            order.sort(list, Compare());
+            ensure("sorted like a full sort", list == expected);
+            ensure_equals("all sorted", order.getSortedCount(), list.size());
+            ensureIndexed("round", order, list);
+        }
+    }
+
+    template<> template<>
+    void scrolllistorder_object_t::test<2>()
+    {
+        set_test_name("index follows appends and deletes");
+        order_t order;
+        order_t::item_list list;
+        for (S32 i = 0; i < 10; ++i)
+        {
+            append(order, list, i);
+        }
+        ensureIndexed("appended", order, list);
+
+        // index is clean now, appends extend it
+        append(order, list, 10);
+        ensureIndexed("appended to clean index", order, list);
+
+        // everything after a deleted item moves up
+        Item* after = list[5];
+        erase(order, list, 3);
+        ensure_equals("shifted", order.find(list, after), 4);
+        ensure_equals("shifted by id", order.find(list, after->getUUID()), 4);
+        ensureIndexed("erased", order, list);
+
+        Item gone{ LLUUID::generateNewID(), 0 };
+        ensure_equals("missing item", order.find(list, &gone), -1);
+        ensure_equals("missing id", order.find(list, gone.mID), -1);
+
+        // duplicate ids find the first row
+        Item* duplicate = newItem(0);
+        duplicate->mID = list[2]->mID;
+        list.push_back(duplicate);
+        order.appended(list);
+        ensure_equals("first of duplicates", order.find(list, list[2]->mID), 2);
+        order.reindex();
+        ensure_equals("first of duplicates after reindex", order.find(list, list[2]->mID), 2);
+    }
+
+    template<> template<>
+    void scrolllistorder_object_t::test<3>()
+    {
+        set_test_name("full resort");
+        order_t order;
+        order_t::item_list list;
+        for (S32 i = 0; i < 20; ++i)
+        {
+            append(order, list, 20 - i);
+        }
+        order.sort(list, Compare());
+        ensure("sorted", list == fullSort(list));
+
+        // without incremental sorting, an append sorts the whole list again
+        list.front()->mValue = 100;
+        append(order, list, 0);
+        ensure_equals("nothing kept", order.getSortedCount(), size_t(0));
+        order.sort(list, Compare());
+        ensure("resorted", list == fullSort(list));
+
+        // with it, changed values need resortAll()
+        order.setIncremental(true);
+        order.sort(list, Compare());
+        list.front()->mValue = 200;
+        append(order, list, 5);
+        order.resortAll();
+        order.sort(list, Compare());
+        ensure("resorted after resortAll", list == fullSort(list));
+        ensureIndexed("resorted", order, list);
+    }
+
+    template<> template<>
+    void scrolllistorder_object_t::test<4>()
+    {
+        set_test_name("incremental and full sorts agree over batches");
+        constexpr S32 NUM_ITEMS = 500;
+        constexpr S32 BATCH = 50;
+        std::uniform_int_distribution<S32> value(0, 1000000);
+        std::vector<S32> values(NUM_ITEMS);
+        for (S32& v : values)
+        {
+            v = value(mRandom);
+        }
+
+        // rows arriving a batch at a time, sorted and looked up after each
+        // batch, like a list filled over several frames
+        order_t::item_list results[2];
+        for (S32 incremental = 0; incremental < 2; ++incremental)
+        {
+            order_t order;
+            order.setIncremental(incremental != 0);
+            order_t::item_list& list = results[incremental];
+            for (S32 i = 0; i < NUM_ITEMS; ++i)
+            {
+                append(order, list, values[i]);
+                if ((i + 1) % BATCH == 0)
+                {
+                    order.sort(list, Compare());
+                    ensure_equals("last row found", order.find(list, list.back()), (S32)list.size() - 1);
+                }
+            }
+        }
+
+        ensure_equals("same size", results[1].size(), results[0].size());
+        for (size_t i = 0; i < results[0].size(); ++i)
+        {
+            ensure_equals("same order", results[1][i]->mValue, results[0][i]->mValue);
+        }
+    }
+}
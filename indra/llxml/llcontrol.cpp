@@ -1001,6 +1001,8 @@ U32 LLControlGroup::loadFromFile(const std::string& filename, bool set_default_v
         return 0;
     }
 
+    // the values are kept for the whole session
+    LLSD::CompactStorage compact;
     if (LLSDParser::PARSE_FAILURE == LLSDSerialize::fromXML(settings, infile))
     {
         infile.close();
@@ -876,6 +876,149 @@ bool LLXMLNode::getLayeredXMLNode(LLXMLNodePtr& root,
     return true;
 }
 
+namespace
+{
+    template<typename T>
+    void write_binary(std::string& buffer, T value)
+    {
+        buffer.append((const char*)&value, sizeof(T));
+    }
+
+    void write_binary(std::string& buffer, const std::string& value)
+    {
+        write_binary(buffer, (U32)value.size());
+        buffer.append(value);
+    }
+
+    struct BinaryReader
+    {
+        const char* mPos;
+        const char* mEnd;
+
+        template<typename T>
+        bool read(T& value)
+        {
+            if (mEnd - mPos < (ptrdiff_t)sizeof(T))
+            {
+                return false;
+            }
+            memcpy(&value, mPos, sizeof(T));
+            mPos += sizeof(T);
+            return true;
+        }
+
+        bool read(std::string& value)
+        {
+            U32 size;
+            if (!read(size) || (size_t)(mEnd - mPos) < size)
+            {
+                return false;
+            }
+            value.assign(mPos, size);
+            mPos += size;
+            return true;
+        }
+    };
+
+    bool read_binary_node(BinaryReader& reader, LLXMLNodePtr& node, std::string& name)
+    {
+        U8 is_attribute;
+        if (!reader.read(name) || !reader.read(is_attribute))
+        {
+            return false;
+        }
+        node = new LLXMLNode(name.c_str(), is_attribute != 0);
+
+        S32 type;
+        S32 encoding;
+        S32 line_number;
+        std::string value;
+        if (!reader.read(node->mID)
+            || !reader.read(node->mVersionMajor)
+            || !reader.read(node->mVersionMinor)
+            || !reader.read(node->mLength)
+            || !reader.read(node->mPrecision)
+            || !reader.read(type)
+            || !reader.read(encoding)
+            || !reader.read(line_number)
+            || !reader.read(value))
+        {
+            return false;
+        }
+        node->setValue(value);
+        // setValue() turns containers into TYPE_UNKNOWN, restore what was written
+        node->mType = (LLXMLNode::ValueType)type;
+        node->mEncoding = (LLXMLNode::Encoding)encoding;
+        node->setLineNumber(line_number);
+
+        for (S32 list = 0; list < 2; ++list)
+        {
+            // attributes, then children
+            U32 count;
+            if (!reader.read(count))
+            {
+                return false;
+            }
+            for (U32 i = 0; i < count; ++i)
+            {
+                LLXMLNodePtr child;
+                if (!read_binary_node(reader, child, name))
+                {
+                    return false;
+                }
+                node->addChild(child);
+            }
+        }
+        return true;
+    }
+}
+
+void LLXMLNode::writeBinary(std::string& buffer)
+{
+    write_binary(buffer, std::string(mName ? mName->mString : ""));
+    write_binary(buffer, (U8)mIsAttribute);
+    write_binary(buffer, mID);
+    write_binary(buffer, mVersionMajor);
+    write_binary(buffer, mVersionMinor);
+    write_binary(buffer, mLength);
+    write_binary(buffer, mPrecision);
+    write_binary(buffer, (S32)mType);
+    write_binary(buffer, (S32)mEncoding);
+    write_binary(buffer, mLineNumber);
+    write_binary(buffer, mValue);
+
+    write_binary(buffer, (U32)mAttributes.size());
+    for (LLXMLAttribList::iterator iter = mAttributes.begin(); iter != mAttributes.end(); ++iter)
+    {
+        iter->second->writeBinary(buffer);
+    }
+
+    // children in document order, not the order of the name map
+    U32 num_children = 0;
+    for (LLXMLNodePtr child = getFirstChild(); child.notNull(); child = child->getNextSibling())
+    {
+        ++num_children;
+    }
+    write_binary(buffer, num_children);
+    for (LLXMLNodePtr child = getFirstChild(); child.notNull(); child = child->getNextSibling())
+    {
+        child->writeBinary(buffer);
+    }
+}
+
+// static
+bool LLXMLNode::readBinary(const char* buffer, size_t length, LLXMLNodePtr& node)
+{
+    BinaryReader reader{ buffer, buffer + length };
+    std::string name;
+    if (!read_binary_node(reader, node, name))
+    {
+        node = NULL;
+        return false;
+    }
+    return true;
+}
+
 // static
 void LLXMLNode::writeHeaderToFile(LLFILE *out_file)
 {
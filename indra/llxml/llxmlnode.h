@@ -150,6 +150,12 @@ public:
 
     static bool getLayeredXMLNode(LLXMLNodePtr& root, const std::vector<std::string>& paths);
 
+    // Compact binary form of this node and everything under it, for caching
+    // parsed files. Not portable between builds or machines, check a version.
+    void writeBinary(std::string& buffer);
+    // Rebuilds a tree written by writeBinary(), false if the data is cut short
+    static bool readBinary(const char* buffer, size_t length, LLXMLNodePtr& node);
+
 
     // Write standard XML file header:
     // <?xml version="1.0" encoding="utf-8" standalone="yes" ?>
@@ -0,0 +1,128 @@
+/**
+ * @file llxmlnode_test.cpp
+ * @brief LLXMLNode binary form unit tests
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llxmlnode.h"
+
+#include "../test/lltut.h"
+#include <sstream>
+
+namespace tut
+{
+    struct xmlnode_test
+    {
+        // something shaped like a floater: nested panels full of widgets
+        static std::string makeFloater(S32 num_panels, S32 widgets_per_panel)
+        {
+            std::ostringstream xml;
+            xml << "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\" ?>\n"
+                << "<floater name=\"test_floater\" title=\"Test &amp; more\" height=\"600\" width=\"400\">\n";
+            for (S32 p = 0; p < num_panels; ++p)
+            {
+                xml << "  <panel name=\"panel_" << p << "\" follows=\"all\" layout=\"topleft\" top=\"" << p * 20 << "\">\n";
+                for (S32 w = 0; w < widgets_per_panel; ++w)
+                {
+                    // same tag names interleaved, order matters to XUI
+                    if (w % 2)
+                    {
+                        xml << "    <check_box name=\"check_" << w << "\" label=\"Option " << w
+                            << "\" control_name=\"Setting" << w << "\" left=\"10\" top_pad=\"4\"/>\n";
+                    }
+                    else
+                    {
+                        xml << "    <text name=\"text_" << w << "\" font=\"SansSerifSmall\">Label text " << w << "</text>\n";
+                    }
+                }
+                xml << "  </panel>\n";
+            }
+            xml << "</floater>\n";
+            return xml.str();
+        }
+
+        static std::string toString(LLXMLNodePtr node)
+        {
+            std::ostringstream out;
+            node->writeToOstream(out);
+            return out.str();
+        }
+    };
+
+    typedef test_group<xmlnode_test> xmlnode_t;
+    typedef xmlnode_t::object xmlnode_object_t;
+    tut::xmlnode_t tut_xmlnode("LLXMLNode");
+
+    // binary round trip gives the same tree
+    template<> template<>
+    void xmlnode_object_t::test<1>()
+    {
+        std::string xml = makeFloater(3, 6);
+        LLXMLNodePtr parsed;
+        ensure("parsed", LLXMLNode::parseBuffer(xml.data(), xml.size(), parsed));
+
+        std::string binary;
+        parsed->writeBinary(binary);
+        LLXMLNodePtr loaded;
+        ensure("loaded", LLXMLNode::readBinary(binary.data(), binary.size(), loaded));
+        ensure_equals("same tree", toString(loaded), toString(parsed));
+
+        // children stay in document order
+        LLXMLNodePtr panel = loaded->getFirstChild();
+        ensure("has panel", panel.notNull());
+        LLXMLNodePtr first = panel->getFirstChild();
+        LLXMLNodePtr second = first->getNextSibling();
+        std::string name;
+        ensure("first name", first->getAttributeString("name", name));
+        ensure_equals("first widget", name, std::string("text_0"));
+        ensure("second name", second->getAttributeString("name", name));
+        ensure_equals("second widget", name, std::string("check_1"));
+        ensure_equals("text value", first->getValue(), std::string("Label text 0"));
+        ensure_equals("line number", first->getLineNumber(), 4);
+
+        std::string title;
+        ensure("title", loaded->getAttributeString("title", title));
+        ensure_equals("escaped title", title, std::string("Test & more"));
+    }
+
+    // cut short or empty data doesn't make a tree
+    template<> template<>
+    void xmlnode_object_t::test<2>()
+    {
+        std::string xml = makeFloater(1, 4);
+        LLXMLNodePtr parsed;
+        ensure("parsed", LLXMLNode::parseBuffer(xml.data(), xml.size(), parsed));
+        std::string binary;
+        parsed->writeBinary(binary);
+
+        LLXMLNodePtr loaded;
+        ensure("empty", !LLXMLNode::readBinary(binary.data(), 0, loaded));
+        ensure("no node", loaded.isNull());
+        for (size_t length : { (size_t)3, binary.size() / 2, binary.size() - 1 })
+        {
+            ensure("truncated", !LLXMLNode::readBinary(binary.data(), length, loaded));
+        }
+    }
+}
@@ -1520,7 +1520,7 @@ void LLAgentCamera::updateCamera()
         // SL-315
         gAgentAvatarp->mPelvisp->setPosition(gAgentAvatarp->mPelvisp->getPosition() + diff);
 
-        gAgentAvatarp->mRoot->updateWorldMatrixChildren();
+        gAgentAvatarp->updateSkeletonWorldMatrices();
 
         for (LLVOAvatar::attachment_map_t::iterator iter = gAgentAvatarp->mAttachmentPoints.begin();
              iter != gAgentAvatarp->mAttachmentPoints.end(); )
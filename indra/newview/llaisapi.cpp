@@ -33,12 +33,15 @@
 #include "llcallbacklist.h"
 #include "llinventorymodel.h"
 #include "llinventoryobserver.h"
+#include "llmemorystream.h"
 #include "llnotificationsutil.h"
+#include "llsdserialize.h"
 #include "llsdutil.h"
 #include "llviewerregion.h"
 #include "llvoavatar.h"
 #include "llvoavatarself.h"
 #include "llviewercontrol.h"
+#include "workqueue.h"
 
 ///----------------------------------------------------------------------------
 /// Classes for AISv3 support.
@@ -50,6 +53,10 @@ const std::string AISAPI::LIBRARY_CAP_NAME("LibraryAPIv3");
 const S32 AISAPI::HTTP_TIMEOUT = 180;
 
 std::list<AISAPI::ais_query_item_t> AISAPI::sPostponedQuery;
+AISAPI::ResponseInfo AISAPI::sLastResponse;
+
+static LLTrace::EventStatHandle<F64Milliseconds> sAISParseTime("ais_parse_time", "Worker thread time spent parsing an AIS fetch response");
+static LLTrace::EventStatHandle<F64Milliseconds> sAISApplyTime("ais_apply_time", "Main thread time spent applying an AIS response to the inventory model");
 
 const S32 MAX_SIMULTANEOUS_COROUTINES = 2048;
 
@@ -473,17 +480,7 @@ void AISAPI::FetchCategoryChildren(const LLUUID &catId, ITEM_TYPE type, bool rec
 
     url += "?depth=" + std::to_string(depth);
 
-    invokationFn_t getFn = boost::bind(
-        // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
-        static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string &, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
-        //----
-        // _1 -> httpAdapter
-        // _2 -> httpRequest
-        // _3 -> url
-        // _4 -> body
-        // _5 -> httpOptions
-        // _6 -> httpHeaders
-        (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
+    invokationFn_t getFn = getFetchFn();
 
     // get doesn't use body, can pass additional data
     LLSD body;
@@ -526,17 +523,7 @@ void AISAPI::FetchCategoryChildren(const std::string &identifier, bool recursive
 
     url += "?depth=" + std::to_string(depth);
 
-    invokationFn_t getFn = boost::bind(
-        // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
-        static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string &, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
-        //----
-        // _1 -> httpAdapter
-        // _2 -> httpRequest
-        // _3 -> url
-        // _4 -> body
-        // _5 -> httpOptions
-        // _6 -> httpHeaders
-        (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
+    invokationFn_t getFn = getFetchFn();
 
     // get doesn't use body, can pass additional data
     LLSD body;
@@ -577,17 +564,7 @@ void AISAPI::FetchCategoryCategories(const LLUUID &catId, ITEM_TYPE type, bool r
 
     url += "?depth=" + std::to_string(depth);
 
-    invokationFn_t getFn = boost::bind(
-        // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
-        static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string &, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
-        //----
-        // _1 -> httpAdapter
-        // _2 -> httpRequest
-        // _3 -> url
-        // _4 -> body
-        // _5 -> httpOptions
-        // _6 -> httpHeaders
-        (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
+    invokationFn_t getFn = getFetchFn();
 
     // get doesn't use body, can pass additional data
     LLSD body;
@@ -654,17 +631,7 @@ void AISAPI::FetchCategorySubset(const LLUUID& catId,
         LL_WARNS("Inventory") << "Request url is too long, url: " << url << LL_ENDL;
     }
 
-    invokationFn_t getFn = boost::bind(
-        // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
-        static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string&, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
-        //----
-        // _1 -> httpAdapter
-        // _2 -> httpRequest
-        // _3 -> url
-        // _4 -> body
-        // _5 -> httpOptions
-        // _6 -> httpHeaders
-        (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
+    invokationFn_t getFn = getFetchFn();
 
     // get doesn't use body, can pass additional data
     LLSD body;
@@ -691,17 +658,7 @@ void AISAPI::FetchCOF(completion_t callback)
     }
     std::string url = cap + std::string("/category/current/links");
 
-    invokationFn_t getFn = boost::bind(
-        // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
-        static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string&, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
-        //----
-        // _1 -> httpAdapter
-        // _2 -> httpRequest
-        // _3 -> url
-        // _4 -> body
-        // _5 -> httpOptions
-        // _6 -> httpHeaders
-        (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
+    invokationFn_t getFn = getFetchFn();
 
     LLSD body;
     // Only cof folder will be full, but cof can contain an outfit
@@ -782,6 +739,33 @@ void AISAPI::FetchOrphans(completion_t callback)
     EnqueueAISCommand("FetchOrphans" , proc);
 }
 
+/*static*/
+AISAPI::invokationFn_t AISAPI::getFetchFn()
+{
+    // Fetches can return megabytes of llsd. Leave the body raw so that
+    // InvokeAISCommandCoro() can parse it on a worker thread.
+    static LLCachedControl<bool> parse_off_thread(gSavedSettings, "AISParseFetchOffThread", true);
+    if (parse_off_thread)
+    {
+        return boost::bind(
+            // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
+            static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string &, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
+            (&LLCoreHttpUtil::HttpCoroutineAdapter::getRawAndSuspend), _1, _2, _3, _5, _6);
+    }
+
+    return boost::bind(
+        // Humans ignore next line.  It is just a cast to specify which LLCoreHttpUtil::HttpCoroutineAdapter routine overload.
+        static_cast<LLSD(LLCoreHttpUtil::HttpCoroutineAdapter::*)(LLCore::HttpRequest::ptr_t, const std::string &, LLCore::HttpOptions::ptr_t, LLCore::HttpHeaders::ptr_t)>
+        //----
+        // _1 -> httpAdapter
+        // _2 -> httpRequest
+        // _3 -> url
+        // _4 -> body
+        // _5 -> httpOptions
+        // _6 -> httpHeaders
+        (&LLCoreHttpUtil::HttpCoroutineAdapter::getAndSuspend), _1, _2, _3, _5, _6);
+}
+
 /*static*/
 void AISAPI::EnqueueAISCommand(const std::string &procName, LLCoprocedureManager::CoProcedure_t proc)
 {
@@ -833,7 +817,7 @@ void AISAPI::onIdle(void *userdata)
 }
 
 /*static*/
-void AISAPI::onUpdateReceived(const LLSD& update, COMMAND_TYPE type, const LLSD& request_body)
+U32 AISAPI::onUpdateReceived(const LLSD& update, COMMAND_TYPE type, const LLSD& request_body, const ais_record_list_t* records)
 {
     LLTimer timer;
     if ( (type == UPDATECATEGORY || type == UPDATEITEM)
@@ -842,9 +826,71 @@ void AISAPI::onUpdateReceived(const LLSD& update, COMMAND_TYPE type, const LLSD&
         dump_sequential_xml(gAgentAvatarp->getDebugName() + "_ais_update", update);
     }
 
-    AISUpdate ais_update(update, type, request_body);
-    ais_update.doUpdate(); // execute the updates in the appropriate order.
+    std::unique_ptr<AISUpdate> ais_update;
+    if (records)
+    {
+        ais_update = std::make_unique<AISUpdate>(update, *records, type, request_body);
+    }
+    else
+    {
+        ais_update = std::make_unique<AISUpdate>(update, type, request_body);
+    }
+    ais_update->doUpdate(); // execute the updates in the appropriate order.
+    record(sAISApplyTime, F64Seconds(ais_update->getActiveSeconds()));
     LL_DEBUGS("Inventory", "AIS3") << "Elapsed processing: " << timer.getElapsedTimeF32() << LL_ENDL;
+    return static_cast<U32>(ais_update->getObjectCount());
+}
+
+/*static*/
+bool AISAPI::parseRawResponse(LLSD& result, COMMAND_TYPE type, const LLSD& request_body, ais_record_list_t& records)
+{
+    const LLSD::Binary& raw = result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_RAW].asBinary();
+    S32 depth = AISUpdate::getFetchDepth(type, request_body);
+    LLSD update;
+    F64 parse_seconds = 0.0;
+    auto parse = [&raw, &update, &records, &parse_seconds, type, depth]()
+    {
+        LL_PROFILE_ZONE_NAMED("ais parse response");
+        LLTimer timer;
+        LLMemoryStream stream(raw.data(), static_cast<S32>(raw.size()));
+        // the update is applied and dropped as a whole
+        LLSD::CompactStorage compact;
+        if (LLSDParser::PARSE_FAILURE == LLSDSerialize::fromXML(update, stream, true)
+            || !update.isMap())
+        {
+            return false;
+        }
+        AISUpdate::flattenUpdate(update, type, depth, records);
+        parse_seconds = timer.getElapsedTimeF64();
+        return true;
+    };
+
+    bool parsed = false;
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (general_queue)
+    {
+        try
+        {
+            // suspends this coroutine, the main thread keeps running
+            parsed = general_queue->waitForResult(parse);
+        }
+        catch (const LL::WorkQueue::Closed&)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        parsed = parse();
+    }
+
+    if (parsed)
+    {
+        record(sAISParseTime, F64Seconds(parse_seconds));
+        update[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS] = result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS];
+        result = update;
+    }
+    return parsed;
 }
 
 /*static*/
@@ -873,10 +919,25 @@ void AISAPI::InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t ht
     LLSD httpResults;
     LLCore::HttpStatus status;
 
+    LLTimer request_timer;
     result = invoke(httpAdapter , httpRequest , url , body , httpOptions , httpHeaders);
+    F64 request_seconds = request_timer.getElapsedTimeF64();
     httpResults = result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS];
     status = LLCoreHttpUtil::HttpCoroutineAdapter::getStatusFromLLSD(httpResults);
 
+    // see getFetchFn()
+    ais_record_list_t records;
+    bool has_records = false;
+    if (status && result.has(LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS_RAW))
+    {
+        has_records = parseRawResponse(result, type, body, records);
+        if (!has_records)
+        {
+            LL_WARNS("Inventory") << "Failed to parse response, url: " << url << LL_ENDL;
+            result = LLSD();
+        }
+    }
+
     if (!status || !result.isMap())
     {
         if (!result.isMap())
@@ -948,10 +1009,15 @@ void AISAPI::InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t ht
     }
 
     LL_DEBUGS("Inventory", "AIS3") << "Result: " << result << LL_ENDL;
-    onUpdateReceived(result, type, body);
+    U32 objects = onUpdateReceived(result, type, body, has_records ? &records : NULL);
 
     if (callback && !callback.empty())
     {
+        // callbacks can't suspend, nothing overwrites this before they return
+        sLastResponse.mStatus = status ? HTTP_OK : status.getType();
+        sLastResponse.mObjects = objects;
+        sLastResponse.mSeconds = request_seconds;
+
         bool needs_callback = true;
         LLUUID id(LLUUID::null);
 
@@ -1014,6 +1080,7 @@ void AISAPI::InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t ht
             // UPDATEITEM doesn't expect an id
             callback(id);
         }
+        sLastResponse = ResponseInfo();
     }
 
 }
@@ -1021,24 +1088,56 @@ void AISAPI::InvokeAISCommandCoro(LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t ht
 //-------------------------------------------------------------------------
 AISUpdate::AISUpdate(const LLSD& update, AISAPI::COMMAND_TYPE type, const LLSD& request_body)
 : mType(type)
+, mActiveSeconds(0.0)
+{
+    mFetch = isFetch(type);
+    // parse update llsd into stuff to do or parse received items.
+    mFetchDepth = getFetchDepth(type, request_body);
+
+    mTimer.setTimerExpirySec(AIS_EXPIRY_SECONDS);
+    mTimer.start();
+    parseUpdate(update);
+}
+
+AISUpdate::AISUpdate(const LLSD& update, const ais_record_list_t& records, AISAPI::COMMAND_TYPE type, const LLSD& request_body)
+: mType(type)
+, mActiveSeconds(0.0)
+{
+    mFetch = isFetch(type);
+    mFetchDepth = getFetchDepth(type, request_body);
+
+    mTimer.setTimerExpirySec(AIS_EXPIRY_SECONDS);
+    mTimer.start();
+    clearParseResults();
+    parseMeta(update);
+    parseRecords(records);
+}
+
+//static
+bool AISUpdate::isFetch(AISAPI::COMMAND_TYPE type)
 {
-    mFetch = (type == AISAPI::FETCHITEM)
+    return (type == AISAPI::FETCHITEM)
         || (type == AISAPI::FETCHCATEGORYCHILDREN)
         || (type == AISAPI::FETCHCATEGORYCATEGORIES)
         || (type == AISAPI::FETCHCATEGORYSUBSET)
         || (type == AISAPI::FETCHCOF)
         || (type == AISAPI::FETCHCATEGORYLINKS)
         || (type == AISAPI::FETCHORPHANS);
-    // parse update llsd into stuff to do or parse received items.
-    mFetchDepth = MAX_FOLDER_DEPTH_REQUEST;
-    if (mFetch && request_body.has("depth"))
+}
+
+//static
+S32 AISUpdate::getFetchDepth(AISAPI::COMMAND_TYPE type, const LLSD& request_body)
+{
+    if (isFetch(type) && request_body.has("depth"))
     {
-        mFetchDepth = request_body["depth"].asInteger();
+        return request_body["depth"].asInteger();
     }
+    return MAX_FOLDER_DEPTH_REQUEST;
+}
 
-    mTimer.setTimerExpirySec(AIS_EXPIRY_SECONDS);
-    mTimer.start();
-    parseUpdate(update);
+size_t AISUpdate::getObjectCount() const
+{
+    return mItemsCreated.size() + mItemsUpdated.size() + mCategoriesCreated.size() + mCategoriesUpdated.size();
 }
 
 void AISUpdate::clearParseResults()
@@ -1060,8 +1159,10 @@ void AISUpdate::checkTimeout()
 {
     if (mTimer.hasExpired())
     {
+        mActiveSeconds += mTimer.getElapsedTimeF64();
         llcoro::suspend();
         LLCoros::checkStop();
+        mTimer.reset();
         mTimer.setTimerExpirySec(AIS_EXPIRY_SECONDS);
     }
 }
@@ -1300,6 +1401,29 @@ void AISUpdate::parseLink(const LLSD& link_map, S32 depth)
 
 
 void AISUpdate::parseCategory(const LLSD& category_map, S32 depth)
+{
+    S32 categories = -1;
+    S32 links = -1;
+    S32 items = -1;
+    if (category_map.has("_embedded"))
+    {
+        countEmbedded(category_map["_embedded"], categories, links, items);
+    }
+
+    if (!parseCategory(category_map, depth, categories, links, items))
+    {
+        return;
+    }
+
+    // Check for more embedded content.
+    if (category_map.has("_embedded"))
+    {
+        parseEmbedded(category_map["_embedded"], depth - 1);
+    }
+}
+
+// Returns false for a stale folder, whose content should be skipped too
+bool AISUpdate::parseCategory(const LLSD& category_map, S32 depth, S32 categories, S32 links, S32 items)
 {
     LLUUID category_id = category_map["category_id"].asUUID();
     S32 version = LLViewerInventoryCategory::VERSION_UNKNOWN;
@@ -1319,7 +1443,7 @@ void AISUpdate::parseCategory(const LLSD& category_map, S32 depth)
     {
         LL_WARNS() << "Got stale folder, known: " << curr_cat->getVersion()
             << ", received: " << version << LL_ENDL;
-        return;
+        return false;
     }
 
     LLPointer<LLViewerInventoryCategory> new_cat;
@@ -1346,10 +1470,7 @@ void AISUpdate::parseCategory(const LLSD& category_map, S32 depth)
     {
         // Check descendent count first, as it may be needed
         // to populate newly created categories
-        if (category_map.has("_embedded"))
-        {
-            parseDescendentCount(category_id, new_cat->getPreferredType(), category_map["_embedded"]);
-        }
+        parseDescendentCount(category_id, new_cat->getPreferredType(), categories, links, items);
 
         if (mFetch)
         {
@@ -1430,29 +1551,31 @@ void AISUpdate::parseCategory(const LLSD& category_map, S32 depth)
         // *TODO: Wow, harsh.  Should we just complain and get out?
         LL_ERRS() << "unpack failed" << LL_ENDL;
     }
+    return true;
+}
 
-    // Check for more embedded content.
-    if (category_map.has("_embedded"))
-    {
-        parseEmbedded(category_map["_embedded"], depth - 1);
-    }
+//static
+void AISUpdate::countEmbedded(const LLSD& embedded, S32& categories, S32& links, S32& items)
+{
+    categories = embedded.has("categories") ? embedded["categories"].size() : -1;
+    links = embedded.has("links") ? embedded["links"].size() : -1;
+    items = embedded.has("items") ? embedded["items"].size() : -1;
 }
 
-void AISUpdate::parseDescendentCount(const LLUUID& category_id, LLFolderType::EType type, const LLSD& embedded)
+// categories, links and items are the sizes of the folder's _embedded lists, -1 if missing
+void AISUpdate::parseDescendentCount(const LLUUID& category_id, LLFolderType::EType type, S32 categories, S32 links, S32 items)
 {
     // We can only determine true descendent count if this contains all descendent types.
-    if (embedded.has("categories") &&
-        embedded.has("links") &&
-        embedded.has("items"))
+    if (categories >= 0 &&
+        links >= 0 &&
+        items >= 0)
     {
-        mCatDescendentsKnown[category_id] = embedded["categories"].size();
-        mCatDescendentsKnown[category_id] += embedded["links"].size();
-        mCatDescendentsKnown[category_id] += embedded["items"].size();
+        mCatDescendentsKnown[category_id] = categories + links + items;
     }
-    else if (mFetch && embedded.has("links") && (type == LLFolderType::FT_CURRENT_OUTFIT || type == LLFolderType::FT_OUTFIT))
+    else if (mFetch && links >= 0 && (type == LLFolderType::FT_CURRENT_OUTFIT || type == LLFolderType::FT_OUTFIT))
     {
         // COF and outfits contain links only
-        mCatDescendentsKnown[category_id] = embedded["links"].size();
+        mCatDescendentsKnown[category_id] = links;
     }
 }
 
@@ -1578,6 +1701,140 @@ void AISUpdate::parseEmbeddedCategories(const LLSD& categories, S32 depth)
     }
 }
 
+//static
+void AISUpdate::flattenUpdate(LLSD& update, AISAPI::COMMAND_TYPE type, S32 depth, ais_record_list_t& records)
+{
+    // same walk as parseContent()
+    if (update.has("linked_id") && update.has("parent_id"))
+    {
+        flattenObject(update, AISFetchRecord::LINK, depth, records);
+    }
+    else if (update.has("item_id") && update.has("parent_id"))
+    {
+        flattenObject(update, AISFetchRecord::ITEM, depth, records);
+    }
+
+    if (type == AISAPI::FETCHCATEGORYSUBSET)
+    {
+        // initial category is incomplete, go for content instead
+        if (update.has("_embedded"))
+        {
+            LLSD embedded = update["_embedded"];
+            update.erase("_embedded");
+            flattenEmbedded(embedded, depth - 1, records);
+        }
+    }
+    else if (update.has("category_id") && update.has("parent_id"))
+    {
+        flattenObject(update, AISFetchRecord::CATEGORY, depth, records);
+    }
+    else if (update.has("_embedded"))
+    {
+        LLSD embedded = update["_embedded"];
+        update.erase("_embedded");
+        flattenEmbedded(embedded, depth, records);
+    }
+}
+
+//static
+void AISUpdate::flattenEmbedded(LLSD& embedded, S32 depth, ais_record_list_t& records)
+{
+    // same order as parseEmbedded()
+    if (embedded.has("links"))
+    {
+        LLSD& links = embedded["links"];
+        for (LLSD::map_iterator it = links.beginMap(); it != links.endMap(); ++it)
+        {
+            flattenObject(it->second, AISFetchRecord::LINK, depth, records);
+        }
+    }
+    if (embedded.has("items"))
+    {
+        LLSD& items = embedded["items"];
+        for (LLSD::map_iterator it = items.beginMap(); it != items.endMap(); ++it)
+        {
+            flattenObject(it->second, AISFetchRecord::ITEM, depth, records);
+        }
+    }
+    if (embedded.has("item") && embedded["item"].has("item_id"))
+    {
+        flattenObject(embedded["item"], AISFetchRecord::ITEM, depth, records);
+    }
+    if (embedded.has("categories"))
+    {
+        LLSD& categories = embedded["categories"];
+        for (LLSD::map_iterator it = categories.beginMap(); it != categories.endMap(); ++it)
+        {
+            flattenObject(it->second, AISFetchRecord::CATEGORY, depth, records);
+        }
+    }
+    if (embedded.has("category") && embedded["category"].has("category_id"))
+    {
+        flattenObject(embedded["category"], AISFetchRecord::CATEGORY, depth, records);
+    }
+}
+
+//static
+void AISUpdate::flattenObject(LLSD& object, AISFetchRecord::EKind kind, S32 depth, ais_record_list_t& records)
+{
+    size_t index = records.size();
+    records.emplace_back();
+    records[index].mKind = kind;
+    records[index].mDepth = depth;
+
+    // items don't look at their _embedded content
+    LLSD embedded;
+    if (kind != AISFetchRecord::ITEM && object.has("_embedded"))
+    {
+        embedded = object["_embedded"];
+        object.erase("_embedded");
+        if (kind == AISFetchRecord::CATEGORY)
+        {
+            countEmbedded(embedded, records[index].mCategories, records[index].mLinks, records[index].mItems);
+        }
+    }
+    records[index].mData = object;
+
+    if (embedded.isDefined())
+    {
+        flattenEmbedded(embedded, kind == AISFetchRecord::CATEGORY ? depth - 1 : depth, records);
+    }
+    records[index].mSubtreeEnd = records.size();
+}
+
+void AISUpdate::parseRecords(const ais_record_list_t& records)
+{
+    size_t i = 0;
+    while (i < records.size())
+    {
+        checkTimeout();
+
+        const AISFetchRecord& record = records[i];
+        switch (record.mKind)
+        {
+        case AISFetchRecord::ITEM:
+            parseItem(record.mData);
+            ++i;
+            break;
+        case AISFetchRecord::LINK:
+            parseLink(record.mData, record.mDepth);
+            ++i;
+            break;
+        case AISFetchRecord::CATEGORY:
+            if (parseCategory(record.mData, record.mDepth, record.mCategories, record.mLinks, record.mItems))
+            {
+                ++i;
+            }
+            else
+            {
+                // stale folder, skip its content like parseCategory() does
+                i = record.mSubtreeEnd;
+            }
+            break;
+        }
+    }
+}
+
 void AISUpdate::doUpdate()
 {
     checkTimeout();
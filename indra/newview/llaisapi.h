@@ -31,10 +31,33 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 #include "llviewerinventory.h"
 #include "llcorehttputil.h"
 #include "llcoproceduremanager.h"
 
+// An inventory object from an AIS fetch response with its "_embedded"
+// content split off, see AISUpdate::flattenUpdate()
+struct AISFetchRecord
+{
+    typedef enum {
+        ITEM,
+        LINK,
+        CATEGORY
+    } EKind;
+
+    EKind   mKind;
+    S32     mDepth;
+    LLSD    mData;
+    // sizes of the "_embedded" lists, -1 if a list was missing
+    S32     mCategories = -1;
+    S32     mLinks = -1;
+    S32     mItems = -1;
+    // index past the records for this object's "_embedded" content
+    size_t  mSubtreeEnd = 0;
+};
+typedef std::vector<AISFetchRecord> ais_record_list_t;
+
 class AISAPI
 {
 public:
@@ -85,6 +108,17 @@ public:
         FETCHCATEGORYLINKS
     } COMMAND_TYPE;
 
+    // What the request behind the current completion callback got back:
+    // HTTP status, inventory objects received and round trip time.
+    // Only valid inside the callback.
+    struct ResponseInfo
+    {
+        S32 mStatus = 0;
+        U32 mObjects = 0;
+        F64 mSeconds = 0.0;
+    };
+    static const ResponseInfo& getLastResponse() { return sLastResponse; }
+
 private:
     static const std::string INVENTORY_CAP_NAME;
     static const std::string LIBRARY_CAP_NAME;
@@ -94,7 +128,10 @@ private:
 
     static void EnqueueAISCommand(const std::string &procName, LLCoprocedureManager::CoProcedure_t proc);
     static void onIdle(void *userdata); // launches postponed AIS commands
-    static void onUpdateReceived(const LLSD& update, COMMAND_TYPE type, const LLSD& request_body);
+    // returns the number of inventory objects created or updated
+    static U32 onUpdateReceived(const LLSD& update, COMMAND_TYPE type, const LLSD& request_body, const ais_record_list_t* records = NULL);
+    static bool parseRawResponse(LLSD& result, COMMAND_TYPE type, const LLSD& request_body, ais_record_list_t& records);
+    static invokationFn_t getFetchFn();
 
     static std::string getInvCap();
     static std::string getLibCap();
@@ -105,20 +142,33 @@ private:
 
     typedef std::pair<std::string, LLCoprocedureManager::CoProcedure_t> ais_query_item_t;
     static std::list<ais_query_item_t> sPostponedQuery;
+    static ResponseInfo sLastResponse;
 };
 
 class AISUpdate
 {
 public:
     AISUpdate(const LLSD& update, AISAPI::COMMAND_TYPE type, const LLSD& request_body);
+    // Content comes from records made by flattenUpdate(), update only
+    // supplies the metadata.
+    AISUpdate(const LLSD& update, const ais_record_list_t& records, AISAPI::COMMAND_TYPE type, const LLSD& request_body);
+
+    // Moves the content of a fetch response into records, in the order
+    // parseContent() would visit it. Doesn't look at gInventory, so it can
+    // run off the main thread.
+    static void flattenUpdate(LLSD& update, AISAPI::COMMAND_TYPE type, S32 depth, ais_record_list_t& records);
+    static S32 getFetchDepth(AISAPI::COMMAND_TYPE type, const LLSD& request_body);
+
     void parseUpdate(const LLSD& update);
+    void parseRecords(const ais_record_list_t& records);
     void parseMeta(const LLSD& update);
     void parseContent(const LLSD& update);
     void parseUUIDArray(const LLSD& content, const std::string& name, uuid_list_t& ids);
     void parseLink(const LLSD& link_map, S32 depth);
     void parseItem(const LLSD& link_map);
     void parseCategory(const LLSD& link_map, S32 depth);
-    void parseDescendentCount(const LLUUID& category_id, LLFolderType::EType type, const LLSD& embedded);
+    bool parseCategory(const LLSD& category_map, S32 depth, S32 categories, S32 links, S32 items);
+    void parseDescendentCount(const LLUUID& category_id, LLFolderType::EType type, S32 categories, S32 links, S32 items);
     void parseEmbedded(const LLSD& embedded, S32 depth);
     void parseEmbeddedLinks(const LLSD& links, S32 depth);
     void parseEmbeddedItems(const LLSD& items);
@@ -126,7 +176,16 @@ public:
     void parseEmbeddedItem(const LLSD& item);
     void parseEmbeddedCategory(const LLSD& category, S32 depth);
     void doUpdate();
+    // main thread time spent parsing and applying, not counting suspensions
+    F64 getActiveSeconds() const { return mActiveSeconds + mTimer.getElapsedTimeF64(); }
+    // items and categories created or updated
+    size_t getObjectCount() const;
 private:
+    static bool isFetch(AISAPI::COMMAND_TYPE type);
+    static void countEmbedded(const LLSD& embedded, S32& categories, S32& links, S32& items);
+    static void flattenEmbedded(LLSD& embedded, S32 depth, ais_record_list_t& records);
+    static void flattenObject(LLSD& object, AISFetchRecord::EKind kind, S32 depth, ais_record_list_t& records);
+
     void clearParseResults();
     void checkTimeout();
 
@@ -155,6 +214,7 @@ private:
     bool mFetch;
     S32 mFetchDepth;
     LLTimer mTimer;
+    F64 mActiveSeconds;
     AISAPI::COMMAND_TYPE mType;
 };
 
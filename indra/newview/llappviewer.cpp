@@ -37,6 +37,7 @@
 #include "llerrorcontrol.h"
 #include "lleventtimer.h"
 #include "llfile.h"
+#include "llframearena.h"
 #include "llviewertexturelist.h"
 #include "llgroupmgr.h"
 #include "llagent.h"
@@ -776,6 +777,8 @@ bool LLAppViewer::init()
     //set the max heap size.
     initMaxHeapSize() ;
     LLCoros::instance().setStackSize(gSavedSettings.getS32("CoroutineStackSize"));
+    // too late for the settings files initConfiguration() just loaded
+    LLSD::CompactStorage::setEnabled(gSavedSettings.getBOOL("LLSDCompactStorage"));
 
     // Although initLoggingAndGetLastDuration() is the right place to mess with
     // setFatalFunction(), we can't query gSavedSettings until after
@@ -1520,6 +1523,9 @@ bool LLAppViewer::doFrame()
                     gGLActive = false;
                 }
 
+                // per-frame render allocations from two frames ago are dead now
+                LLFrameArena::endFrame();
+
                 if (LLViewerStatsRecorder::instanceExists())
                 {
                     LLViewerStatsRecorder::instance().idle();
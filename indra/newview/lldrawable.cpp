@@ -874,6 +874,16 @@ void LLDrawable::updateDistance(LLCamera& camera, bool force_update)
         return;
     }
 
+    calcDistance(camera, force_update);
+
+    if (mVObjp)
+    {
+        mVObjp->updateLOD();
+    }
+}
+
+void LLDrawable::calcDistance(LLCamera& camera, bool force_update)
+{
     //switch LOD with the spatial group to avoid artifacts
     //LLSpatialGroup* sg = getSpatialGroup();
 
@@ -925,10 +935,6 @@ void LLDrawable::updateDistance(LLCamera& camera, bool force_update)
                 LLVector3 cam_pos_from_agent = LLViewerCamera::getInstance()->getOrigin();
                 LLVector3 cam_to_box_offset = point_to_box_offset(cam_pos_from_agent, av_box);
                 mDistanceWRTCamera = llmax(0.01f, ll_round(cam_to_box_offset.magVec(), 0.01f));
-                if (mVObjp)
-                {
-                    mVObjp->updateLOD();
-                }
                 return;
             }
         }
@@ -939,10 +945,6 @@ void LLDrawable::updateDistance(LLCamera& camera, bool force_update)
 
         pos -= camera.getOrigin();
         mDistanceWRTCamera = ll_round(pos.magVec(), 0.01f);
-        if (mVObjp)
-        {
-            mVObjp->updateLOD();
-        }
     }
 }
 
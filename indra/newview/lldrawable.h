@@ -166,6 +166,8 @@ public:
     void updateTexture();
     void updateMaterial();
     virtual void updateDistance(LLCamera& camera, bool force_update);
+    // the distance part of updateDistance(), without the LOD update, safe to run on worker threads
+    void calcDistance(LLCamera& camera, bool force_update);
     bool updateGeometry();
     void updateFaceSize(S32 idx);
 
@@ -428,6 +428,64 @@ void LLRenderPass::renderRiggedGroup(LLSpatialGroup* group, U32 type, bool textu
     }
 }
 
+// true if next can be drawn in the same call as params, i.e. they only differ in their index range
+static bool can_draw_together(const LLDrawInfo& params, const LLDrawInfo& next, bool batch_textures)
+{
+    return next.mCount
+        && params.mVertexBuffer == next.mVertexBuffer
+        && params.mModelMatrix == next.mModelMatrix
+        && !params.mTextureMatrix && !next.mTextureMatrix
+        && params.mTexture == next.mTexture
+        && params.mGLTFMaterial == next.mGLTFMaterial
+        && params.mAlphaMaskCutoff == next.mAlphaMaskCutoff
+        && (!batch_textures || params.mTextureList == next.mTextureList);
+}
+
+// draw params' index range, or ranges if not null
+static void draw_batch(LLDrawInfo& params, LLRenderPass::DrawRanges* ranges)
+{
+    if (ranges)
+    {
+        params.mVertexBuffer->drawRanges(LLRender::TRIANGLES, ranges->mStart, ranges->mEnd,
+                                         ranges->mCounts.data(), ranges->mOffsets.data(), (U32)ranges->mCounts.size());
+    }
+    else
+    {
+        params.mVertexBuffer->drawRange(LLRender::TRIANGLES, params.mStart, params.mEnd, params.mCount, params.mOffset);
+    }
+}
+
+// static
+LLRenderPass::DrawRanges* LLRenderPass::gatherDrawRanges(LLDrawInfo& params, LLDrawInfo**& i, LLDrawInfo** end,
+                                                         bool batch_textures)
+{
+    if (LLVertexBuffer::sMultiDrawMode == LLVertexBuffer::MULTI_DRAW_OFF ||
+        !params.mCount ||
+        i == end ||
+        !can_draw_together(params, **i, batch_textures))
+    {
+        return nullptr;
+    }
+
+    static DrawRanges ranges;
+    ranges.mCounts.assign(1, params.mCount);
+    ranges.mOffsets.assign(1, params.mOffset);
+    ranges.mStart = params.mStart;
+    ranges.mEnd = params.mEnd;
+
+    while (i != end && can_draw_together(params, **i, batch_textures))
+    {
+        LLDrawInfo& next = **i;
+        ranges.mCounts.push_back(next.mCount);
+        ranges.mOffsets.push_back(next.mOffset);
+        ranges.mStart = llmin(ranges.mStart, (U32)next.mStart);
+        ranges.mEnd = llmax(ranges.mEnd, (U32)next.mEnd);
+        LLCullResult::increment_iterator(i, end);
+    }
+
+    return &ranges;
+}
+
 void LLRenderPass::pushBatches(U32 type, bool texture, bool batch_textures)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_DRAWPOOL;
@@ -440,7 +498,7 @@ void LLRenderPass::pushBatches(U32 type, bool texture, bool batch_textures)
             LLDrawInfo* pparams = *i;
             LLCullResult::increment_iterator(i, end);
 
-            pushBatch(*pparams, texture, batch_textures);
+            pushBatch(*pparams, texture, batch_textures, gatherDrawRanges(*pparams, i, end, batch_textures));
         }
     }
     else
@@ -459,7 +517,7 @@ void LLRenderPass::pushUntexturedBatches(U32 type)
         LLDrawInfo* pparams = *i;
         LLCullResult::increment_iterator(i, end);
 
-        pushUntexturedBatch(*pparams);
+        pushUntexturedBatch(*pparams, gatherDrawRanges(*pparams, i, end));
     }
 }
 
@@ -521,7 +579,7 @@ void LLRenderPass::pushMaskBatches(U32 type, bool texture, bool batch_textures)
         LLDrawInfo* pparams = *i;
         LLCullResult::increment_iterator(i, end);
         LLGLSLShader::sCurBoundShaderPtr->setMinimumAlpha(pparams->mAlphaMaskCutoff);
-        pushBatch(*pparams, texture, batch_textures);
+        pushBatch(*pparams, texture, batch_textures, gatherDrawRanges(*pparams, i, end, batch_textures));
     }
 }
 
@@ -570,7 +628,7 @@ void LLRenderPass::applyModelMatrix(const LLMatrix4* model_matrix)
     }
 }
 
-void LLRenderPass::pushBatch(LLDrawInfo& params, bool texture, bool batch_textures)
+void LLRenderPass::pushBatch(LLDrawInfo& params, bool texture, bool batch_textures, DrawRanges* ranges)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_DRAWPOOL;
     llassert(texture);
@@ -617,7 +675,7 @@ void LLRenderPass::pushBatch(LLDrawInfo& params, bool texture, bool batch_textur
     }
 
     params.mVertexBuffer->setBuffer();
-    params.mVertexBuffer->drawRange(LLRender::TRIANGLES, params.mStart, params.mEnd, params.mCount, params.mOffset);
+    draw_batch(params, ranges);
 
     if (tex_setup)
     {
@@ -627,7 +685,7 @@ void LLRenderPass::pushBatch(LLDrawInfo& params, bool texture, bool batch_textur
     }
 }
 
-void LLRenderPass::pushUntexturedBatch(LLDrawInfo& params)
+void LLRenderPass::pushUntexturedBatch(LLDrawInfo& params, DrawRanges* ranges)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_DRAWPOOL;
 
@@ -639,7 +697,7 @@ void LLRenderPass::pushUntexturedBatch(LLDrawInfo& params)
     applyModelMatrix(params);
 
     params.mVertexBuffer->setBuffer();
-    params.mVertexBuffer->drawRange(LLRender::TRIANGLES, params.mStart, params.mEnd, params.mCount, params.mOffset);
+    draw_batch(params, ranges);
 }
 
 // static
@@ -794,7 +852,7 @@ void LLRenderPass::pushGLTFBatches(U32 type)
         LLDrawInfo& params = **i;
         LLCullResult::increment_iterator(i, end);
 
-        pushGLTFBatch(params);
+        pushGLTFBatch(params, gatherDrawRanges(params, i, end));
     }
 }
 
@@ -809,12 +867,12 @@ void LLRenderPass::pushUntexturedGLTFBatches(U32 type)
         LLDrawInfo& params = **i;
         LLCullResult::increment_iterator(i, end);
 
-        pushUntexturedGLTFBatch(params);
+        pushUntexturedGLTFBatch(params, gatherDrawRanges(params, i, end));
     }
 }
 
 // static
-void LLRenderPass::pushGLTFBatch(LLDrawInfo& params)
+void LLRenderPass::pushGLTFBatch(LLDrawInfo& params, DrawRanges* ranges)
 {
     auto& mat = params.mGLTFMaterial;
 
@@ -830,13 +888,13 @@ void LLRenderPass::pushGLTFBatch(LLDrawInfo& params)
     applyModelMatrix(params);
 
     params.mVertexBuffer->setBuffer();
-    params.mVertexBuffer->drawRange(LLRender::TRIANGLES, params.mStart, params.mEnd, params.mCount, params.mOffset);
+    draw_batch(params, ranges);
 
     teardown_texture_matrix(params);
 }
 
 // static
-void LLRenderPass::pushUntexturedGLTFBatch(LLDrawInfo& params)
+void LLRenderPass::pushUntexturedGLTFBatch(LLDrawInfo& params, DrawRanges* ranges)
 {
     auto& mat = params.mGLTFMaterial;
 
@@ -845,7 +903,7 @@ void LLRenderPass::pushUntexturedGLTFBatch(LLDrawInfo& params)
     applyModelMatrix(params);
 
     params.mVertexBuffer->setBuffer();
-    params.mVertexBuffer->drawRange(LLRender::TRIANGLES, params.mStart, params.mEnd, params.mCount, params.mOffset);
+    draw_batch(params, ranges);
 }
 
 void LLRenderPass::pushRiggedGLTFBatches(U32 type, bool textured)
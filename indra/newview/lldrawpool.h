@@ -350,6 +350,21 @@ public:
     bool isDead() { return false; }
     void resetDrawOrders() { }
 
+    // Index ranges of consecutive draw infos that are drawn together, see gatherDrawRanges()
+    struct DrawRanges
+    {
+        std::vector<U32> mCounts;
+        std::vector<U32> mOffsets;
+        U32 mStart = 0;
+        U32 mEnd = 0;
+    };
+
+    // If RenderMultiDrawBatches is set and the draw infos at i only differ from params in their
+    // index range, collect params and those into the returned ranges and move i past them.
+    // Returns nullptr when params has to be drawn on its own.
+    static DrawRanges* gatherDrawRanges(LLDrawInfo& params, LLDrawInfo**& i, LLDrawInfo** end,
+                                        bool batch_textures = false);
+
     static void applyModelMatrix(const LLDrawInfo& params);
     // For rendering that doesn't use LLDrawInfo for some reason
     static void applyModelMatrix(const LLMatrix4* model_matrix);
@@ -375,16 +390,16 @@ public:
     void pushRiggedGLTFBatches(U32 type, bool textured);
     void pushUntexturedRiggedGLTFBatches(U32 type);
 
-    // push a single GLTF draw call
-    static void pushGLTFBatch(LLDrawInfo& params);
+    // push a single GLTF draw call, drawing ranges instead of params' own range if not null
+    static void pushGLTFBatch(LLDrawInfo& params, DrawRanges* ranges = nullptr);
     static void pushRiggedGLTFBatch(LLDrawInfo& params, const LLVOAvatar*& lastAvatar, U64& lastMeshId, bool& skipLastSkin);
-    static void pushUntexturedGLTFBatch(LLDrawInfo& params);
+    static void pushUntexturedGLTFBatch(LLDrawInfo& params, DrawRanges* ranges = nullptr);
     static void pushUntexturedRiggedGLTFBatch(LLDrawInfo& params, const LLVOAvatar*& lastAvatar, U64& lastMeshId, bool& skipLastSkin);
 
     void pushMaskBatches(U32 type, bool texture = true, bool batch_textures = false);
     void pushRiggedMaskBatches(U32 type, bool texture = true, bool batch_textures = false);
-    void pushBatch(LLDrawInfo& params, bool texture, bool batch_textures = false);
-    void pushUntexturedBatch(LLDrawInfo& params);
+    void pushBatch(LLDrawInfo& params, bool texture, bool batch_textures = false, DrawRanges* ranges = nullptr);
+    void pushUntexturedBatch(LLDrawInfo& params, DrawRanges* ranges = nullptr);
     void pushBumpBatch(LLDrawInfo& params, bool texture, bool batch_textures = false);
     static bool uploadMatrixPalette(LLDrawInfo& params);
     static bool uploadMatrixPalette(LLVOAvatar* avatar, LLMeshSkinInfo* skinInfo);
@@ -57,6 +57,7 @@
 #include "llsculptidsize.h"
 #include "llmeshrepository.h"
 #include "llskinningutil.h"
+#include "parallelfor.h"
 
 #if LL_LINUX
 // Work-around spurious used before init warning on Vector4a
@@ -1144,6 +1145,38 @@ void push_for_transform(LLVertexBuffer* buff, U32 source_count, U32 dest_count)
     }
 }
 
+bool LLFace::prepareGeometryOffThread()
+{
+    if (mDrawablep->isState(LLDrawable::ANIMATED_CHILD))
+    { // needs a temporary relative transform on the object
+        return false;
+    }
+
+    const LLTextureEntry* tep = getTextureEntry();
+    if (!tep || mVertexBuffer.isNull())
+    {
+        return false;
+    }
+
+    if (mVertexBufferGLTF.notNull() || (tep->isSelected() && tep->getGLTFRenderMaterial()))
+    { // creates, flushes or frees mVertexBufferGLTF
+        return false;
+    }
+
+    LLVolume* volume = mVObjp->getVolume();
+    S32 face_index = getTEOffset();
+    if (volume && face_index >= 0 && face_index < volume->getNumVolumeFaces() &&
+        !volume->getVolumeFace(face_index).mTangents &&
+        (tep->getBumpmap() ||
+         tep->getTexGen() != LLTextureEntry::TEX_GEN_DEFAULT ||
+         mVertexBuffer->hasDataType(LLVertexBuffer::TYPE_TANGENT)))
+    { // same tangents getGeometryVolume() would generate
+        volume->genTangents(face_index);
+    }
+
+    return true;
+}
+
 bool LLFace::getGeometryVolume(const LLVolume& volume,
                                 S32 face_index,
                                 const LLMatrix4& mat_vert_in,
@@ -2194,14 +2227,22 @@ F32 LLFace::getTextureVirtualSize()
     return face_area;
 }
 
+// this is an expensive operation and the result is valid (enough) for several frames
+// don't update every frame
+constexpr F32 PIXEL_AREA_UPDATE_PERIOD = 0.1f;
+
+bool LLFace::isPixelAreaFresh() const
+{
+    return gFrameTimeSeconds - mLastPixelAreaUpdate < PIXEL_AREA_UPDATE_PERIOD;
+}
+
 bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
 {
-    constexpr F32 PIXEL_AREA_UPDATE_PERIOD = 0.1f;
-    // this is an expensive operation and the result is valid (enough) for several frames
-    // don't update every frame
-    if (gFrameTimeSeconds - mLastPixelAreaUpdate < PIXEL_AREA_UPDATE_PERIOD)
+    if (isPixelAreaFresh())
     {
-        return true;
+        cos_angle_to_view_dir = mCosAngleToViewDir;
+        radius = mPixelRadius;
+        return mPixelAreaInFrustum;
     }
 
     LL_PROFILE_ZONE_SCOPED_CATEGORY_FACE;
@@ -2210,6 +2251,39 @@ bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
     LLVector4a center;
     LLVector4a size;
 
+    if (!getPixelAreaBounds(center, size))
+    {
+        return false;
+    }
+
+    LLViewerCamera* camera = LLViewerCamera::getInstance();
+
+    F32 size_squared = size.dot3(size).getF32();
+    LLVector4a lookAt;
+    LLVector4a t;
+    t.load3(camera->getOrigin().mV);
+    lookAt.setSub(center, t);
+
+    F32 dist = lookAt.getLength3().getF32();
+    dist = llmax(dist-size.getLength3().getF32(), 0.001f);
+
+    lookAt.normalize3fast() ;
+
+    //get area of circle around node
+    F32 app_angle = atanf((F32) sqrt(size_squared) / dist);
+    radius = app_angle*LLDrawable::sCurPixelAngle;
+
+    LLVector4a x_axis;
+    x_axis.load3(camera->getXAxis().mV);
+    cos_angle_to_view_dir = lookAt.dot3(x_axis).getF32();
+
+    bool in_frustum = setPixelAreaResult(center, size, dist, radius, cos_angle_to_view_dir);
+    cos_angle_to_view_dir = mCosAngleToViewDir;
+    return in_frustum;
+}
+
+bool LLFace::getPixelAreaBounds(LLVector4a& center, LLVector4a& size)
+{
     if (isState(LLFace::RIGGED))
     {
         LL_PROFILE_ZONE_NAMED_CATEGORY_FACE("calcPixelArea - rigged");
@@ -2294,30 +2368,32 @@ bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
     }
     size.mul(0.5f);
 
-    LLViewerCamera* camera = LLViewerCamera::getInstance();
-
-    F32 size_squared = size.dot3(size).getF32();
-    LLVector4a lookAt;
-    LLVector4a t;
-    t.load3(camera->getOrigin().mV);
-    lookAt.setSub(center, t);
-
-    F32 dist = lookAt.getLength3().getF32();
-    dist = llmax(dist-size.getLength3().getF32(), 0.001f);
-
-    lookAt.normalize3fast() ;
+    return true;
+}
 
-    //get area of circle around node
-    F32 app_angle = atanf((F32) sqrt(size_squared) / dist);
-    radius = app_angle*LLDrawable::sCurPixelAngle;
+bool LLFace::setPixelAreaResult(const LLVector4a& center, const LLVector4a& size, F32 dist, F32 radius, F32 cos_angle_to_view_dir)
+{
     mPixelArea = radius*radius * 3.14159f;
+    mPixelRadius = radius;
+
+    constexpr F32 REPORTED_PIXEL_AREA_CHANGE = 1.5f;
+    if (mPixelArea > mReportedPixelArea * REPORTED_PIXEL_AREA_CHANGE ||
+        mPixelArea * REPORTED_PIXEL_AREA_CHANGE < mReportedPixelArea)
+    { // changed enough that the textures of this face should update their decode priority
+        mReportedPixelArea = mPixelArea;
+        for (U32 ch = 0; ch < LLRender::NUM_TEXTURE_CHANNELS; ++ch)
+        {
+            if (mTexture[ch].notNull())
+            {
+                mTexture[ch]->dirtyFaceStats();
+            }
+        }
+    }
 
     // remember last update time, add 10% noise to avoid all faces updating at the same time
     mLastPixelAreaUpdate = gFrameTimeSeconds + ll_frand() * PIXEL_AREA_UPDATE_PERIOD * 0.1f;
 
-    LLVector4a x_axis;
-    x_axis.load3(camera->getXAxis().mV);
-    cos_angle_to_view_dir = lookAt.dot3(x_axis).getF32();
+    LLViewerCamera* camera = LLViewerCamera::getInstance();
 
     //if has media, check if the face is out of the view frustum.
     if(hasMedia())
@@ -2325,6 +2401,8 @@ bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
         if(!camera->AABBInFrustum(center, size))
         {
             mImportanceToCamera = 0.f ;
+            mCosAngleToViewDir = cos_angle_to_view_dir;
+            mPixelAreaInFrustum = false;
             return false ;
         }
         if(cos_angle_to_view_dir > camera->getCosHalfFov()) //the center is within the view frustum
@@ -2333,10 +2411,19 @@ bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
         }
         else
         {
+            LLVector4a lookAt;
+            LLVector4a t;
+            t.load3(camera->getOrigin().mV);
+            lookAt.setSub(center, t);
+            lookAt.normalize3fast();
+
+            LLVector4a x_axis;
+            x_axis.load3(camera->getXAxis().mV);
+
             LLVector4a d;
             d.setSub(lookAt, x_axis);
 
-            if(dist * dist * d.dot3(d) < size_squared)
+            if(dist * dist * d.dot3(d) < size.dot3(size).getF32())
             {
                 cos_angle_to_view_dir = 1.0f ;
             }
@@ -2353,9 +2440,87 @@ bool LLFace::calcPixelArea(F32& cos_angle_to_view_dir, F32& radius)
         mImportanceToCamera = LLFace::calcImportanceToCamera(cos_angle_to_view_dir, dist) ;
     }
 
+    mCosAngleToViewDir = cos_angle_to_view_dir;
+    mPixelAreaInFrustum = true;
     return true ;
 }
 
+//static
+void LLFace::calcPixelAreas(LLFace* const* faces, U32 count)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_FACE;
+
+    // only called from the main thread, reuse the allocations from frame to frame
+    static std::vector<LLFace*> due_faces;
+    static std::vector<LLVector4a> boxes;   // per block of four faces: center x, y, z, then half size x, y, z
+    static std::vector<F32> results;        // per block of four faces: dist, cos_angle_to_view_dir, radius
+    due_faces.clear();
+    boxes.clear();
+
+    for (U32 i = 0; i < count; ++i)
+    {
+        LLFace* face = faces[i];
+        LLVector4a center;
+        LLVector4a size;
+        if (face && face->getViewerObject() && !face->isPixelAreaFresh() && face->getPixelAreaBounds(center, size))
+        {
+            U32 lane = (U32) due_faces.size() % 4;
+            if (lane == 0)
+            {
+                boxes.resize(boxes.size() + 6, LLVector4a(0.f));
+            }
+
+            LLVector4a* block = &boxes[boxes.size() - 6];
+            for (U32 axis = 0; axis < 3; ++axis)
+            {
+                block[axis].getF32ptr()[lane] = center[axis];
+                block[axis + 3].getF32ptr()[lane] = size[axis];
+            }
+            due_faces.push_back(face);
+        }
+    }
+
+    if (due_faces.empty())
+    {
+        return;
+    }
+
+    const LLViewerCamera* camera = LLViewerCamera::getInstance();
+    const F32 pixel_angle = LLDrawable::sCurPixelAngle;
+    const size_t num_blocks = boxes.size() / 6;
+    results.resize(num_blocks * 12);
+
+    auto calc_blocks = [camera, pixel_angle](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            F32* result = &results[i * 12];
+            camera->calcPixelRadius4(&boxes[i * 6], &boxes[i * 6 + 3], pixel_angle, result, result + 4, result + 8);
+        }
+    };
+
+    // large batches are split across the general thread pool
+    constexpr size_t BLOCKS_PER_TASK = 256;
+    if (num_blocks > BLOCKS_PER_TASK)
+    {
+        LL::parallelFor("General", num_blocks, BLOCKS_PER_TASK, calc_blocks);
+    }
+    else
+    {
+        calc_blocks(0, num_blocks);
+    }
+
+    // storing the results may queue texture updates, keep that on this thread
+    for (size_t i = 0; i < due_faces.size(); ++i)
+    {
+        const F32* result = &results[(i / 4) * 12 + i % 4];
+        const LLVector4a* block = &boxes[(i / 4) * 6];
+        LLVector4a center(block[0][i % 4], block[1][i % 4], block[2][i % 4]);
+        LLVector4a size(block[3][i % 4], block[4][i % 4], block[5][i % 4]);
+        due_faces[i]->setPixelAreaResult(center, size, result[0], result[8], result[4]);
+    }
+}
+
 //the projection of the face partially overlaps with the screen
 F32 LLFace::adjustPartialOverlapPixelArea(F32 cos_angle_to_view_dir, F32 radius )
 {
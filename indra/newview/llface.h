@@ -163,6 +163,11 @@ public:
                             bool force_rebuild = false,
                             bool no_debug_assert = false,
                             bool rebuild_for_gltf = false);
+    // True if getGeometryVolume() may run on a worker thread for this face, see
+    // LLVolumeGeometryManager::rebuildGeom().  Generates any volume data that
+    // getGeometryVolume() would create on demand, since other faces may share
+    // the volume.  Main thread only.
+    bool prepareGeometryOffThread();
 
     // For avatar
     U16          getGeometryAvatar(
@@ -246,7 +251,16 @@ private:
     friend class LLViewerTextureList;
     F32         adjustPartialOverlapPixelArea(F32 cos_angle_to_view_dir, F32 radius );
     bool        calcPixelArea(F32& cos_angle_to_view_dir, F32& radius) ;
+    bool        isPixelAreaFresh() const;
+    // center and half size of the box calcPixelArea measures, false if there is none
+    bool        getPixelAreaBounds(LLVector4a& center, LLVector4a& size);
+    // store the pixel area and importance to camera, returns false if the face is known to be off screen
+    bool        setPixelAreaResult(const LLVector4a& center, const LLVector4a& size, F32 dist, F32 radius, F32 cos_angle_to_view_dir);
 public:
+    // Update the pixel area of count faces against LLViewerCamera in one pass,
+    // four faces at a time.  Faces updated recently are skipped, and
+    // calcPixelArea returns the result for the others until it is due again.
+    static void calcPixelAreas(LLFace* const* faces, U32 count);
     static F32 calcImportanceToCamera(F32 to_view_dir, F32 dist);
     static F32 adjustPixelArea(F32 importance, F32 pixel_area) ;
 
@@ -310,6 +324,11 @@ private:
     // gFrameTimeSeconds when mPixelArea was last updated
     F32         mLastPixelAreaUpdate = 0.f;
 
+    // results of the last pixel area update, returned by calcPixelArea until the next one
+    F32         mPixelRadius = 0.f;
+    F32         mCosAngleToViewDir = 1.f;
+    bool        mPixelAreaInFrustum = false;
+
     // virtual size of face in texture area  (mPixelArea adjusted by texture repeats)
     // used to determine desired resolution of texture
     F32         mVSize;
@@ -317,6 +336,9 @@ private:
     // pixel area face covers on screen
     F32         mPixelArea;
 
+    // mPixelArea when the textures of this face were last told about it, see LLViewerTexture::dirtyFaceStats()
+    F32         mReportedPixelArea = 0.f;
+
     //importance factor, in the range [0, 1.0].
     //1.0: the most important.
     //based on the distance from the face to the view point and the angle from the face center to the view direction.
@@ -3267,6 +3267,7 @@ bool LLPanelEstateAccess::postBuild()
     if (avatar_name_list)
     {
         avatar_name_list->setCommitOnSelectionChange(true);
+        avatar_name_list->setIncrementalSort(true);
         avatar_name_list->setMaxItemCount(ESTATE_MAX_ACCESS_IDS);
     }
 
@@ -3280,6 +3281,7 @@ bool LLPanelEstateAccess::postBuild()
     if (group_name_list)
     {
         group_name_list->setCommitOnSelectionChange(true);
+        group_name_list->setIncrementalSort(true);
         group_name_list->setMaxItemCount(ESTATE_MAX_ACCESS_IDS);
     }
 
@@ -3293,6 +3295,7 @@ bool LLPanelEstateAccess::postBuild()
     if (banned_name_list)
     {
         banned_name_list->setCommitOnSelectionChange(true);
+        banned_name_list->setIncrementalSort(true);
         banned_name_list->setMaxItemCount(ESTATE_MAX_BANNED_IDS);
     }
 
@@ -3306,6 +3309,7 @@ bool LLPanelEstateAccess::postBuild()
     if (manager_name_list)
     {
         manager_name_list->setCommitOnSelectionChange(true);
+        manager_name_list->setIncrementalSort(true);
         manager_name_list->setMaxItemCount(ESTATE_MAX_MANAGERS * 4);    // Allow extras for dupe issue
     }
 
@@ -100,6 +100,8 @@ bool LLFloaterTopObjects::postBuild()
     mObjectsScrollList->setDoubleClickCallback(onDoubleClickObjectsList, this);
     mObjectsScrollList->setCommitOnSelectionChange(true);
     mObjectsScrollList->setCommitCallback(boost::bind(&LLFloaterTopObjects::onSelectionChanged, this));
+    // filled over several replies, rows are never edited
+    mObjectsScrollList->setIncrementalSort(true);
 
     setDefaultBtn("show_beacon_btn");
 
@@ -0,0 +1,139 @@
+/**
+ * @file llinventoryfetchcontroller.cpp
+ * @brief Tunes background inventory fetches from observed AIS responses
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llinventoryfetchcontroller.h"
+
+// weight of the newest response in the running averages
+constexpr F64 RESPONSE_WEIGHT = 0.2;
+
+static F64 running_average(F64 average, F64 value)
+{
+    return average > 0.0 ? average + (value - average) * RESPONSE_WEIGHT : value;
+}
+
+LLInventoryFetchController::LLInventoryFetchController()
+{
+    reset();
+}
+
+void LLInventoryFetchController::setParams(const Params& params)
+{
+    mParams = params;
+    mConcurrency = llclamp(mConcurrency, mParams.mMinConcurrency, mParams.mMaxConcurrency);
+    mDepth = llclamp(mDepth, mParams.mMinDepth, mParams.mMaxDepth);
+}
+
+void LLInventoryFetchController::reset()
+{
+    mConcurrency = llclamp(mParams.mStartConcurrency, mParams.mMinConcurrency, mParams.mMaxConcurrency);
+    mDepth = mParams.mMaxDepth;
+    mPromptResponses = 0;
+    mSlowResponses = 0;
+    mAverageSeconds = 0.0;
+    mObjectsPerFolder = 0.0;
+    mBackoffSeconds = mParams.mBackoffSeconds;
+    mBackoffUntil = 0.0;
+    mThrottleLevel = 0;
+}
+
+void LLInventoryFetchController::onResponse(F64 seconds, U32 folders, U32 objects, S32 status, F64 now)
+{
+    if (isThrottled(status))
+    {
+        // Requests sent before the last decrease get throttled too,
+        // don't count them again
+        if (!isBackingOff(now))
+        {
+            mThrottleLevel = mConcurrency;
+            mConcurrency = llmax(mParams.mMinConcurrency, mConcurrency * 3 / 4);
+            mBackoffUntil = now + mBackoffSeconds;
+            mBackoffSeconds = llmin(mBackoffSeconds * 2.0, mParams.mMaxBackoffSeconds);
+        }
+        mPromptResponses = 0;
+        mSlowResponses = 0;
+        return;
+    }
+
+    if (isTooLarge(status))
+    {
+        mDepth = llmax(mParams.mMinDepth, mDepth / 2);
+        return;
+    }
+
+    if (status < 200 || status >= 300)
+    {
+        // other failures say nothing about load
+        return;
+    }
+
+    mBackoffSeconds = mParams.mBackoffSeconds;
+    mAverageSeconds = running_average(mAverageSeconds, seconds);
+    mObjectsPerFolder = running_average(mObjectsPerFolder, (F64)objects / (F64)llmax(folders, 1U));
+
+    if (objects > mParams.mTargetObjects * 2 || seconds > mParams.mTargetSeconds)
+    {
+        mDepth = llmax(mParams.mMinDepth, mDepth / 2);
+    }
+    else if (objects < mParams.mTargetObjects / 4 && mDepth < mParams.mMaxDepth)
+    {
+        mDepth++;
+    }
+
+    // change concurrency at most once per round of responses
+    if (mAverageSeconds > mParams.mTargetSeconds)
+    {
+        mPromptResponses = 0;
+        if (++mSlowResponses >= mConcurrency)
+        {
+            mSlowResponses = 0;
+            mConcurrency = llmax(mParams.mMinConcurrency, mConcurrency - 1);
+        }
+    }
+    else
+    {
+        mSlowResponses = 0;
+        // probe carefully near where AIS throttled last time
+        bool near_throttle = mThrottleLevel && mConcurrency + 1 >= mThrottleLevel;
+        U32 round = near_throttle ? mConcurrency * 8 : mConcurrency;
+        if (++mPromptResponses >= round)
+        {
+            mPromptResponses = 0;
+            mConcurrency = llmin(mParams.mMaxConcurrency, mConcurrency + 1);
+        }
+    }
+}
+
+U32 LLInventoryFetchController::getBatchSize() const
+{
+    if (mObjectsPerFolder <= 0.0)
+    {
+        return mParams.mMaxBatch;
+    }
+    F64 batch = (F64)mParams.mTargetObjects / llmax(mObjectsPerFolder, 1.0);
+    return (U32)llclamp(batch, 1.0, (F64)mParams.mMaxBatch);
+}
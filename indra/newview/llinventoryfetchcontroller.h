@@ -0,0 +1,96 @@
+/**
+ * @file llinventoryfetchcontroller.h
+ * @brief Tunes background inventory fetches from observed AIS responses
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYFETCHCONTROLLER_H
+#define LL_LLINVENTORYFETCHCONTROLLER_H
+
+// Decides how many folder fetches LLInventoryModelBackgroundFetch keeps in
+// flight, how deep recursive fetches go and how many sibling folders share
+// one request, from the responses seen so far.
+//
+// Concurrency grows by one after every round of prompt responses, more
+// slowly near the level AIS last throttled at, and drops by a quarter when
+// AIS throttles (429/503), followed by a short pause that doubles while
+// throttling continues. Depth is halved when responses get
+// too big or slow (or AIS refuses one as too large with 403) and grows
+// again while responses stay small. The batch size aims for a target
+// number of objects per response given the objects seen per folder.
+class LLInventoryFetchController
+{
+public:
+    struct Params
+    {
+        U32     mMinConcurrency = 1;
+        U32     mMaxConcurrency = 19;   // PoolSizeAIS - 1
+        U32     mStartConcurrency = 4;
+        S32     mMinDepth = 1;
+        S32     mMaxDepth = 50;         // AIS cuts deeper requests
+        U32     mMaxBatch = 40;         // folders that fit into a subset url
+        F64     mTargetSeconds = 2.0;   // a response taking longer is too big or AIS is busy
+        U32     mTargetObjects = 2000;  // objects per response worth aiming for
+        F64     mBackoffSeconds = 0.25; // first pause after throttling
+        F64     mMaxBackoffSeconds = 8.0;
+    };
+
+    LLInventoryFetchController();
+
+    void setParams(const Params& params);
+    const Params& getParams() const { return mParams; }
+    void reset();
+
+    // A folder fetch completed: round trip time, number of folders it asked
+    // for, inventory objects it returned, HTTP status and the current time.
+    void onResponse(F64 seconds, U32 folders, U32 objects, S32 status, F64 now);
+
+    static bool isThrottled(S32 status) { return status == 429 || status == 503; }
+    static bool isTooLarge(S32 status) { return status == 403; }
+
+    // requests allowed in flight
+    U32 getConcurrency() const { return mConcurrency; }
+    // depth for recursive folder requests
+    S32 getDepth() const { return mDepth; }
+    // folders per subset request
+    U32 getBatchSize() const;
+    // no new requests until the pause after throttling is over
+    bool isBackingOff(F64 now) const { return now < mBackoffUntil; }
+
+    F64 getAverageSeconds() const { return mAverageSeconds; }
+    F64 getObjectsPerFolder() const { return mObjectsPerFolder; }
+
+private:
+    Params  mParams;
+    U32     mConcurrency;
+    S32     mDepth;
+    U32     mPromptResponses;   // in a row, since concurrency last changed
+    U32     mSlowResponses;
+    U32     mThrottleLevel;     // concurrency AIS last throttled at
+    F64     mAverageSeconds;
+    F64     mObjectsPerFolder;
+    F64     mBackoffSeconds;
+    F64     mBackoffUntil;
+};
+
+#endif // LL_LLINVENTORYFETCHCONTROLLER_H
@@ -35,6 +35,8 @@
 #include "llinventorymodel.h"
 #include "llinventorymodelbackgroundfetch.h"
 #include "llinventoryfunctions.h"
+#include "llinventoryobserver.h"
+#include "llinventorysearchindex.h"
 #include "llmarketplacefunctions.h"
 #include "llregex.h"
 #include "llviewercontrol.h"
@@ -48,6 +50,103 @@
 #include "llclipboard.h"
 #include "lltrans.h"
 
+namespace
+{
+    // Builds the search index from gInventory on first use and keeps it
+    // current from change notifications afterwards.
+    // gInventory owns and deletes it.
+    class LLInventorySearchIndexUpdater : public LLInventoryObserver
+    {
+    public:
+        LLInventorySearchIndexUpdater();
+        ~LLInventorySearchIndexUpdater();
+
+        static LLInventorySearchIndex* getIndex();
+
+        void changed(U32 mask) override;
+
+    private:
+        void indexObject(const LLInventoryObject* obj);
+
+        static LLInventorySearchIndexUpdater* sInstance;
+        LLInventorySearchIndex mIndex;
+    };
+
+    LLInventorySearchIndexUpdater* LLInventorySearchIndexUpdater::sInstance = NULL;
+
+    LLInventorySearchIndexUpdater::LLInventorySearchIndexUpdater()
+    {
+        LLInventoryModel::cat_array_t cats;
+        LLInventoryModel::item_array_t items;
+        gInventory.collectDescendents(gInventory.getRootFolderID(), cats, items, LLInventoryModel::INCLUDE_TRASH);
+        gInventory.collectDescendents(gInventory.getLibraryRootFolderID(), cats, items, LLInventoryModel::INCLUDE_TRASH);
+        for (const LLPointer<LLViewerInventoryCategory>& cat : cats)
+        {
+            indexObject(cat);
+        }
+        for (const LLPointer<LLViewerInventoryItem>& item : items)
+        {
+            indexObject(item);
+        }
+        LL_INFOS("Inventory") << "Indexed " << mIndex.size() << " inventory objects for search" << LL_ENDL;
+    }
+
+    LLInventorySearchIndexUpdater::~LLInventorySearchIndexUpdater()
+    {
+        if (sInstance == this)
+        {
+            sInstance = NULL;
+        }
+    }
+
+    //static
+    LLInventorySearchIndex* LLInventorySearchIndexUpdater::getIndex()
+    {
+        if (!sInstance && gInventory.isInventoryUsable())
+        {
+            sInstance = new LLInventorySearchIndexUpdater();
+            gInventory.addObserver(sInstance);
+        }
+        return sInstance ? &sInstance->mIndex : NULL;
+    }
+
+    void LLInventorySearchIndexUpdater::changed(U32 mask)
+    {
+        if (!(mask & (LABEL | INTERNAL | ADD | REMOVE | REBUILD)))
+        {
+            return;
+        }
+        for (const LLUUID& id : gInventory.getChangedIDs())
+        {
+            const LLInventoryObject* obj = gInventory.getObject(id);
+            if (obj)
+            {
+                indexObject(obj);
+            }
+            else
+            {
+                mIndex.remove(id);
+            }
+        }
+        for (const LLUUID& id : gInventory.getAddedIDs())
+        {
+            indexObject(gInventory.getObject(id));
+        }
+    }
+
+    void LLInventorySearchIndexUpdater::indexObject(const LLInventoryObject* obj)
+    {
+        if (const LLInventoryItem* item = dynamic_cast<const LLInventoryItem*>(obj))
+        {
+            mIndex.update(item->getUUID(), item->getName(), item->getDescription());
+        }
+        else if (obj)
+        {
+            mIndex.update(obj->getUUID(), obj->getName(), LLStringUtil::null);
+        }
+    }
+}
+
 LLInventoryFilter::FilterOps::FilterOps(const Params& p)
 :   mFilterObjectTypes(p.object_types),
     mFilterCategoryTypes(p.category_types),
@@ -84,6 +183,8 @@ LLInventoryFilter::LLInventoryFilter(const Params& p)
     mFirstRequiredGeneration(0),
     mFirstSuccessGeneration(0),
     mSearchType(SEARCHTYPE_NAME),
+    mIndexedSearchType(SEARCHTYPE_NAME),
+    mIndexedGeneration(0),
     mSingleFolderMode(false)
 {
     // copy mFilterOps into mDefaultFilterOps
@@ -103,7 +204,14 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
         return true;
     }
 
-    std::string desc = listener->getSearchableCreatorName();
+    bool passed = true;
+    if (mFilterTokens.empty() && mExactToken.empty()
+        && checkAgainstSearchIndex(listener, passed))
+    {
+        return passed && checkAgainstFilters(listener);
+    }
+
+    std::string desc;
     switch (mSearchType)
     {
         case SEARCHTYPE_CREATOR:
@@ -121,8 +229,6 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
             break;
     }
 
-
-    bool passed = true;
     if (!mExactToken.empty() && (mSearchType == SEARCHTYPE_NAME))
     {
         passed = false;
@@ -154,7 +260,12 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
         passed = checkAgainstFilterSubString(desc);
     }
 
-    passed = passed && checkAgainstFilterType(listener);
+    return passed && checkAgainstFilters(listener);
+}
+
+bool LLInventoryFilter::checkAgainstFilters(const LLFolderViewModelItemInventory* listener) const
+{
+    bool passed = checkAgainstFilterType(listener);
     passed = passed && checkAgainstPermissions(listener);
     passed = passed && checkAgainstFilterLinks(listener);
     passed = passed && checkAgainstCreator(listener);
@@ -166,6 +277,60 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
     return passed;
 }
 
+bool LLInventoryFilter::checkAgainstSearchIndex(const LLFolderViewModelItemInventory* listener, bool& passed)
+{
+    static LLCachedControl<bool> use_index(gSavedSettings, "InventorySearchIndex", true);
+    if (!use_index
+        || mFilterSubString.empty()
+        || (mSearchType != SEARCHTYPE_NAME && mSearchType != SEARCHTYPE_DESCRIPTION)
+        // folder names can be localized, leave them to the string check
+        || listener->getInventoryType() == LLInventoryType::IT_CATEGORY)
+    {
+        return false;
+    }
+
+    LLInventorySearchIndex* index = LLInventorySearchIndexUpdater::getIndex();
+    const LLUUID& id = listener->getUUID();
+    if (!index || !index->has(id))
+    {
+        return false;
+    }
+
+    // one query per search string, not per item
+    if (mIndexedSubString != mFilterSubString
+        || mIndexedSearchType != mSearchType
+        || mIndexedGeneration != index->getGeneration())
+    {
+        LLInventorySearchIndex::Query query;
+        query.mSubString = mFilterSubString;
+        query.mField = mSearchType == SEARCHTYPE_NAME ? LLInventorySearchIndex::NAME : LLInventorySearchIndex::DESCRIPTION;
+        index->find(query, mIndexMatches);
+        mIndexedSubString = mFilterSubString;
+        mIndexedSearchType = mSearchType;
+        mIndexedGeneration = index->getGeneration();
+    }
+
+    if (index->isMatch(mIndexMatches, id))
+    {
+        passed = true;
+    }
+    else if (mSearchType == SEARCHTYPE_NAME)
+    {
+        // The searchable name is the item name followed by a label suffix
+        // like " (worn)" that isn't indexed. Check for a match that ends in it.
+        const std::string& searchable_name = listener->getSearchableName();
+        size_t name_length = index->getNameLength(id);
+        size_t start = name_length + 1 > mFilterSubString.size() ? name_length + 1 - mFilterSubString.size() : 0;
+        passed = searchable_name.size() > name_length
+            && searchable_name.find(mFilterSubString, start) != std::string::npos;
+    }
+    else
+    {
+        passed = false;
+    }
+    return true;
+}
+
 bool LLInventoryFilter::check(const LLInventoryItem* item)
 {
     const bool passed_string = checkAgainstFilterSubString(item->getName());
@@ -30,6 +30,7 @@
 #include "llinventorytype.h"
 #include "llpermissionsflags.h"
 #include "llfolderviewmodel.h"
+#include "llinventorysearchindex.h"
 
 class LLFolderViewItem;
 class LLFolderViewFolder;
@@ -358,6 +359,10 @@ public:
 private:
     bool                areDateLimitsSet() const;
     bool                checkAgainstFilterSubString(const std::string& desc) const;
+    // the string check through LLInventorySearchIndex, false if the index can't answer it
+    bool                checkAgainstSearchIndex(const class LLFolderViewModelItemInventory* listener, bool& passed);
+    // everything but the string check
+    bool                checkAgainstFilters(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstFilterType(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstFilterType(const LLInventoryItem* item) const;
     bool                checkAgainstPermissions(const class LLFolderViewModelItemInventory* listener) const;
@@ -395,6 +400,12 @@ private:
     std::vector<std::string> mFilterTokens;
     std::string              mExactToken;
 
+    // search index results for mIndexedSubString
+    LLInventorySearchIndex::bitset_t mIndexMatches;
+    std::string              mIndexedSubString;
+    ESearchType              mIndexedSearchType;
+    U32                      mIndexedGeneration;
+
     bool mSingleFolderMode;
 };
 
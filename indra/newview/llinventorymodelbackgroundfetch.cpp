@@ -182,6 +182,14 @@ const char* const LOG_INV("Inventory");
 
 } // end of namespace anonymous
 
+static LLTrace::EventStatHandle<F64Milliseconds> sFetchLatency("inventory_fetch_latency", "Round trip time of background inventory fetches");
+static LLTrace::CountStatHandle<> sFetchObjects("inventory_fetch_objects", "Inventory objects received by background fetches");
+static LLTrace::CountStatHandle<> sFetchThrottled("inventory_fetch_throttled", "Background inventory fetches throttled by AIS");
+static LLTrace::SampleStatHandle<> sFetchConcurrency("inventory_fetch_concurrency", "Background inventory fetches allowed in flight");
+static LLTrace::SampleStatHandle<> sFetchDepth("inventory_fetch_depth", "Depth of recursive background inventory fetches");
+static LLTrace::SampleStatHandle<> sFetchBatch("inventory_fetch_batch", "Folders per background inventory subset fetch");
+static LLTrace::SampleStatHandle<> sFetchQueued("inventory_fetch_queued", "Folders waiting for a background inventory fetch");
+
 
 ///----------------------------------------------------------------------------
 /// Class LLInventoryModelBackgroundFetch
@@ -585,6 +593,7 @@ void LLInventoryModelBackgroundFetch::onAISContentCalback(
 {
     // Don't emplace_front on failure - there is a chance it was fired from inside bulkFetchViaAis
     incrFetchFolderCount(-1);
+    bool throttled = onAISResponse(static_cast<U32>(content_ids.size()));
 
     uuid_vec_t::const_iterator folder_iter = content_ids.begin();
     uuid_vec_t::const_iterator folder_end = content_ids.end();
@@ -601,7 +610,11 @@ void LLInventoryModelBackgroundFetch::onAISContentCalback(
         {
             cat->setFetching(LLViewerInventoryCategory::FETCH_NONE);
         }
-        if (response_id.isNull())
+        if (throttled)
+        {
+            // nothing wrong with the folders, request the same batch again
+        }
+        else if (response_id.isNull())
         {
             // Failed to fetch, get it individually
             mFetchFolderQueue.emplace_back(*folder_iter, FT_RECURSIVE);
@@ -626,6 +639,11 @@ void LLInventoryModelBackgroundFetch::onAISContentCalback(
         folder_iter++;
     }
 
+    if (throttled)
+    {
+        mFetchFolderQueue.emplace_back(request_id, FT_CONTENT_RECURSIVE);
+    }
+
     if (!mFetchFolderQueue.empty())
     {
         mBackgroundFetchActive = true;
@@ -648,6 +666,7 @@ void LLInventoryModelBackgroundFetch::onAISFolderCalback(const LLUUID& request_i
         llassert(false);
         LL_WARNS() << "Unexpected folder response for " << request_id << LL_ENDL;
     }
+    bool throttled = onAISResponse(1);
 
     if (request_id.isNull())
     {
@@ -660,7 +679,12 @@ void LLInventoryModelBackgroundFetch::onAISFolderCalback(const LLUUID& request_i
     if (response_id.isNull()) // Failure
     {
         LL_DEBUGS(LOG_INV , "AIS3") << "Failure response for folder " << request_id << LL_ENDL;
-        if (fetch_type == FT_RECURSIVE)
+        if (throttled)
+        {
+            // AIS is busy, don't give up on the folder
+            mFetchFolderQueue.emplace_back(request_id, fetch_type);
+        }
+        else if (fetch_type == FT_RECURSIVE)
         {
             // A full recursive request failed.
             // Try requesting folder and nested content separately
@@ -735,6 +759,32 @@ void LLInventoryModelBackgroundFetch::onAISFolderCalback(const LLUUID& request_i
     }
 }
 
+bool LLInventoryModelBackgroundFetch::onAISResponse(U32 folders)
+{
+    const AISAPI::ResponseInfo& response = AISAPI::getLastResponse();
+    if (response.mStatus == 0)
+    {
+        // callback fired without a request, e.g. no cap
+        return false;
+    }
+
+    record(sFetchLatency, F64Seconds(response.mSeconds));
+    add(sFetchObjects, response.mObjects);
+    bool throttled = LLInventoryFetchController::isThrottled(response.mStatus);
+    if (throttled)
+    {
+        add(sFetchThrottled, 1);
+    }
+
+    static LLCachedControl<bool> adaptive(gSavedSettings, "InventoryFetchAdaptive", true);
+    if (!adaptive)
+    {
+        return false;
+    }
+    mFetchController.onResponse(response.mSeconds, folders, response.mObjects, response.mStatus, LLTimer::getTotalSeconds());
+    return throttled;
+}
+
 static LLTrace::BlockTimerStatHandle FTM_BULK_FETCH("Bulk Fetch");
 
 void LLInventoryModelBackgroundFetch::bulkFetchViaAis()
@@ -747,11 +797,30 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis()
     }
 
     static LLCachedControl<U32> ais_pool(gSavedSettings, "PoolSizeAIS", 20);
+    static LLCachedControl<bool> adaptive(gSavedSettings, "InventoryFetchAdaptive", true);
     // Don't have too many requests at once, AIS throttles
     // Reserve one request for actions outside of fetch (like renames)
-    const U32 max_concurrent_fetches = llclamp(ais_pool - 1, 1, 50);
+    U32 max_concurrent_fetches = llclamp(ais_pool - 1, 1, 50);
 
-    if ((U32)mFetchCount >= max_concurrent_fetches)
+    if (adaptive)
+    {
+        // pool size is the ceiling, the controller finds how much of it AIS takes
+        if (mFetchController.getParams().mMaxConcurrency != max_concurrent_fetches)
+        {
+            LLInventoryFetchController::Params params = mFetchController.getParams();
+            params.mMaxConcurrency = max_concurrent_fetches;
+            mFetchController.setParams(params);
+        }
+        max_concurrent_fetches = mFetchController.getConcurrency();
+
+        sample(sFetchConcurrency, max_concurrent_fetches);
+        sample(sFetchDepth, mFetchController.getDepth());
+        sample(sFetchBatch, mFetchController.getBatchSize());
+    }
+    sample(sFetchQueued, mFetchFolderQueue.size());
+
+    if ((U32)mFetchCount >= max_concurrent_fetches
+        || (adaptive && mFetchController.isBackingOff(LLTimer::getTotalSeconds())))
     {
         return;
     }
@@ -884,7 +953,13 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
 
                     // Top limit is 'as many as you can put into url'
                     static LLCachedControl<S32> ais_batch(gSavedSettings, "BatchSizeAIS3", 20);
+                    static LLCachedControl<bool> adaptive(gSavedSettings, "InventoryFetchAdaptive", true);
                     S32 batch_limit = llclamp(ais_batch(), 1, 40);
+                    if (adaptive)
+                    {
+                        // fewer folders per request when folders turn out big
+                        batch_limit = llmin(batch_limit, (S32)mFetchController.getBatchSize());
+                    }
 
                     if (categories)
                     {
@@ -935,7 +1010,14 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
                             item_type = AISAPI::LIBRARY;
                         }
 
-                        AISAPI::FetchCategorySubset(cat_id, children, item_type, true, cb, 0);
+                        if (adaptive)
+                        {
+                            AISAPI::FetchCategorySubset(cat_id, children, item_type, false, cb, mFetchController.getDepth());
+                        }
+                        else
+                        {
+                            AISAPI::FetchCategorySubset(cat_id, children, item_type, true, cb, 0);
+                        }
                     }
 
                     if (content_done)
@@ -992,13 +1074,32 @@ void LLInventoryModelBackgroundFetch::bulkFetchViaAis(const FetchQueueInfo& fetc
                             item_type = AISAPI::LIBRARY;
                         }
 
-                        AISAPI::FetchCategoryChildren(cat_id , item_type , type == FT_RECURSIVE , cb, 0);
+                        static LLCachedControl<bool> adaptive(gSavedSettings, "InventoryFetchAdaptive", true);
+                        if (adaptive && type == FT_RECURSIVE)
+                        {
+                            // folders past the depth come back incomplete and get requested
+                            // again when descendants are verified
+                            AISAPI::FetchCategoryChildren(cat_id, item_type, false, cb, mFetchController.getDepth());
+                        }
+                        else
+                        {
+                            AISAPI::FetchCategoryChildren(cat_id , item_type , type == FT_RECURSIVE , cb, 0);
+                        }
                     }
                 }
                 else
                 {
                     // Already fetched, check if anything inside needs fetching
-                    if (fetch_info.mFetchType == FT_RECURSIVE
+                    static LLCachedControl<bool> adaptive(gSavedSettings, "InventoryFetchAdaptive", true);
+                    if (adaptive
+                        && (fetch_info.mFetchType == FT_RECURSIVE
+                            || fetch_info.mFetchType == FT_FOLDER_AND_CONTENT))
+                    {
+                        // Batches children that still need fetching into subset
+                        // requests, and queues the rest like below
+                        mFetchFolderQueue.emplace_back(cat_id, FT_CONTENT_RECURSIVE);
+                    }
+                    else if (fetch_info.mFetchType == FT_RECURSIVE
                         || fetch_info.mFetchType == FT_FOLDER_AND_CONTENT)
                     {
                         LLInventoryModel::cat_array_t* categories(NULL);
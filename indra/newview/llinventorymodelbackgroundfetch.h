@@ -27,6 +27,7 @@
 #ifndef LL_LLINVENTORYMODELBACKGROUNDFETCH_H
 #define LL_LLINVENTORYMODELBACKGROUNDFETCH_H
 
+#include "llinventoryfetchcontroller.h"
 #include "llsingleton.h"
 #include "lluuid.h"
 #include "httpcommon.h"
@@ -110,6 +111,9 @@ protected:
 
     void onAISContentCalback(const LLUUID& request_id, const uuid_vec_t& content_ids, const LLUUID& response_id, EFetchType fetch_type);
     void onAISFolderCalback(const LLUUID& request_id, const LLUUID& response_id, EFetchType fetch_type);
+    // Feeds the AIS response being handled to mFetchController, true if
+    // AIS throttled it and the request should simply be repeated
+    bool onAISResponse(U32 folders);
     void bulkFetchViaAis();
     void bulkFetchViaAis(const FetchQueueInfo& fetch_info);
     void bulkFetch();
@@ -139,6 +143,7 @@ private:
     fetch_queue_t mFetchItemQueue;
     uuid_set_t mForceFetchSet;
     std::list<LLUUID> mExpectedFolderIds; // for debug, should this track time?
+    LLInventoryFetchController mFetchController;
 };
 
 #endif // LL_LLINVENTORYMODELBACKGROUNDFETCH_H
@@ -0,0 +1,303 @@
+/**
+ * @file llinventorysearchindex.cpp
+ * @brief Inverted index over inventory names and descriptions
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llinventorysearchindex.h"
+
+#include <algorithm>
+
+// Walking a list with binary searches beats a merge when the other list
+// is this many times longer
+constexpr size_t GALLOP_RATIO = 16;
+
+void LLInventorySearchIndex::update(const LLUUID& id, const std::string& name, const std::string& description)
+{
+    std::string upper_name(name);
+    std::string upper_description(description);
+    LLStringUtil::toUpper(upper_name);
+    LLStringUtil::toUpper(upper_description);
+
+    U32 slot;
+    auto found = mSlots.find(id);
+    if (found != mSlots.end())
+    {
+        slot = found->second;
+        if (mNames[slot] != upper_name)
+        {
+            removePostings(mNamePostings, mNames[slot], slot);
+            addPostings(mNamePostings, upper_name, slot);
+        }
+        if (mDescriptions[slot] != upper_description)
+        {
+            removePostings(mDescriptionPostings, mDescriptions[slot], slot);
+            addPostings(mDescriptionPostings, upper_description, slot);
+        }
+    }
+    else
+    {
+        if (!mFreeSlots.empty())
+        {
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else
+        {
+            slot = (U32)mIDs.size();
+            mIDs.emplace_back();
+            mNames.emplace_back();
+            mDescriptions.emplace_back();
+        }
+        mSlots[id] = slot;
+        mIDs[slot] = id;
+        addPostings(mNamePostings, upper_name, slot);
+        addPostings(mDescriptionPostings, upper_description, slot);
+        setBit(mUsed, slot, true);
+    }
+
+    mNames[slot].swap(upper_name);
+    mDescriptions[slot].swap(upper_description);
+    ++mGeneration;
+}
+
+void LLInventorySearchIndex::remove(const LLUUID& id)
+{
+    auto found = mSlots.find(id);
+    if (found == mSlots.end())
+    {
+        return;
+    }
+
+    U32 slot = found->second;
+    mSlots.erase(found);
+    removePostings(mNamePostings, mNames[slot], slot);
+    removePostings(mDescriptionPostings, mDescriptions[slot], slot);
+    setBit(mUsed, slot, false);
+    mIDs[slot].setNull();
+    mNames[slot].clear();
+    mDescriptions[slot].clear();
+    mFreeSlots.push_back(slot);
+    ++mGeneration;
+}
+
+void LLInventorySearchIndex::clear()
+{
+    mSlots.clear();
+    mFreeSlots.clear();
+    mIDs.clear();
+    mNames.clear();
+    mDescriptions.clear();
+    mUsed.clear();
+    mNamePostings.clear();
+    mDescriptionPostings.clear();
+    ++mGeneration;
+}
+
+size_t LLInventorySearchIndex::getNameLength(const LLUUID& id) const
+{
+    auto found = mSlots.find(id);
+    return found != mSlots.end() ? mNames[found->second].size() : 0;
+}
+
+void LLInventorySearchIndex::find(const Query& query, bitset_t& matches) const
+{
+    LL_PROFILE_ZONE_SCOPED;
+    const std::vector<std::string>& texts = query.mField == NAME ? mNames : mDescriptions;
+    const std::string& sub_string = query.mSubString;
+
+    if (sub_string.empty())
+    {
+        matches = mUsed;
+        return;
+    }
+
+    matches.assign(mUsed.size(), 0);
+    if (sub_string.size() < 3)
+    {
+        // too short for trigrams, but still no copies or virtual calls
+        for (U32 slot = 0; slot < (U32)mIDs.size(); ++slot)
+        {
+            if (getBit(mUsed, slot)
+                && texts[slot].find(sub_string) != std::string::npos)
+            {
+                setBit(matches, slot, true);
+            }
+        }
+        return;
+    }
+
+    slot_list_t candidates;
+    findCandidates(query.mField == NAME ? mNamePostings : mDescriptionPostings, sub_string, candidates);
+    for (U32 slot : candidates)
+    {
+        // having all the trigrams doesn't mean having them in order
+        if (texts[slot].find(sub_string) != std::string::npos)
+        {
+            setBit(matches, slot, true);
+        }
+    }
+}
+
+void LLInventorySearchIndex::find(const Query& query, uuid_vec_t& ids) const
+{
+    bitset_t matches;
+    find(query, matches);
+    ids.clear();
+    for (U32 slot = 0; slot < (U32)mIDs.size(); ++slot)
+    {
+        if (getBit(matches, slot))
+        {
+            ids.push_back(mIDs[slot]);
+        }
+    }
+}
+
+bool LLInventorySearchIndex::isMatch(const bitset_t& matches, const LLUUID& id) const
+{
+    auto found = mSlots.find(id);
+    return found != mSlots.end() && getBit(matches, found->second);
+}
+
+//static
+void LLInventorySearchIndex::getTrigrams(const std::string& text, std::vector<U32>& trigrams)
+{
+    trigrams.clear();
+    for (size_t i = 2; i < text.size(); ++i)
+    {
+        trigrams.push_back(((U32)(U8)text[i - 2] << 16) | ((U32)(U8)text[i - 1] << 8) | (U32)(U8)text[i]);
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+//static
+void LLInventorySearchIndex::setBit(bitset_t& bits, U32 slot, bool value)
+{
+    if (slot / 64 >= bits.size())
+    {
+        if (!value)
+        {
+            return;
+        }
+        bits.resize(slot / 64 + 1, 0);
+    }
+    if (value)
+    {
+        bits[slot / 64] |= 1ULL << (slot % 64);
+    }
+    else
+    {
+        bits[slot / 64] &= ~(1ULL << (slot % 64));
+    }
+}
+
+void LLInventorySearchIndex::addPostings(posting_map_t& postings, const std::string& text, U32 slot)
+{
+    std::vector<U32> trigrams;
+    getTrigrams(text, trigrams);
+    for (U32 trigram : trigrams)
+    {
+        slot_list_t& slots = postings[trigram];
+        // new slots are the highest, so this is usually an append
+        if (slots.empty() || slots.back() < slot)
+        {
+            slots.push_back(slot);
+        }
+        else
+        {
+            slots.insert(std::lower_bound(slots.begin(), slots.end(), slot), slot);
+        }
+    }
+}
+
+void LLInventorySearchIndex::removePostings(posting_map_t& postings, const std::string& text, U32 slot)
+{
+    std::vector<U32> trigrams;
+    getTrigrams(text, trigrams);
+    for (U32 trigram : trigrams)
+    {
+        auto found = postings.find(trigram);
+        if (found == postings.end())
+        {
+            continue;
+        }
+        slot_list_t& slots = found->second;
+        auto it = std::lower_bound(slots.begin(), slots.end(), slot);
+        if (it != slots.end() && *it == slot)
+        {
+            slots.erase(it);
+        }
+        if (slots.empty())
+        {
+            postings.erase(found);
+        }
+    }
+}
+
+void LLInventorySearchIndex::findCandidates(const posting_map_t& postings, const std::string& sub_string, slot_list_t& candidates) const
+{
+    std::vector<U32> trigrams;
+    getTrigrams(sub_string, trigrams);
+
+    std::vector<const slot_list_t*> lists;
+    for (U32 trigram : trigrams)
+    {
+        auto found = postings.find(trigram);
+        if (found == postings.end())
+        {
+            // nothing has this trigram
+            candidates.clear();
+            return;
+        }
+        lists.push_back(&found->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const slot_list_t* a, const slot_list_t* b) { return a->size() < b->size(); });
+
+    candidates = *lists.front();
+    slot_list_t narrowed;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+    {
+        const slot_list_t& slots = *lists[i];
+        narrowed.clear();
+        if (slots.size() > candidates.size() * GALLOP_RATIO)
+        {
+            for (U32 slot : candidates)
+            {
+                if (std::binary_search(slots.begin(), slots.end(), slot))
+                {
+                    narrowed.push_back(slot);
+                }
+            }
+        }
+        else
+        {
+            std::set_intersection(candidates.begin(), candidates.end(), slots.begin(), slots.end(),
+                                  std::back_inserter(narrowed));
+        }
+        candidates.swap(narrowed);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file llinventorysearchindex.h
+ * @brief Inverted index over inventory names and descriptions
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYSEARCHINDEX_H
+#define LL_LLINVENTORYSEARCHINDEX_H
+
+#include "lluuid.h"
+
+#include <unordered_map>
+
+// Finds inventory objects by a substring of their name or description
+// without looking at every object.
+//
+// Every object gets a slot. Names and descriptions are stored upper case
+// and each three byte sequence (trigram) in them maps to the sorted list of
+// slots containing it. A substring query intersects the lists of its
+// trigrams and confirms the few candidates left with a plain find().
+//
+// The index knows nothing about LLInventoryModel, whoever owns it feeds it
+// updates (see LLInventoryFilter).
+class LLInventorySearchIndex
+{
+public:
+    enum EField
+    {
+        NAME,
+        DESCRIPTION
+    };
+
+    // one bit per slot
+    typedef std::vector<U64> bitset_t;
+
+    struct Query
+    {
+        std::string     mSubString;                     // upper case, empty matches everything
+        EField          mField = NAME;
+    };
+
+    // Adds the object or replaces what is known about it.
+    // Name and description get converted to upper case.
+    void update(const LLUUID& id, const std::string& name, const std::string& description);
+    void remove(const LLUUID& id);
+    void clear();
+
+    bool has(const LLUUID& id) const { return mSlots.find(id) != mSlots.end(); }
+    // objects indexed
+    size_t size() const { return mSlots.size(); }
+    // changes with every update() and remove()
+    U32 getGeneration() const { return mGeneration; }
+    // length of the indexed name, 0 for unknown objects
+    size_t getNameLength(const LLUUID& id) const;
+
+    // Sets a bit in matches for every object the query finds
+    void find(const Query& query, bitset_t& matches) const;
+    void find(const Query& query, uuid_vec_t& ids) const;
+    // whether find() put id into matches
+    bool isMatch(const bitset_t& matches, const LLUUID& id) const;
+
+private:
+    typedef std::vector<U32> slot_list_t;
+    typedef std::unordered_map<U32, slot_list_t> posting_map_t;
+
+    static void getTrigrams(const std::string& text, std::vector<U32>& trigrams);
+    static void setBit(bitset_t& bits, U32 slot, bool value);
+    static bool getBit(const bitset_t& bits, U32 slot)
+    {
+        return slot / 64 < bits.size() && (bits[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    void addPostings(posting_map_t& postings, const std::string& text, U32 slot);
+    void removePostings(posting_map_t& postings, const std::string& text, U32 slot);
+    // slots that have every trigram of sub_string
+    void findCandidates(const posting_map_t& postings, const std::string& sub_string, slot_list_t& candidates) const;
+
+    std::unordered_map<LLUUID, U32> mSlots;
+    std::vector<U32>                mFreeSlots;
+
+    // per slot
+    std::vector<LLUUID>             mIDs;
+    std::vector<std::string>        mNames;
+    std::vector<std::string>        mDescriptions;
+    bitset_t                        mUsed;
+
+    posting_map_t                   mNamePostings;
+    posting_map_t                   mDescriptionPostings;
+
+    U32                             mGeneration = 0;
+};
+
+#endif // LL_LLINVENTORYSEARCHINDEX_H
@@ -831,6 +831,9 @@ bool LLPanelGroupMembersSubTab::postBuildSubTab(LLView* root)
     mMembersList->setDoubleClickCallback(onMemberDoubleClick, this);
     mMembersList->setContextMenu(LLScrollListCtrl::MENU_AVATAR);
     mMembersList->setIsFriendCallback(LLAvatarActions::isFriend);
+    // large groups add members over many frames, LLNameListCtrl calls
+    // setNeedsSort() when it fills in names
+    mMembersList->setIncrementalSort(true);
 
     LLSD row;
     row["columns"][0]["column"] = "name";
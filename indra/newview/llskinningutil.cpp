@@ -281,6 +281,100 @@ void LLSkinningUtil::getPerVertexSkinMatrix(
     (void)valid_weights;
 }
 
+void LLSkinningUtil::skinPositions(
+    const LLMatrix4a* mat,
+    U32 joint_count,
+    const LLMatrix4a& bind_shape_matrix,
+    const LLVector4a* weights,
+    const LLVector4a* positions,
+    U32 count,
+    LLVector4a* dst,
+    LLVector4a* extents)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+
+    if (count == 0 || joint_count == 0)
+    {
+        return;
+    }
+
+    const LLVector4a zero = LLVector4a::getZero();
+    LLVector4a one;
+    one.splat(1.f);
+    LLVector4a max_index;
+    max_index.splat((F32)(joint_count - 1));
+
+    LLVector4a box_min;
+    LLVector4a box_max;
+
+    for (U32 i = 0; i < count; ++i)
+    {
+        // Same split as getPerVertexSkinMatrix(): the integer part of each
+        // weight is a joint index, the fraction its unnormalized weight.
+        // cvtt truncates toward zero, so step back below negative values
+        // to get floor().
+        const LLVector4a& w = weights[i];
+        LLVector4a index(_mm_cvtepi32_ps(_mm_cvttps_epi32(w)));
+        index.sub(LLVector4a(_mm_and_ps(_mm_cmpgt_ps(index, w), one)));
+
+        LLVector4a wght;
+        wght.setSub(w, index);
+
+        index.setMax(index, zero);
+        index.setMin(index, max_index);
+        LL_ALIGN_16(S32 idx[4]);
+        _mm_store_si128((__m128i*)idx, _mm_cvttps_epi32(index));
+
+        // normalize all four weights like the shader does
+        LLVector4a scale;
+        scale.setAllDot4(wght, one);
+        wght.mul(LLVector4a(_mm_div_ps(one, scale)));
+
+        // blend the four palette matrices
+        LLMatrix4a final_mat;
+        const LLMatrix4a& m0 = mat[idx[0]];
+        const LLMatrix4a& m1 = mat[idx[1]];
+        const LLMatrix4a& m2 = mat[idx[2]];
+        const LLMatrix4a& m3 = mat[idx[3]];
+        LLVector4a w0(_mm_shuffle_ps(wght, wght, _MM_SHUFFLE(0, 0, 0, 0)));
+        LLVector4a w1(_mm_shuffle_ps(wght, wght, _MM_SHUFFLE(1, 1, 1, 1)));
+        LLVector4a w2(_mm_shuffle_ps(wght, wght, _MM_SHUFFLE(2, 2, 2, 2)));
+        LLVector4a w3(_mm_shuffle_ps(wght, wght, _MM_SHUFFLE(3, 3, 3, 3)));
+        for (U32 r = 0; r < 4; ++r)
+        {
+            LLVector4a row;
+            final_mat.mMatrix[r].setMul(m0.mMatrix[r], w0);
+            row.setMul(m1.mMatrix[r], w1);
+            final_mat.mMatrix[r].add(row);
+            row.setMul(m2.mMatrix[r], w2);
+            final_mat.mMatrix[r].add(row);
+            row.setMul(m3.mMatrix[r], w3);
+            final_mat.mMatrix[r].add(row);
+        }
+
+        LLVector4a t;
+        bind_shape_matrix.affineTransform(positions[i], t);
+        final_mat.affineTransform(t, dst[i]);
+
+        if (i == 0)
+        {
+            box_min = dst[0];
+            box_max = dst[0];
+        }
+        else
+        {
+            box_min.setMin(box_min, dst[i]);
+            box_max.setMax(box_max, dst[i]);
+        }
+    }
+
+    if (extents)
+    {
+        extents[0] = box_min;
+        extents[1] = box_max;
+    }
+}
+
 void LLSkinningUtil::initJointNums(LLMeshSkinInfo* skin, LLVOAvatar *avatar)
 {
     if (!skin->mJointNumsInitialized)
@@ -48,6 +48,15 @@ namespace LLSkinningUtil
     void scrubSkinWeights(LLVector4a* weights, U32 num_vertices, const LLMeshSkinInfo* skin);
     void getPerVertexSkinMatrix(F32* weights, const LLMatrix4a* mat, bool handle_bad_scale, LLMatrix4a& final_mat, U32 max_joints);
 
+    // Skin a whole vertex stream: for each vertex, the equivalent of
+    // getPerVertexSkinMatrix() applied to bind_shape_matrix * positions[i],
+    // except that all four weights are normalized, as in objectSkinV.glsl.
+    // mat holds joint_count palette entries. If extents is not NULL the
+    // bounding box of the result is written to extents[0] and extents[1].
+    void skinPositions(const LLMatrix4a* mat, U32 joint_count, const LLMatrix4a& bind_shape_matrix,
+                       const LLVector4a* weights, const LLVector4a* positions, U32 count,
+                       LLVector4a* dst, LLVector4a* extents = NULL);
+
     LL_FORCE_INLINE void getPerVertexSkinMatrixWithIndices(
         F32*        weights,
         U8*         idx,
@@ -458,6 +458,7 @@ void LLSpatialGroup::shift(const LLVector4a &offset)
     mObjectBounds[0].add(offset);
     mObjectExtents[0].add(offset);
     mObjectExtents[1].add(offset);
+    mBoundsRevision++;
 
     if (!getSpatialPartition()->mRenderByGroup &&
         getSpatialPartition()->mPartitionType != LLViewerRegion::PARTITION_TREE &&
@@ -1434,19 +1435,26 @@ S32 LLSpatialPartition::cull(LLCamera &camera, bool do_occlusion)
     ((LLSpatialGroup*)mOctree->getListener(0))->validate();
 #endif
 
+    // during LLPipeline::updateCullParallel(), prepareCull() already built it
+    // and this only reads it, on whichever thread
+    const LLViewerOctreeFlatTree* flat_tree = getFlatTree(!sParallelCull);
+
     if (LLPipeline::sShadowRender)
     {
         LLOctreeCullShadow culler(&camera);
+        culler.setFlatTree(flat_tree);
         culler.traverse(mOctree);
     }
     else if (mInfiniteFarClip || (!LLPipeline::sUseFarClip && !gCubeSnapshot))
     {
         LLOctreeCullNoFarClip culler(&camera);
+        culler.setFlatTree(flat_tree);
         culler.traverse(mOctree);
     }
     else
     {
         LLOctreeCull culler(&camera);
+        culler.setFlatTree(flat_tree);
         culler.traverse(mOctree);
     }
 
@@ -228,6 +228,25 @@ public:
     typedef std::unordered_map<LLFace*, buffer_list_t> buffer_texture_map_t;
     typedef std::unordered_map<U32, buffer_texture_map_t> buffer_map_t;
 
+    // One vertex buffer's worth of faces from LLVolumeGeometryManager::genDrawInfo()
+    struct DrawBatch
+    {
+        U32 mEnd;        // one past the last face of the batch in the sorted face list
+        U32 mGeomCount;
+        U32 mIndexCount;
+    };
+
+    // Sorted face order and vertex buffer split of one genDrawInfo() call, reused
+    // as long as the faces, textures and materials it was built from don't change
+    struct DrawBatchLayout
+    {
+        U64 mHash = 0;
+        std::vector<LLFace*> mFaces;
+        std::vector<S16> mTextureIndex; // texture index the batching gave each face, -1 if left as is
+        std::vector<DrawBatch> mBatches;
+    };
+    typedef std::vector<DrawBatchLayout> draw_batch_cache_t;
+
     struct CompareDistanceGreater
     {
         bool operator()(const LLSpatialGroup* const& lhs, const LLSpatialGroup* const& rhs)
@@ -350,6 +369,8 @@ public:
 
     bridge_list_t mBridgeList;
     buffer_map_t mBufferMap; //used by volume buffers to attempt to reuse vertex buffers
+    draw_batch_cache_t mDrawBatchCache; //used by volume buffers to skip sorting and batching unchanged faces
+    U32 mDrawBatchCacheNext = 0; //next entry of mDrawBatchCache to replace once it is full
 
     F32 mObjectBoxSize; //cached mObjectBounds[1].getLength3()
     U32 mGeometryBytes; //used by volumes to track how many bytes of geometry data are in this node
@@ -678,7 +699,12 @@ class LLVolumeGeometryManager: public LLGeometryManager
     virtual void rebuildMesh(LLSpatialGroup* group);
     virtual void getGeometry(LLSpatialGroup* group);
     virtual void addGeometryCount(LLSpatialGroup* group, U32& vertex_count, U32& index_count);
-    U32 genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace** faces, U32 face_count, bool distance_sort = false, bool batch_textures = false, bool rigged = false);
+    // if geometry_faces is not null, faces are appended to it instead of having their geometry copied
+    // into the new vertex buffers, see buildFaceGeometry()
+    U32 genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace** faces, U32 face_count, bool distance_sort = false, bool batch_textures = false, bool rigged = false,
+                    std::vector<LLFace*>* geometry_faces = nullptr);
+    // copy the geometry of the given faces into their vertex buffers, on the "General" thread pool where possible
+    void buildFaceGeometry(std::vector<LLFace*>& faces);
     void registerFace(LLSpatialGroup* group, LLFace* facep, U32 type);
 
 private:
@@ -58,7 +58,9 @@ public:
         NUM_CAMERAS
     } eCameraID;
 
-    static eCameraID sCurCameraID;
+    // camera being culled or rendered, per thread so that cameras can be
+    // culled concurrently (see LLPipeline::updateCullParallel())
+    static thread_local eCameraID sCurCameraID;
 
     bool updateCameraLocation(const LLVector3 &center,
                                 const LLVector3 &up_direction,
@@ -765,6 +765,22 @@ void LLViewerObjectList::updateApparentAngles(LLAgent &agent)
         max_value = llmin((S32) mObjects.size(), mCurLazyUpdateIndex + num_updates);
     }
 
+    { // update the pixel areas of the faces of visible volumes in one pass, updateTextures below uses the results
+        static std::vector<LLFace*> faces;
+        faces.clear();
+        for (i = mCurLazyUpdateIndex; i < max_value; i++)
+        {
+            objectp = mObjects[i];
+            if (!objectp->isDead() && objectp->getPCode() == LL_PCODE_VOLUME && !objectp->isHUDAttachment()
+                && objectp->mDrawable.notNull() && objectp->mDrawable->isVisible())
+            {
+                const LLDrawable::face_list_t& drawable_faces = objectp->mDrawable->getFaces();
+                faces.insert(faces.end(), drawable_faces.begin(), drawable_faces.end());
+            }
+        }
+        LLFace::calcPixelAreas(faces.data(), (U32) faces.size());
+    }
+
     // Iterate through some of the objects and lazy update their texture priorities
     for (i = mCurLazyUpdateIndex; i < max_value; i++)
     {
@@ -914,6 +930,9 @@ void LLViewerObjectList::update(LLAgent &agent)
 
     std::vector<LLViewerObject*>::iterator idle_end = idle_list.begin()+idle_count;
 
+    // avatars' motions are evaluated together once all objects have idled
+    LLVOAvatar::beginDeferredMotionUpdates();
+
     if (gSavedSettings.getBOOL("FreezeTime"))
     {
 
@@ -926,6 +945,8 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
             }
         }
+
+        LLVOAvatar::finishDeferredMotionUpdates();
     }
     else
     {
@@ -937,6 +958,8 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
         }
 
+        LLVOAvatar::finishDeferredMotionUpdates();
+
         //update flexible objects
         LLVolumeImplFlexible::updateClass();
 
@@ -39,6 +39,7 @@
 //-----------------------------------------------------------------------------------
 U32 LLViewerOctreeEntryData::sCurVisible = 10; //reserve the low numbers for special use.
 bool LLViewerOctreeDebug::sInDebug = false;
+bool LLViewerOctreePartition::sParallelCull = false;
 
 static LLTrace::CountStatHandle<S32> sOcclusionQueries("occlusion_queries", "Number of occlusion queries executed"),
                                      sNumObjectsOccluded("occluded_objects", "Count of objects being occluded by a query"),
@@ -460,7 +461,9 @@ LLViewerOctreeGroup::~LLViewerOctreeGroup()
 LLViewerOctreeGroup::LLViewerOctreeGroup(OctreeNode* node)
 :   mOctreeNode(node),
     mAnyVisible(0),
-    mState(CLEAN)
+    mState(CLEAN),
+    mBoundsRevision(0),
+    mFlatIndex(U32_MAX)
 {
     LLVector4a tmp;
     tmp.splat(0.f);
@@ -603,6 +606,7 @@ void LLViewerOctreeGroup::rebound()
     }
 
     clearState(DIRTY);
+    mBoundsRevision++;
 
     return;
 }
@@ -1296,6 +1300,131 @@ void LLOcclusionCullingGroup::doOcclusion(LLCamera* camera, const LLVector4a* sh
 //end of occulsion culling functions and classes
 //-------------------------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------------
+//class LLViewerOctreeFlatTree definitions
+//-----------------------------------------------------------------------------------
+LLViewerOctreeFlatTree::LLViewerOctreeFlatTree() :
+    mRoot(NULL),
+    mRevision(0)
+{
+}
+
+void LLViewerOctreeFlatTree::clear()
+{
+    mGroups.clear();
+    mParents.clear();
+    mBounds.clear();
+    mRoot = NULL;
+}
+
+bool LLViewerOctreeFlatTree::isCurrent(const LLViewerOctreeGroup* root) const
+{
+    return mRoot && mRoot == root && mRevision == root->getBoundsRevision();
+}
+
+U32 LLViewerOctreeFlatTree::addBlock(U32 parent)
+{
+    U32 first = (U32)mGroups.size();
+    mGroups.resize(first + 4, NULL);
+    mParents.push_back(parent);
+    return first;
+}
+
+void LLViewerOctreeFlatTree::build(const OctreeNode* root)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_OCTREE;
+    clear();
+
+    LLViewerOctreeGroup* root_group = (LLViewerOctreeGroup*)root->getListener(0);
+    llassert(root_group && !root_group->isDirty());
+    mRoot = root_group;
+    mRevision = root_group->getBoundsRevision();
+
+    addBlock(U32_MAX);
+    mGroups[0] = root_group;
+    root_group->mFlatIndex = 0;
+
+    //breadth first, mGroups grows as children get appended
+    for (U32 i = 0; i < mGroups.size(); i++)
+    {
+        LLViewerOctreeGroup* group = mGroups[i];
+        if (!group)
+        {
+            continue;
+        }
+
+        const OctreeNode* node = group->getOctreeNode();
+        U32 first = 0;
+        for (U32 c = 0; c < node->getChildCount(); c++)
+        {
+            if (c % 4 == 0)
+            {
+                first = addBlock(i);
+            }
+            LLViewerOctreeGroup* child = (LLViewerOctreeGroup*)node->getChild(c)->getListener(0);
+            mGroups[first + c % 4] = child;
+            child->mFlatIndex = first + c % 4;
+        }
+    }
+
+    U32 blocks = (U32)mParents.size();
+    mBounds.resize(blocks * 6);
+    for (U32 b = 0; b < blocks; b++)
+    {
+        F32 v[6][4];
+        for (U32 lane = 0; lane < 4; lane++)
+        {
+            const LLViewerOctreeGroup* group = mGroups[b * 4 + lane];
+            for (U32 axis = 0; axis < 3; axis++)
+            {
+                v[axis][lane] = group ? group->mBounds[0][axis] : 0.f;
+                v[axis + 3][lane] = group ? group->mBounds[1][axis] : 0.f;
+            }
+        }
+        for (U32 j = 0; j < 6; j++)
+        {
+            mBounds[b * 6 + j].loadua(v[j]);
+        }
+    }
+}
+
+void LLViewerOctreeFlatTree::cull(const LLCamera& camera, bool far_clip, bool region_space, std::vector<S8>& results) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_OCTREE;
+    U32 count = (U32)mGroups.size();
+    results.assign(count, -1);
+
+    //whether the traversal may test the children of each node: the node
+    //itself is partially in, or it is a SKIP_FRUSTUM_CHECK node, which passes
+    //its parent's partial result down untested.
+    std::vector<U8> test_children(count, 0);
+
+    //parents always come before their children
+    U32 blocks = (U32)mParents.size();
+    for (U32 b = 0; b < blocks; b++)
+    {
+        U32 parent = mParents[b];
+        if (parent != U32_MAX && !test_children[parent])
+        {
+            continue;
+        }
+
+        S32 res[4];
+        camera.AABBInFrustum4(&mBounds[b * 6], &mBounds[b * 6 + 3], res, far_clip, region_space);
+
+        for (U32 lane = 0; lane < 4; lane++)
+        {
+            U32 index = b * 4 + lane;
+            const LLViewerOctreeGroup* group = mGroups[index];
+            if (group)
+            {
+                results[index] = (S8)res[lane];
+                test_children[index] = res[lane] == 1 || group->hasState(LLViewerOctreeGroup::SKIP_FRUSTUM_CHECK);
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------------
 //class LLViewerOctreePartition definitions
 //-----------------------------------------------------------------------------------
@@ -1304,7 +1433,8 @@ LLViewerOctreePartition::LLViewerOctreePartition() :
     mOcclusionEnabled(true),
     mDrawableType(0),
     mLODSeed(0),
-    mLODPeriod(1)
+    mLODPeriod(1),
+    mLastCullRevision(0)
 {
     LLVector4a center, size;
     center.splat(0.f);
@@ -1320,6 +1450,7 @@ LLViewerOctreePartition::~LLViewerOctreePartition()
 
 void LLViewerOctreePartition::cleanup()
 {
+    mFlatTree.clear();
     delete mOctree;
     mOctree = nullptr;
 }
@@ -1329,6 +1460,54 @@ bool LLViewerOctreePartition::isOcclusionEnabled()
     return mOcclusionEnabled || LLPipeline::sUseOcclusion > 2;
 }
 
+const LLViewerOctreeFlatTree* LLViewerOctreePartition::getFlatTree(bool update)
+{
+    static LLCachedControl<bool> flat_cull(gSavedSettings, "OctreeFlatCull", true);
+
+    //other threads may be walking mFlatTree
+    update = update && !sParallelCull;
+
+    LLViewerOctreeGroup* root = mOctree ? (LLViewerOctreeGroup*)mOctree->getListener(0) : NULL;
+    if (!flat_cull || !root || root->isDirty() || mOctree->getChildCount() == 0)
+    {
+        if (update)
+        {
+            mFlatTree.clear();
+        }
+        return NULL;
+    }
+
+    if (!mFlatTree.isCurrent(root))
+    {
+        if (!update)
+        {
+            return NULL;
+        }
+
+        //don't bother flattening an octree that changes between every cull,
+        //wait until it settles
+        U32 revision = root->getBoundsRevision();
+        if (revision != mLastCullRevision)
+        {
+            mLastCullRevision = revision;
+            return NULL;
+        }
+        mFlatTree.build(mOctree);
+    }
+
+    return &mFlatTree;
+}
+
+void LLViewerOctreePartition::prepareCull()
+{
+    LLViewerOctreeGroup* root = mOctree ? (LLViewerOctreeGroup*)mOctree->getListener(0) : NULL;
+    if (root)
+    {
+        root->rebound();
+        getFlatTree();
+    }
+}
+
 
 //-----------------------------------------------------------------------------------
 //class LLViewerOctreeCull definitions
@@ -1368,11 +1547,30 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
     }
 }
 
+//result of the frustum check of group's bounds from the flat tree, -1 if not available
+S32 LLViewerOctreeCull::getFlatResult(const LLViewerOctreeGroup* group, bool far_clip, bool region_space)
+{
+    if (!mFlatTree)
+    {
+        return -1;
+    }
+
+    S32 mode = (far_clip ? 1 : 0) | (region_space ? 2 : 0);
+    if (mode != mFlatMode)
+    { //checks of the whole tree at once, on the first group tested
+        mFlatTree->cull(*mCamera, far_clip, region_space, mFlatResults);
+        mFlatMode = mode;
+    }
+
+    return mFlatTree->getResult(group, mFlatResults);
+}
+
 //------------------------------------------
 //agent space group culling
 S32 LLViewerOctreeCull::AABBInFrustumNoFarClipGroupBounds(const LLViewerOctreeGroup* group)
 {
-    return mCamera->AABBInFrustumNoFarClip(group->mBounds[0], group->mBounds[1]);
+    S32 res = getFlatResult(group, false, false);
+    return res >= 0 ? res : mCamera->AABBInFrustumNoFarClip(group->mBounds[0], group->mBounds[1]);
 }
 
 S32 LLViewerOctreeCull::AABBSphereIntersectGroupExtents(const LLViewerOctreeGroup* group)
@@ -1382,7 +1580,8 @@ S32 LLViewerOctreeCull::AABBSphereIntersectGroupExtents(const LLViewerOctreeGrou
 
 S32 LLViewerOctreeCull::AABBInFrustumGroupBounds(const LLViewerOctreeGroup* group)
 {
-    return mCamera->AABBInFrustum(group->mBounds[0], group->mBounds[1]);
+    S32 res = getFlatResult(group, true, false);
+    return res >= 0 ? res : mCamera->AABBInFrustum(group->mBounds[0], group->mBounds[1]);
 }
 //------------------------------------------
 
@@ -1408,12 +1607,14 @@ S32 LLViewerOctreeCull::AABBInFrustumObjectBounds(const LLViewerOctreeGroup* gro
 //local regional space group culling
 S32 LLViewerOctreeCull::AABBInRegionFrustumNoFarClipGroupBounds(const LLViewerOctreeGroup* group)
 {
-    return mCamera->AABBInRegionFrustumNoFarClip(group->mBounds[0], group->mBounds[1]);
+    S32 res = getFlatResult(group, false, true);
+    return res >= 0 ? res : mCamera->AABBInRegionFrustumNoFarClip(group->mBounds[0], group->mBounds[1]);
 }
 
 S32 LLViewerOctreeCull::AABBInRegionFrustumGroupBounds(const LLViewerOctreeGroup* group)
 {
-    return mCamera->AABBInRegionFrustum(group->mBounds[0], group->mBounds[1]);
+    S32 res = getFlatResult(group, true, true);
+    return res >= 0 ? res : mCamera->AABBInRegionFrustum(group->mBounds[0], group->mBounds[1]);
 }
 
 S32 LLViewerOctreeCull::AABBRegionSphereIntersectGroupExtents(const LLViewerOctreeGroup* group, const LLVector3& shift)
@@ -183,6 +183,7 @@ class LLViewerOctreeGroup
 {
     LL_ALIGN_NEW
     friend class LLViewerOctreeCull;
+    friend class LLViewerOctreeFlatTree;
 protected:
     virtual ~LLViewerOctreeGroup();
 
@@ -243,6 +244,7 @@ public:
     const LLVector4a* getExtents() const       {return mExtents;}
     const LLVector4a* getObjectBounds() const  {return mObjectBounds;}
     const LLVector4a* getObjectExtents() const {return mObjectExtents;}
+    U32 getBoundsRevision() const              {return mBoundsRevision;} //changes whenever rebound() or shift() moves mBounds
 
     //octree wrappers to make code more readable
     element_iter getDataBegin() { return mOctreeNode->getDataBegin(); }
@@ -267,6 +269,9 @@ protected:
     S32         mAnyVisible; //latest visible to any camera
     S32         mVisible[LLViewerCamera::NUM_CAMERAS];
 
+    U32         mBoundsRevision;
+    U32         mFlatIndex; //index in the LLViewerOctreeFlatTree of the partition, if any
+
 };//LL_ALIGN_POSTFIX(16);
 
 //octree group which has capability to support occlusion culling
@@ -342,6 +347,49 @@ public:
     static std::set<U32> sPendingQueries;
 };//LL_ALIGN_POSTFIX(16);
 
+//Copy of the group bounds of an octree laid out for LLCamera::AABBInFrustum4().
+//Nodes are stored breadth first with the children of each node next to each
+//other, starting on a block of four, and the bounds of each block of four are
+//kept as SoA vectors, so that culling tests four sibling groups at a time
+//from a flat array instead of one group at a time through the octree.
+class LLViewerOctreeFlatTree
+{
+public:
+    LLViewerOctreeFlatTree();
+
+    //rebuild from root, whose group bounds must be up to date (see LLViewerOctreeGroup::rebound())
+    void build(const OctreeNode* root);
+    void clear();
+
+    //true if built from root with its current bounds
+    bool isCurrent(const LLViewerOctreeGroup* root) const;
+    U32  getNodeCount() const { return (U32)mGroups.size(); }
+
+    //Frustum check of the bounds of every group a LLViewerOctreeCull traversal
+    //could test, as AABBInFrustum() or AABBInFrustumNoFarClip() on the agent or
+    //the region planes of camera.  Groups under a culled or fully visible parent
+    //are left at -1: the traversal only tests those if its own checks disagree
+    //with the frustum, e.g. LLOctreeCull clipping by distance.
+    void cull(const LLCamera& camera, bool far_clip, bool region_space, std::vector<S8>& results) const;
+
+    //result of cull() for group, -1 if none
+    S32  getResult(const LLViewerOctreeGroup* group, const std::vector<S8>& results) const
+    {
+        U32 index = group->mFlatIndex;
+        return index < mGroups.size() && mGroups[index] == group ? results[index] : -1;
+    }
+
+private:
+    U32 addBlock(U32 parent);
+
+private:
+    std::vector<LLViewerOctreeGroup*> mGroups;  //NULL in unused lanes
+    std::vector<U32>                  mParents; //index of the parent node of each block, U32_MAX for the root
+    std::vector<LLVector4a>           mBounds;  //per block: center x, y, z, then size x, y, z of the four groups
+    const LLViewerOctreeGroup*        mRoot;
+    U32                               mRevision;
+};
+
 class LLViewerOctreePartition
 {
 public:
@@ -352,6 +400,20 @@ public:
     virtual S32 cull(LLCamera &camera, bool do_occlusion) = 0;
     bool isOcclusionEnabled();
 
+    //mOctree flattened for LLViewerOctreeCull::setFlatTree(), NULL if disabled or
+    //if the octree changed since the last call.  Call after rebound() on the root.
+    //If !update or while sParallelCull, only returns the flat tree if it is
+    //already up to date.
+    const LLViewerOctreeFlatTree* getFlatTree(bool update = true);
+
+    //Bring the bounds of mOctree and its flat copy up to date, so that culls
+    //that follow only read the octree and may run on other threads.
+    void prepareCull();
+
+    //set while culls run concurrently (see LLPipeline::updateCullParallel()),
+    //nothing may rebuild or clear a flat tree then, not even the main thread
+    static bool sParallelCull;
+
 protected:
     // MUST call from destructor of any derived classes (SL-17276)
     void cleanup();
@@ -364,16 +426,23 @@ public:
     bool             mOcclusionEnabled; // if true, occlusion culling is performed
     U32              mLODSeed;
     U32              mLODPeriod;    //number of frames between LOD updates for a given spatial group (staggered by mLODSeed)
+
+private:
+    LLViewerOctreeFlatTree mFlatTree;
+    U32                    mLastCullRevision;
 };
 
 class LLViewerOctreeCull : public OctreeTraveler
 {
 public:
     LLViewerOctreeCull(LLCamera* camera)
-        : mCamera(camera), mRes(0) { }
+        : mCamera(camera), mRes(0), mFlatTree(NULL), mFlatMode(-1) { }
 
     virtual void traverse(const OctreeNode* n);
 
+    //use tree, if not NULL, for the group bounds frustum checks
+    void setFlatTree(const LLViewerOctreeFlatTree* tree) { mFlatTree = tree; mFlatMode = -1; }
+
 protected:
     virtual bool earlyFail(LLViewerOctreeGroup* group);
 
@@ -397,6 +466,8 @@ protected:
     S32 AABBInRegionFrustumObjectBounds(const LLViewerOctreeGroup* group);
     S32 AABBRegionSphereIntersectObjectExtents(const LLViewerOctreeGroup* group, const LLVector3& shift);
 
+    S32 getFlatResult(const LLViewerOctreeGroup* group, bool far_clip, bool region_space);
+
     virtual S32 frustumCheck(const LLViewerOctreeGroup* group) = 0;
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group) = 0;
 
@@ -409,6 +480,10 @@ protected:
 protected:
     LLCamera *mCamera;
     S32 mRes;
+
+    const LLViewerOctreeFlatTree* mFlatTree;
+    std::vector<S8> mFlatResults;
+    S32 mFlatMode;
 };
 
 //scan the octree, output the info of each node for debug use.
@@ -32,6 +32,7 @@
 #include "message.h"
 #include "llfloaterreg.h"
 #include "llmemory.h"
+#include "llframearena.h"
 #include "lltimer.h"
 
 #include "llappviewer.h"
@@ -239,7 +240,11 @@ LLTrace::SampleStatHandle<F64> NORMALIZED_FRAMTIME_JITTER_PERIOD("normalizedfram
 
 LLTrace::EventStatHandle<LLUnit<F64, LLUnits::Meters> > AGENT_POSITION_SNAP("agentpositionsnap", "agent position corrections");
 
-LLTrace::EventStatHandle<>  LOADING_WEARABLES_LONG_DELAY("loadingwearableslongdelay", "Wearables took too long to load");
+LLTrace::EventStatHandle<>  LOADING_WEARABLES_LONG_DELAY("loadingwearableslongdelay", "Wearables took too long to load"),
+                            DRAW_CALLS_PER_FRAME("drawcallsperframestat", "Number of draw calls issued by vertex buffers in a frame");
+
+LLTrace::EventStatHandle<F64Kilobytes >     FRAME_ARENA_BYTES("framearenabytesstat", "Memory requested by per-frame render containers in a frame"),
+                                            FRAME_ARENA_HEAP_BYTES("framearenaheapbytesstat", "Memory per-frame render containers took from the heap in a frame");
 
 LLTrace::EventStatHandle<F64Milliseconds >  REGION_CROSSING_TIME("regioncrossingtime", "CROSSING_AVG"),
                                                                 FRAME_STACKTIME("framestacktime", "FRAME_SECS"),
@@ -471,6 +476,13 @@ void update_statistics()
 
     record(LLStatViewer::TRIANGLES_DRAWN_PER_FRAME, last_frame_recording.getSum(LLStatViewer::TRIANGLES_DRAWN));
 
+    static U32 last_draw_call_count = 0;
+    record(LLStatViewer::DRAW_CALLS_PER_FRAME, (F64)(LLVertexBuffer::sDrawCallCount - last_draw_call_count));
+    last_draw_call_count = LLVertexBuffer::sDrawCallCount;
+
+    record(LLStatViewer::FRAME_ARENA_BYTES, F64Bytes((F64)LLFrameArena::sLastFrameBytes));
+    record(LLStatViewer::FRAME_ARENA_HEAP_BYTES, F64Bytes((F64)LLFrameArena::sLastFrameHeapBytes));
+
     sample(LLStatViewer::ENABLE_VBO,      (F64)gSavedSettings.getBOOL("RenderVBOEnable"));
     sample(LLStatViewer::DRAW_DISTANCE,   (F64)gSavedSettings.getF32("RenderFarClip"));
     sample(LLStatViewer::CHAT_BUBBLES,    gSavedSettings.getBOOL("UseChatBubbles"));
@@ -213,7 +213,11 @@ extern LLTrace::SampleStatHandle<F64Milliseconds >  FRAMETIME_JITTER,
 
 extern LLTrace::EventStatHandle<LLUnit<F64, LLUnits::Meters> > AGENT_POSITION_SNAP;
 
-extern LLTrace::EventStatHandle<>   LOADING_WEARABLES_LONG_DELAY;
+extern LLTrace::EventStatHandle<>   LOADING_WEARABLES_LONG_DELAY,
+                                    DRAW_CALLS_PER_FRAME;
+
+extern LLTrace::EventStatHandle<F64Kilobytes >  FRAME_ARENA_BYTES,
+                                                FRAME_ARENA_HEAP_BYTES;
 
 extern LLTrace::EventStatHandle<F64Milliseconds >   REGION_CROSSING_TIME,
                                                         FRAME_STACKTIME,
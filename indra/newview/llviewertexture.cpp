@@ -923,6 +923,7 @@ void LLViewerTexture::addFace(U32 ch, LLFace* facep)
     facep->setIndexInTex(ch, mNumFaces[ch]);
     mNumFaces[ch]++;
     mLastFaceListUpdateTimer.reset();
+    dirtyFaceStats();
 }
 
 //virtual
@@ -945,6 +946,16 @@ void LLViewerTexture::removeFace(U32 ch, LLFace* facep)
         mNumFaces[ch] = 0;
     }
     mLastFaceListUpdateTimer.reset();
+    dirtyFaceStats();
+}
+
+void LLViewerTexture::dirtyFaceStats()
+{
+    if (!mFaceStatsDirty)
+    {
+        mFaceStatsDirty = true;
+        gTextureList.queueFaceStatsUpdate(this);
+    }
 }
 
 S32 LLViewerTexture::getTotalNumFaces() const
@@ -156,6 +156,9 @@ public:
 
     virtual void addFace(U32 channel, LLFace* facep) ;
     virtual void removeFace(U32 channel, LLFace* facep) ;
+    // the faces using this texture were added, removed or changed size on screen, so
+    // LLViewerTextureList must walk them again to update the decode priority
+    void dirtyFaceStats();
     S32 getTotalNumFaces() const;
     S32 getNumFaces(U32 ch) const;
     const ll_face_list_t* getFaceList(U32 channel) const {llassert(channel < LLRender::NUM_TEXTURE_CHANNELS); return &mFaceList[channel];}
@@ -207,6 +210,17 @@ protected:
     U32               mNumFaces[LLRender::NUM_TEXTURE_CHANNELS];
     LLFrameTimer      mLastFaceListUpdateTimer ;
 
+    // result of the last face list walk in LLViewerTextureList::updateImageDecodePriority,
+    // reused until dirtyFaceStats() is called or the camera or discard bias change enough
+    F32               mFaceStatsVSize = 0.f;
+    bool              mFaceStatsOnScreen = false;
+    bool              mFaceStatsDirty = true;
+    F32               mFaceStatsBias = 0.f;
+    F32               mFaceStatsTime = 0.f;
+    F32               mFaceStatsNearDist = 0.f; // distance from the camera to the nearest face
+    LLVector3         mFaceStatsCameraOrigin;
+    LLVector3         mFaceStatsCameraAt;
+
     ll_volume_list_t  mVolumeList[LLRender::NUM_VOLUME_TEXTURE_CHANNELS];
     U32                 mNumVolumes[LLRender::NUM_VOLUME_TEXTURE_CHANNELS];
     LLFrameTimer      mLastVolumeListUpdateTimer;
@@ -49,6 +49,7 @@
 #include "lldrawpoolbump.h" // to init bumpmap images
 #include "lltexturecache.h"
 #include "lltexturefetch.h"
+#include "llviewercamera.h"
 #include "llviewercontrol.h"
 #include "llviewertexture.h"
 #include "llviewermedia.h"
@@ -895,119 +896,227 @@ void LLViewerTextureList::clearFetchingRequests()
 
 extern bool gCubeSnapshot;
 
-void LLViewerTextureList::updateImageDecodePriority(LLViewerFetchedTexture* imagep, bool flush_images)
+// textures with a discard bias at or below this are not downrezzed while on screen
+constexpr F32 FACE_STATS_BIAS_ON_SCREEN = 1.f;
+// textures on more faces than this are not checked face by face
+constexpr U32 MAX_FACE_STATS_FACES = 1024;
+
+static LLTrace::CountStatHandle<> sFaceStatsUpdates("texture_face_stats_updates", "Number of texture face lists walked to update decode priority");
+
+bool LLViewerTextureList::needsFaceStatsUpdate(const LLViewerFetchedTexture* imagep) const
 {
-    llassert(!gCubeSnapshot);
+    constexpr F32 MAX_FACE_STATS_AGE = 5.f;        // seconds
+    constexpr F32 CAMERA_MOVE_FRACTION = 0.1f;     // of the distance to the nearest face
+    constexpr F32 MIN_CAMERA_MOVE = 0.5f;          // meters
+    constexpr F32 MIN_CAMERA_AT_DOT = 0.985f;      // about 10 degrees of rotation
 
-    constexpr F32 BIAS_TRS_OUT_OF_SCREEN = 1.5f;
-    constexpr F32 BIAS_TRS_ON_SCREEN = 1.f;
+    if (imagep->mFaceStatsDirty ||
+        imagep->mFaceStatsBias != LLViewerTexture::sDesiredDiscardBias ||
+        LLViewerTexture::sCurrentTime - imagep->mFaceStatsTime > MAX_FACE_STATS_AGE)
+    {
+        return true;
+    }
 
-    if (imagep->getBoostLevel() < LLViewerFetchedTexture::BOOST_HIGH)  // don't bother checking face list for boosted textures
+    // pixel areas and importance to camera change with the camera, even if the faces don't
+    const LLViewerCamera* camera = LLViewerCamera::getInstance();
+    F32 max_move = llmax(imagep->mFaceStatsNearDist * CAMERA_MOVE_FRACTION, MIN_CAMERA_MOVE);
+    if (dist_vec_squared(camera->getOrigin(), imagep->mFaceStatsCameraOrigin) > max_move * max_move)
     {
-        static LLCachedControl<F32> texture_scale_min(gSavedSettings, "TextureScaleMinAreaFactor", 0.0095f);
-        static LLCachedControl<F32> texture_scale_max(gSavedSettings, "TextureScaleMaxAreaFactor", 25.f);
+        return true;
+    }
 
-        F32 max_vsize = 0.f;
-        bool on_screen = false;
+    return camera->getAtAxis() * imagep->mFaceStatsCameraAt < MIN_CAMERA_AT_DOT;
+}
 
-        U32 face_count = 0;
-        U32 max_faces_to_check = 1024;
+void LLViewerTextureList::updateFaceStats(LLViewerFetchedTexture* imagep)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
 
-        // get adjusted bias based on image resolution
-        LLImageGL* img = imagep->getGLTexture();
-        F32 max_discard = F32(img ? img->getMaxDiscardLevel() : MAX_DISCARD_LEVEL);
-        F32 bias = llclamp(max_discard - 2.f, 1.f, LLViewerTexture::sDesiredDiscardBias);
+    static LLCachedControl<F32> texture_scale_min(gSavedSettings, "TextureScaleMinAreaFactor", 0.0095f);
+    static LLCachedControl<F32> texture_scale_max(gSavedSettings, "TextureScaleMaxAreaFactor", 25.f);
 
-        // convert bias into a vsize scaler
-        bias = (F32) llroundf(powf(4, bias - 1.f));
+    LLViewerCamera* camera = LLViewerCamera::getInstance();
 
-        LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
-        for (U32 i = 0; i < LLRender::NUM_TEXTURE_CHANNELS; ++i)
+    F32 max_vsize = 0.f;
+    bool on_screen = false;
+    F32 near_dist = F32_MAX;
+
+    U32 face_count = 0;
+    U32 max_faces_to_check = MAX_FACE_STATS_FACES;
+
+    // get adjusted bias based on image resolution
+    LLImageGL* img = imagep->getGLTexture();
+    F32 max_discard = F32(img ? img->getMaxDiscardLevel() : MAX_DISCARD_LEVEL);
+    F32 bias = llclamp(max_discard - 2.f, 1.f, LLViewerTexture::sDesiredDiscardBias);
+
+    // convert bias into a vsize scaler
+    bias = (F32) llroundf(powf(4, bias - 1.f));
+
+    for (U32 i = 0; i < LLRender::NUM_TEXTURE_CHANNELS; ++i)
+    {
+        face_count += imagep->getNumFaces(i);
+        S32 faces_to_check = (face_count > max_faces_to_check) ? 0 : imagep->getNumFaces(i);
+
+        for (S32 fi = 0; fi < faces_to_check; ++fi)
         {
-            face_count += imagep->getNumFaces(i);
-            S32 faces_to_check = (face_count > max_faces_to_check) ? 0 : imagep->getNumFaces(i);
+            LLFace* face = (*(imagep->getFaceList(i)))[fi];
 
-            for (S32 fi = 0; fi < faces_to_check; ++fi)
+            if (face && face->getViewerObject())
             {
-                LLFace* face = (*(imagep->getFaceList(i)))[fi];
+                F32 radius;
+                F32 cos_angle_to_view_dir;
+
+                near_dist = llmin(near_dist, dist_vec(face->getPositionAgent(), camera->getOrigin()) - face->mBoundingSphereRadius);
 
-                if (face && face->getViewerObject())
+                if ((gFrameCount - face->mLastTextureUpdate) > 10)
+                { // only call calcPixelArea at most once every 10 frames for a given face
+                    // this helps eliminate redundant calls to calcPixelArea for faces that have multiple textures
+                    // assigned to them, such as is the case with GLTF materials or Blinn-Phong materials
+                    face->mInFrustum = face->calcPixelArea(cos_angle_to_view_dir, radius);
+                    face->mLastTextureUpdate = gFrameCount;
+                }
+
+                F32 vsize = face->getPixelArea();
+
+                on_screen |= face->mInFrustum;
+
+                // Scale desired texture resolution higher or lower depending on texture scale
+                //
+                // Minimum usage examples: a 1024x1024 texture with aplhabet (texture atlas),
+                // runing string shows one letter at a time. If texture has ten 100px symbols
+                // per side, minimal scale is (100/1024)^2 = 0.0095
+                //
+                // Maximum usage examples: huge chunk of terrain repeats texture
+                // TODO: make this work with the GLTF texture transforms
+                S32 te_offset = face->getTEOffset();  // offset is -1 if not inited
+                LLViewerObject* objp = face->getViewerObject();
+                const LLTextureEntry* te = (te_offset < 0 || te_offset >= objp->getNumTEs()) ? nullptr : objp->getTE(te_offset);
+                F32 min_scale = te ? llmin(fabsf(te->getScaleS()), fabsf(te->getScaleT())) : 1.f;
+                min_scale = llclamp(min_scale * min_scale, texture_scale_min(), texture_scale_max());
+                vsize /= min_scale;
+
+                // apply bias to offscreen faces all the time, but only to onscreen faces when bias is large
+                // use mImportanceToCamera to make bias switch a bit more gradual
+                if (!face->mInFrustum || LLViewerTexture::sDesiredDiscardBias > 1.9f + face->mImportanceToCamera / 2.f)
                 {
-                    F32 radius;
-                    F32 cos_angle_to_view_dir;
-
-                    if ((gFrameCount - face->mLastTextureUpdate) > 10)
-                    { // only call calcPixelArea at most once every 10 frames for a given face
-                        // this helps eliminate redundant calls to calcPixelArea for faces that have multiple textures
-                        // assigned to them, such as is the case with GLTF materials or Blinn-Phong materials
-                        face->mInFrustum = face->calcPixelArea(cos_angle_to_view_dir, radius);
-                        face->mLastTextureUpdate = gFrameCount;
-                    }
-
-                    F32 vsize = face->getPixelArea();
-
-                    on_screen |= face->mInFrustum;
-
-                    // Scale desired texture resolution higher or lower depending on texture scale
-                    //
-                    // Minimum usage examples: a 1024x1024 texture with aplhabet (texture atlas),
-                    // runing string shows one letter at a time. If texture has ten 100px symbols
-                    // per side, minimal scale is (100/1024)^2 = 0.0095
-                    //
-                    // Maximum usage examples: huge chunk of terrain repeats texture
-                    // TODO: make this work with the GLTF texture transforms
-                    S32 te_offset = face->getTEOffset();  // offset is -1 if not inited
-                    LLViewerObject* objp = face->getViewerObject();
-                    const LLTextureEntry* te = (te_offset < 0 || te_offset >= objp->getNumTEs()) ? nullptr : objp->getTE(te_offset);
-                    F32 min_scale = te ? llmin(fabsf(te->getScaleS()), fabsf(te->getScaleT())) : 1.f;
-                    min_scale = llclamp(min_scale * min_scale, texture_scale_min(), texture_scale_max());
-                    vsize /= min_scale;
-
-                    // apply bias to offscreen faces all the time, but only to onscreen faces when bias is large
-                    // use mImportanceToCamera to make bias switch a bit more gradual
-                    if (!face->mInFrustum || LLViewerTexture::sDesiredDiscardBias > 1.9f + face->mImportanceToCamera / 2.f)
-                    {
-                        vsize /= bias;
-                    }
-
-                    // boost resolution of textures that are important to the camera
-                    if (face->mInFrustum)
-                    {
-                        static LLCachedControl<F32> texture_camera_boost(gSavedSettings, "TextureCameraBoost", 8.f);
-                        vsize *= llmax(face->mImportanceToCamera*texture_camera_boost, 1.f);
-                    }
-
-                    max_vsize = llmax(max_vsize, vsize);
-
-                    // addTextureStats limits size to sMaxVirtualSize
-                    if (max_vsize >= LLViewerFetchedTexture::sMaxVirtualSize
-                        && (on_screen || LLViewerTexture::sDesiredDiscardBias <= BIAS_TRS_ON_SCREEN))
-                    {
-                        break;
-                    }
+                    vsize /= bias;
+                }
+
+                // boost resolution of textures that are important to the camera
+                if (face->mInFrustum)
+                {
+                    static LLCachedControl<F32> texture_camera_boost(gSavedSettings, "TextureCameraBoost", 8.f);
+                    vsize *= llmax(face->mImportanceToCamera*texture_camera_boost, 1.f);
+                }
+
+                max_vsize = llmax(max_vsize, vsize);
+
+                // addTextureStats limits size to sMaxVirtualSize
+                if (max_vsize >= LLViewerFetchedTexture::sMaxVirtualSize
+                    && (on_screen || LLViewerTexture::sDesiredDiscardBias <= FACE_STATS_BIAS_ON_SCREEN))
+                {
+                    break;
                 }
             }
+        }
+
+        if (max_vsize >= LLViewerFetchedTexture::sMaxVirtualSize
+            && (on_screen || LLViewerTexture::sDesiredDiscardBias <= FACE_STATS_BIAS_ON_SCREEN))
+        {
+            break;
+        }
+    }
+
+    if (face_count > max_faces_to_check)
+    { // this texture is used in so many places we should just boost it and not bother checking its vsize
+        // this is especially important because the above is not time sliced and can hit multiple ms for a single texture
+        max_vsize = MAX_IMAGE_AREA;
+    }
+
+    imagep->mFaceStatsVSize = max_vsize;
+    imagep->mFaceStatsOnScreen = on_screen;
+    imagep->mFaceStatsDirty = false;
+    imagep->mFaceStatsBias = LLViewerTexture::sDesiredDiscardBias;
+    imagep->mFaceStatsTime = LLViewerTexture::sCurrentTime;
+    imagep->mFaceStatsNearDist = llmax(near_dist, 0.f);
+    imagep->mFaceStatsCameraOrigin = camera->getOrigin();
+    imagep->mFaceStatsCameraAt = camera->getAtAxis();
+
+    add(sFaceStatsUpdates, 1);
+}
+
+void LLViewerTextureList::calcFacePixelAreas(const std::vector<LLPointer<LLViewerFetchedTexture> >& textures)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
+
+    static LLCachedControl<bool> incremental_priority(gSavedSettings, "TextureIncrementalPriority", true);
+
+    // same faces that updateFaceStats will look at
+    static std::vector<LLFace*> faces;
+    faces.clear();
+    for (LLViewerFetchedTexture* imagep : textures)
+    {
+        if (imagep->getBoostLevel() >= LLViewerFetchedTexture::BOOST_HIGH ||
+            (incremental_priority && !needsFaceStatsUpdate(imagep)))
+        {
+            continue;
+        }
 
-            if (max_vsize >= LLViewerFetchedTexture::sMaxVirtualSize
-                && (on_screen || LLViewerTexture::sDesiredDiscardBias <= BIAS_TRS_ON_SCREEN))
+        U32 face_count = 0;
+        for (U32 i = 0; i < LLRender::NUM_TEXTURE_CHANNELS; ++i)
+        {
+            face_count += imagep->getNumFaces(i);
+            if (face_count > MAX_FACE_STATS_FACES)
             {
                 break;
             }
+
+            const LLViewerTexture::ll_face_list_t* face_list = imagep->getFaceList(i);
+            for (U32 fi = 0; fi < imagep->getNumFaces(i); ++fi)
+            {
+                LLFace* face = (*face_list)[fi];
+                if (face && (gFrameCount - face->mLastTextureUpdate) > 10)
+                {
+                    faces.push_back(face);
+                }
+            }
         }
+    }
 
-        if (face_count > max_faces_to_check)
-        { // this texture is used in so many places we should just boost it and not bother checking its vsize
-            // this is especially important because the above is not time sliced and can hit multiple ms for a single texture
-            max_vsize = MAX_IMAGE_AREA;
+    LLFace::calcPixelAreas(faces.data(), (U32) faces.size());
+}
+
+void LLViewerTextureList::queueFaceStatsUpdate(LLViewerTexture* imagep)
+{
+    mFaceStatsQueue.push(LLTextureKey(imagep->getID(), (ETexListType)imagep->getTextureListType()));
+}
+
+void LLViewerTextureList::updateImageDecodePriority(LLViewerFetchedTexture* imagep, bool flush_images)
+{
+    llassert(!gCubeSnapshot);
+
+    constexpr F32 BIAS_TRS_OUT_OF_SCREEN = 1.5f;
+
+    if (imagep->getBoostLevel() < LLViewerFetchedTexture::BOOST_HIGH)  // don't bother checking face list for boosted textures
+    {
+        static LLCachedControl<bool> incremental_priority(gSavedSettings, "TextureIncrementalPriority", true);
+
+        LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
+        if (!incremental_priority || needsFaceStatsUpdate(imagep))
+        {
+            updateFaceStats(imagep);
         }
 
+        F32 max_vsize = imagep->mFaceStatsVSize;
+        bool on_screen = imagep->mFaceStatsOnScreen;
+
         if (imagep->getType() == LLViewerTexture::LOD_TEXTURE && imagep->getBoostLevel() == LLViewerTexture::BOOST_NONE)
         { // conditionally reset max virtual size for unboosted LOD_TEXTURES
           // this is an alternative to decaying mMaxVirtualSize over time
           // that keeps textures from continously downrezzing and uprezzing in the background
 
             if (LLViewerTexture::sDesiredDiscardBias > BIAS_TRS_OUT_OF_SCREEN ||
-                (!on_screen && LLViewerTexture::sDesiredDiscardBias > BIAS_TRS_ON_SCREEN))
+                (!on_screen && LLViewerTexture::sDesiredDiscardBias > FACE_STATS_BIAS_ON_SCREEN))
             {
                 imagep->mMaxVirtualSize = 0.f;
             }
@@ -1248,6 +1357,49 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
     }
     update_count = llmin(update_count, (U32) mUUIDMap.size());
 
+    LLTimer timer;
+
+    if (!mFaceStatsQueue.empty())
+    { // textures whose faces changed go ahead of their turn, up to as many as the round robin update below
+        LL_PROFILE_ZONE_NAMED_CATEGORY_TEXTURE("vtluift - face stats");
+
+        U32 queued_count = llmin(update_count, (U32) mFaceStatsQueue.size());
+        entries.reserve(queued_count);
+        while (queued_count-- > 0)
+        {
+            LLViewerFetchedTexture* imagep = findImage(mFaceStatsQueue.front());
+            mFaceStatsQueue.pop();
+
+            if (imagep && imagep->getGLTexture())
+            {
+                entries.push_back(imagep);
+            }
+        }
+
+        calcFacePixelAreas(entries);
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (timer.getElapsedTimeF32() > max_time)
+            { // out of time, the rest wait for the next frame
+                for (; i < entries.size(); ++i)
+                {
+                    mFaceStatsQueue.push(LLTextureKey(entries[i]->getID(), (ETexListType)entries[i]->getTextureListType()));
+                }
+                break;
+            }
+
+            LLViewerFetchedTexture* imagep = entries[i];
+            if (imagep->getNumRefs() > 1) // may have been deleted as a side effect of another update
+            {
+                updateImageDecodePriority(imagep);
+                imagep->updateFetch();
+            }
+        }
+
+        entries.clear();
+    }
+
     { // copy entries out of UUID map to avoid iterator invalidation from deletion inside updateImageDecodeProiroty or updateFetch below
         LL_PROFILE_ZONE_NAMED_CATEGORY_TEXTURE("vtluift - copy");
 
@@ -1269,7 +1421,7 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
         }
     }
 
-    LLTimer timer;
+    calcFacePixelAreas(entries);
 
     for (auto& imagep : entries)
     {
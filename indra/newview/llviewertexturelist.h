@@ -147,7 +147,17 @@ public:
     // - cleans up textures that haven't been referenced in awhile
     void updateImageDecodePriority(LLViewerFetchedTexture* imagep, bool flush_images = true);
 
+    // update the decode priority of imagep ahead of its turn, see LLViewerTexture::dirtyFaceStats()
+    void queueFaceStatsUpdate(LLViewerTexture* imagep);
+
 private:
+    // true if the faces using imagep must be walked again to update its decode priority
+    bool needsFaceStatsUpdate(const LLViewerFetchedTexture* imagep) const;
+    // walk the faces using imagep to find how much of it is needed
+    void updateFaceStats(LLViewerFetchedTexture* imagep);
+    // update the pixel areas of the faces updateFaceStats will walk for textures, in one batch
+    void calcFacePixelAreas(const std::vector<LLPointer<LLViewerFetchedTexture> >& textures);
+
     F32  updateImagesCreateTextures(F32 max_time);
     F32  updateImagesFetchTextures(F32 max_time);
     void updateImagesUpdateStats();
@@ -231,6 +241,9 @@ private:
     uuid_map_t mUUIDMap;
     LLTextureKey mLastUpdateKey;
 
+    // textures whose faces changed since their decode priority was last updated
+    std::queue<LLTextureKey> mFaceStatsQueue;
+
     image_list_t mImageList;
 
     // simply holds on to LLViewerFetchedTexture references to stop them from being purged too soon
@@ -52,6 +52,7 @@
 #include "llcallingcard.h"      // IDEVO for LLAvatarTracker
 #include "lldrawpoolavatar.h"
 #include "lldriverparam.h"
+#include "llpolymorph.h"
 #include "llpolyskeletaldistortion.h"
 #include "lleditingmotion.h"
 #include "llemote.h"
@@ -70,6 +71,7 @@
 #include "llmeshrepository.h"
 #include "llmutelist.h"
 #include "llmoveview.h"
+#include "llmutex.h"
 #include "llnotificationsutil.h"
 #include "llphysicsshapebuilderutil.h"
 #include "llquantize.h"
@@ -623,6 +625,8 @@ F32 LLVOAvatar::sGreyUpdateTime = 0.f;
 LLPointer<LLViewerTexture> LLVOAvatar::sCloudTexture = NULL;
 std::vector<LLUUID> LLVOAvatar::sAVsIgnoringARTLimit;
 S32 LLVOAvatar::sAvatarsNearby = 0;
+bool LLVOAvatar::sDeferMotionUpdates = false;
+std::vector<LLPointer<LLVOAvatar> > LLVOAvatar::sDeferredMotionAvatars;
 
 //-----------------------------------------------------------------------------
 // Helper functions
@@ -672,6 +676,8 @@ LLVOAvatar::LLVOAvatar(const LLUUID& id,
     mVisibilityRank(0),
     mNeedsSkin(false),
     mLastSkinTime(0.f),
+    mMotionUpdateDeferred(false),
+    mDeferredSitGroundConstrained(false),
     mUpdatePeriod(1),
     mOverallAppearance(AOA_INVISIBLE),
     mVisualComplexityStale(true),
@@ -2818,7 +2824,21 @@ void LLVOAvatar::idleUpdate(LLAgent &agent, const F64 &time)
     // store off last frame's root position to be consistent with camera position
     mLastRootPos = mRoot->getWorldPosition();
     bool detailed_update = updateCharacter(agent);
+    if (mMotionUpdateDeferred)
+    {
+        // finished by finishDeferredMotionUpdates()
+        return;
+    }
 
+    finishIdleUpdate(detailed_update);
+}
+
+//-----------------------------------------------------------------------------
+// finishIdleUpdate()
+// The part of idleUpdate() that runs after the character has been animated.
+//-----------------------------------------------------------------------------
+void LLVOAvatar::finishIdleUpdate(bool detailed_update)
+{
     static LLUICachedControl<bool> visualizers_in_calls("ShowVoiceVisualizersInCalls", false);
     bool voice_enabled = (visualizers_in_calls || LLVoiceClient::getInstance()->inProximalChannel()) &&
                          LLVoiceClient::getInstance()->getVoiceEnabled(mID);
@@ -2960,7 +2980,7 @@ void LLVOAvatar::idleUpdateVoiceVisualizer(bool voice_enabled, const LLVector3 &
                     if( mAahMorph ) mAahMorph->setWeight(mAahMorph->getMinWeight());
 
                     mLipSyncActive = false;
-                    LLCharacter::updateVisualParams();
+                    updateMorphedVisualParams();
                     dirtyMesh();
                 }
             }
@@ -2982,7 +3002,7 @@ void LLVOAvatar::idleUpdateMisc(bool detailed_update)
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     if (LLVOAvatar::sJointDebug)
     {
-        LL_INFOS() << getDebugName() << ": joint touches: " << LLJoint::sNumTouches << " updates: " << LLJoint::sNumUpdates << LL_ENDL;
+        LL_INFOS() << getDebugName() << ": joint touches: " << LLJoint::sNumTouches.load() << " updates: " << LLJoint::sNumUpdates.load() << LL_ENDL;
     }
 
     LLJoint::sNumUpdates = 0;
@@ -3172,6 +3192,8 @@ void LLVOAvatar::idleUpdateAppearanceAnimation()
             }
 
             // apply all params
+            static LLCachedControl<bool> batch_morphs(gSavedSettings, "AvatarBatchMorphs", true);
+            LLPolyMorphBatch morph_batch(batch_morphs);
             applyAllVisualParams(avatar_sex);
 
             mLastAppearanceBlendTime = appearance_anim_time;
@@ -3229,7 +3251,7 @@ void LLVOAvatar::idleUpdateLipSync(bool voice_enabled)
         }
 
         mLipSyncActive = true;
-        LLCharacter::updateVisualParams();
+        updateMorphedVisualParams();
         dirtyMesh();
     }
 }
@@ -3866,7 +3888,7 @@ void LLVOAvatar::slamPosition()
     {
         gPipeline.updateMoveNormalAsync(mDrawable);
     }
-    mRoot->updateWorldMatrixChildren();
+    updateSkeletonWorldMatrices();
 }
 
 bool LLVOAvatar::isVisuallyMuted()
@@ -4854,12 +4876,50 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     {
         updateMotions(LLCharacter::FORCE_UPDATE);
     }
+    else if (sDeferMotionUpdates && !isSelf() && !isUIAvatar())
+    {
+        // Evaluated in parallel with the other avatars' motions by
+        // finishDeferredMotionUpdates(), which also finishes this update.
+        mMotionUpdateDeferred = true;
+        mDeferredSitGroundConstrained = was_sit_ground_constrained;
+        sDeferredMotionAvatars.push_back(this);
+        return visible;
+    }
     else
     {
         // Might be better to do HIDDEN_UPDATE if cloud
         updateMotions(LLCharacter::NORMAL_UPDATE);
     }
 
+    finishUpdateCharacter(visible, was_sit_ground_constrained);
+
+    return visible;
+}
+
+//-----------------------------------------------------------------------------
+// finishUpdateCharacter()
+// The part of updateCharacter() that runs after the motions have been updated.
+//-----------------------------------------------------------------------------
+void LLVOAvatar::finishUpdateCharacter(bool visible, bool was_sit_ground_constrained)
+{
+    updatePoseAfterMotions(was_sit_ground_constrained);
+
+    // Update child joints as needed.
+    updateSkeletonWorldMatrices();
+
+    if (visible)
+    {
+        // System avatar mesh vertices need to be reskinned.
+        mNeedsSkin = true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// updatePoseAfterMotions()
+// Adjustments to the animated pose ahead of the skeleton update.
+//-----------------------------------------------------------------------------
+void LLVOAvatar::updatePoseAfterMotions(bool was_sit_ground_constrained)
+{
     // Special handling for sitting on ground.
     if (!getParent() && (isSitting() || was_sit_ground_constrained))
     {
@@ -4880,17 +4940,65 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
 
     // Generate footstep sounds when feet hit the ground
     updateFootstepSounds();
+}
 
-    // Update child joints as needed.
-    mRoot->updateWorldMatrixChildren();
+//-----------------------------------------------------------------------------
+// beginDeferredMotionUpdates()
+//-----------------------------------------------------------------------------
+// static
+void LLVOAvatar::beginDeferredMotionUpdates()
+{
+    static LLCachedControl<bool> parallel_motions(gSavedSettings, "AvatarParallelMotionUpdate", true);
+    sDeferMotionUpdates = parallel_motions;
+}
 
-    if (visible)
+//-----------------------------------------------------------------------------
+// finishDeferredMotionUpdates()
+//-----------------------------------------------------------------------------
+// static
+void LLVOAvatar::finishDeferredMotionUpdates()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+
+    sDeferMotionUpdates = false;
+    if (sDeferredMotionAvatars.empty())
     {
-        // System avatar mesh vertices need to be reskinned.
-        mNeedsSkin = true;
+        return;
     }
 
-    return visible;
+    std::vector<LLVOAvatar*> avatars;
+    std::vector<LLCharacter*> characters;
+    avatars.reserve(sDeferredMotionAvatars.size());
+    characters.reserve(sDeferredMotionAvatars.size());
+    for (LLVOAvatar* avatarp : sDeferredMotionAvatars)
+    {
+        if (!avatarp->isDead())
+        {
+            avatars.push_back(avatarp);
+            characters.push_back(avatarp);
+        }
+    }
+
+    LLCharacter::updateMotionsBatch(characters, LLCharacter::NORMAL_UPDATE);
+
+    // finishUpdateCharacter(), with the skeletons updated as one batch
+    for (LLVOAvatar* avatarp : avatars)
+    {
+        avatarp->updatePoseAfterMotions(avatarp->mDeferredSitGroundConstrained);
+    }
+    updateSkeletonWorldMatricesBatch(avatars);
+
+    for (LLVOAvatar* avatarp : sDeferredMotionAvatars)
+    {
+        avatarp->mMotionUpdateDeferred = false;
+        if (!avatarp->isDead())
+        {
+            // only visible avatars are deferred
+            avatarp->mNeedsSkin = true;
+            avatarp->finishIdleUpdate(true);
+        }
+    }
+    sDeferredMotionAvatars.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -4985,12 +5093,66 @@ void LLVOAvatar::debugBodySize() const
     LL_DEBUGS("Avatar") << "new_body_size " << new_body_size << LL_ENDL;
 }
 
+//------------------------------------------------------------------------
+// updateSkeletonWorldMatrices
+//------------------------------------------------------------------------
+void LLVOAvatar::updateSkeletonWorldMatrices()
+{
+    ++mSkeletonUpdateCount;
+
+    static LLCachedControl<bool> flat_skeleton(gSavedSettings, "AvatarFlatSkeletonUpdate", true);
+    if (flat_skeleton)
+    {
+        getFlatSkeleton().update();
+    }
+    else
+    {
+        mRoot->updateWorldMatrixChildren();
+    }
+}
+
+//------------------------------------------------------------------------
+// updateSkeletonWorldMatricesBatch
+//------------------------------------------------------------------------
+// static
+void LLVOAvatar::updateSkeletonWorldMatricesBatch(const std::vector<LLVOAvatar*>& avatars)
+{
+    static LLCachedControl<bool> flat_skeleton(gSavedSettings, "AvatarFlatSkeletonUpdate", true);
+    if (!flat_skeleton)
+    {
+        for (LLVOAvatar* avatarp : avatars)
+        {
+            avatarp->updateSkeletonWorldMatrices();
+        }
+        return;
+    }
+
+    std::vector<LLFlatSkeleton*> skeletons;
+    skeletons.reserve(avatars.size());
+    for (LLVOAvatar* avatarp : avatars)
+    {
+        ++avatarp->mSkeletonUpdateCount;
+        skeletons.push_back(&avatarp->getFlatSkeleton());
+    }
+    // no two avatars share joints
+    LLFlatSkeleton::updateBatch(skeletons);
+}
+
+LLFlatSkeleton& LLVOAvatar::getFlatSkeleton()
+{
+    if (mFlatSkeleton.getRoot() != mRoot)
+    {
+        mFlatSkeleton.setRoot(mRoot);
+    }
+    return mFlatSkeleton;
+}
+
 //------------------------------------------------------------------------
 // postPelvisSetRecalc
 //------------------------------------------------------------------------
 void LLVOAvatar::postPelvisSetRecalc()
 {
-    mRoot->updateWorldMatrixChildren();
+    updateSkeletonWorldMatrices();
     computeBodySize();
     dirtyMesh(2);
 }
@@ -7013,6 +7175,10 @@ LLVector3 LLVOAvatar::getCharacterAngularVelocity()
 //-----------------------------------------------------------------------------
 void LLVOAvatar::getGround(const LLVector3 &in_pos_agent, LLVector3 &out_pos_agent, LLVector3 &outNorm)
 {
+    // Motions may ask for the ground from the General thread pool (see
+    // finishDeferredMotionUpdates()), and the raycast is not thread safe.
+    static LLMutex ground_mutex;
+
     LLVector3d z_vec(0.0f, 0.0f, 1.0f);
     LLVector3d p0_global, p1_global;
 
@@ -7027,6 +7193,7 @@ void LLVOAvatar::getGround(const LLVector3 &in_pos_agent, LLVector3 &out_pos_age
     p1_global = gAgent.getPosGlobalFromAgent(in_pos_agent) - z_vec;
     LLViewerObject *obj;
     LLVector3d out_pos_global;
+    LLMutexLock lock(&ground_mutex);
     LLWorld::getInstance()->resolveStepHeightGlobal(this, p0_global, p1_global, out_pos_global, outNorm, &obj);
     out_pos_agent = gAgent.getPosAgentFromGlobal(out_pos_global);
 }
@@ -7208,19 +7375,29 @@ void LLVOAvatar::updateVisualParams()
         }
     }
 
-    LLCharacter::updateVisualParams();
+    updateMorphedVisualParams();
 
     if (mLastSkeletonSerialNum != mSkeletonSerialNum)
     {
         computeBodySize();
         mLastSkeletonSerialNum = mSkeletonSerialNum;
-        mRoot->updateWorldMatrixChildren();
+        updateSkeletonWorldMatrices();
     }
 
     dirtyMesh();
     updateHeadOffset();
 }
 
+//-----------------------------------------------------------------------------
+// updateMorphedVisualParams()
+//-----------------------------------------------------------------------------
+void LLVOAvatar::updateMorphedVisualParams()
+{
+    static LLCachedControl<bool> batch_morphs(gSavedSettings, "AvatarBatchMorphs", true);
+    LLPolyMorphBatch morph_batch(batch_morphs);
+    LLCharacter::updateVisualParams();
+}
+
 void LLVOAvatar::setCorrectedPixelArea(F32 area)
 {
     // We always want to look good to ourselves
@@ -7970,7 +8147,7 @@ void LLVOAvatar::sitOnObject(LLViewerObject *sit_object)
     mRoot->getXform()->setParent(&sit_object->mDrawable->mXform); // LLVOAvatar::sitOnObject
     // SL-315
     mRoot->setPosition(getPosition());
-    mRoot->updateWorldMatrixChildren();
+    updateSkeletonWorldMatrices();
 
     stopMotion(ANIM_AGENT_BODY_NOISE);
 
@@ -9976,11 +10153,12 @@ const LLVOAvatar::MatrixPaletteCache& LLVOAvatar::updateSkinInfoMatrixPalette(co
     U64 hash = skin->mHash;
     MatrixPaletteCache& entry = mMatrixPaletteCache[hash];
 
-    if (entry.mFrame != gFrameCount)
+    if (entry.mFrame != gFrameCount || entry.mSkeletonUpdate != mSkeletonUpdateCount)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
 
         entry.mFrame = gFrameCount;
+        entry.mSkeletonUpdate = mSkeletonUpdateCount;
 
         //build matrix palette
         U32 count = LLSkinningUtil::getMeshJointCount(skin);
@@ -40,6 +40,7 @@
 #include "lldrawpoolalpha.h"
 #include "llviewerobject.h"
 #include "llcharacter.h"
+#include "llflatskeleton.h"
 #include "llcontrol.h"
 #include "llviewerjointmesh.h"
 #include "llviewerjointattachment.h"
@@ -241,6 +242,10 @@ public:
     /*virtual*/ LLVector3d      getPosGlobalFromAgent(const LLVector3 &position);
     /*virtual*/ LLVector3       getPosAgentFromGlobal(const LLVector3d &position);
     virtual void                updateVisualParams();
+protected:
+    // LLCharacter::updateVisualParams(), applying the changed morph targets
+    // in one LLPolyMorphBatch
+    void                        updateMorphedVisualParams();
 
 /**                    Inherited
  **                                                                            **
@@ -276,6 +281,11 @@ public:
     virtual bool    computeNeedsUpdate();
     virtual bool    updateCharacter(LLAgent &agent);
     void            updateFootstepSounds();
+    // While deferred, visible avatars other than self queue their motion
+    // update from idleUpdate() instead of running it, and the queued avatars
+    // are animated in parallel and finished by finishDeferredMotionUpdates().
+    static void     beginDeferredMotionUpdates();
+    static void     finishDeferredMotionUpdates();
     void            computeUpdatePeriod();
     void            updateOrientation(LLAgent &agent, F32 speed, F32 delta_time);
     void            updateTimeStep();
@@ -349,6 +359,14 @@ public:
 
     LLVector3 idleCalcNameTagPosition(const LLVector3 &root_pos_last);
 
+private:
+    void            finishUpdateCharacter(bool visible, bool was_sit_ground_constrained);
+    void            updatePoseAfterMotions(bool was_sit_ground_constrained);
+    void            finishIdleUpdate(bool detailed_update);
+
+    static bool     sDeferMotionUpdates;
+    static std::vector<LLPointer<LLVOAvatar> > sDeferredMotionAvatars;
+
     //--------------------------------------------------------------------
     // Static preferences (controlled by user settings/menus)
     //--------------------------------------------------------------------
@@ -475,11 +493,23 @@ public:
     void                applyDefaultParams();
     void                resetSkeleton(bool reset_animations);
 
+    // Equivalent to mRoot->updateWorldMatrixChildren(), using the flattened
+    // skeleton when AvatarFlatSkeletonUpdate is enabled. Use this rather
+    // than calling mRoot directly, it also invalidates mMatrixPaletteCache.
+    void                updateSkeletonWorldMatrices();
+    // The same for many avatars, spread over the General thread pool
+    static void         updateSkeletonWorldMatricesBatch(const std::vector<LLVOAvatar*>& avatars);
+
     LLVector3           mCurRootToHeadOffset;
     LLVector3           mTargetRootToHeadOffset;
 
     S32                 mLastSkeletonSerialNum;
 
+private:
+    // with mRoot as its root
+    LLFlatSkeleton&     getFlatSkeleton();
+
+    LLFlatSkeleton      mFlatSkeleton;
 
 /**                    Skeleton
  **                                                                            **
@@ -565,6 +595,8 @@ private:
 
     bool        mNeedsSkin; // avatar has been animated and verts have not been updated
     F32         mLastSkinTime; //value of gFrameTimeSeconds at last skin update
+    bool        mMotionUpdateDeferred; // waiting for finishDeferredMotionUpdates()
+    bool        mDeferredSitGroundConstrained;
 
     S32         mUpdatePeriod;
     S32         mNumInitFaces; //number of faces generated when creating the avatar drawable, does not inculde splitted faces due to long vertex buffer.
@@ -827,6 +859,10 @@ public:
         // Last frame this entry was updated
         U32 mFrame;
 
+        // mSkeletonUpdateCount when this entry was updated, so that an entry
+        // built earlier in the frame is refreshed once the avatar animates
+        U32 mSkeletonUpdate;
+
         // List of Matrix4a's for this entry
         LLMeshSkinInfo::matrix_list_t mMatrixPalette;
 
@@ -834,7 +870,8 @@ public:
         std::vector<F32> mGLMp;
 
         MatrixPaletteCache() :
-            mFrame(gFrameCount - 1)
+            mFrame(gFrameCount - 1),
+            mSkeletonUpdate(0)
         {
         }
     };
@@ -848,6 +885,9 @@ public:
     typedef std::unordered_map<U64, MatrixPaletteCache> matrix_palette_cache_t;
     matrix_palette_cache_t mMatrixPaletteCache;
 
+    // incremented by updateSkeletonWorldMatrices()
+    U32 mSkeletonUpdateCount = 0;
+
 protected:
     void            releaseMeshData();
     virtual void restoreMeshData();
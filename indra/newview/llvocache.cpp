@@ -1057,6 +1057,7 @@ S32 LLVOCachePartition::cull(LLCamera &camera, bool do_occlusion)
     mFrontCull = true;
     LLVOCacheOctreeCull culler(&camera, mRegionp, region_agent, do_occlusion && use_object_cache_occlusion,
         LLVOCacheEntry::getSquaredPixelThreshold(mFrontCull), this);
+    culler.setFlatTree(getFlatTree());
     culler.traverse(mOctree);
 
     if(!sNeedsOcclusionCheck)
@@ -226,10 +226,20 @@ LLWebRTCVoiceClient::LLWebRTCVoiceClient() :
     mIsProcessingChannels(false),
     mIsCoroutineActive(false),
     mWebRTCPump("WebRTCClientPump"),
-    mWebRTCDeviceInterface(nullptr)
+    mWebRTCDeviceInterface(nullptr),
+    mDataChannel("WebRTCDataChannel")
 {
     sShuttingDown = false;
 
+    mDataChannel.listenTyped("LLWebRTCVoiceClient",
+        [](const DataMessage& message)
+        {
+            if (connectionPtr_t connection = message.mConnection.lock())
+            {
+                connection->OnDataReceivedImpl(message.mData, message.mBinary);
+            }
+        });
+
     mSpeakerVolume = 0.0;
 
     mVoiceVersion.serverVersion = "";
@@ -3052,7 +3062,12 @@ bool LLVoiceWebRTCConnection::connectionStateMachine()
 // llwebrtc callback
 void LLVoiceWebRTCConnection::OnDataReceived(const std::string& data, bool binary)
 {
-    LL::WorkQueue::postMaybe(mMainQueue, [=, this] { LLVoiceWebRTCConnection::OnDataReceivedImpl(data, binary); });
+    if (LLWebRTCVoiceClient::isShuttingDown())
+    {
+        return;
+    }
+    // the connection may be gone by the time the main thread gets to it
+    LLWebRTCVoiceClient::getInstance()->queueDataMessage({ weak_from_this(), data, binary });
 }
 
 //
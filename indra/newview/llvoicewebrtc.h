@@ -40,6 +40,7 @@ class LLWebRTCProtocolParser;
 #include "llcoros.h"
 #include "llparcel.h"
 #include "llmutelist.h"
+#include "lleventchannel.h"
 #include <queue>
 #include "boost/json.hpp"
 
@@ -79,6 +80,17 @@ public:
 
     static bool isShuttingDown() { return sShuttingDown; }
 
+    // A data channel message received on a WebRTC thread
+    struct DataMessage
+    {
+        std::weak_ptr<LLVoiceWebRTCConnection> mConnection;
+        std::string mData;
+        bool mBinary;
+    };
+    // Hand a data channel message to its connection on the main thread.
+    // Safe from any thread.
+    void queueDataMessage(DataMessage message) { mDataChannel.push(std::move(message)); }
+
     const LLVoiceVersionInfo& getVersion() override;
 
     void updateSettings() override; // call after loading settings and whenever they change
@@ -540,6 +552,9 @@ private:
     static bool sShuttingDown;
 
     LLEventMailDrop mWebRTCPump;
+
+    // data channel messages, delivered once per frame on "mainloop"
+    LLEventChannel<DataMessage> mDataChannel;
 };
 
 
@@ -0,0 +1,205 @@
+/**
+ * @file llvolumelodbatch.cpp
+ * @brief Detail level selection for many volumes at once
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llvolumelodbatch.h"
+
+#include "llvector4a.h"
+#include "llvolumemgr.h"
+#include "parallelfor.h"
+
+// objects per block of work for the general thread pool
+constexpr size_t LOD_BATCH_GRAIN = 4096;
+
+// ll_round(v, nearest) for four values that are not negative
+static inline LLVector4a round4(const LLVector4a& v, F32 nearest)
+{
+    LLVector4a scaled;
+    scaled.setMul(v, LLVector4a(1.f / nearest));
+    scaled.add(LLVector4a(0.5f));
+
+    // truncating is flooring for positive values, floats from 2^23 up
+    // (including the infinite tangent of an object at the camera) are whole
+    // numbers already and may not fit in an integer
+    LLVector4a floored(_mm_cvtepi32_ps(_mm_cvttps_epi32(scaled)));
+    floored.setSelectWithMask(scaled.lessThan(LLVector4a(8388608.f)), floored, scaled);
+
+    floored.mul(LLVector4a(nearest));
+    return floored;
+}
+
+void LLVolumeLODBatch::clear()
+{
+    mCount = 0;
+    mDistance.clear();
+    mRadius.clear();
+    mDetail.clear();
+    mChanges.clear();
+}
+
+U32 LLVolumeLODBatch::add(F32 distance, F32 radius, S32 detail)
+{
+    mDistance.push_back(distance);
+    mRadius.push_back(radius);
+    mDetail.push_back(detail);
+    return (U32) mCount++;
+}
+
+//static
+F32 LLVolumeLODBatch::adjustDistance(F32 distance, const Params& params)
+{
+    distance *= params.mDistanceFactor;
+
+    F32 rampDist = params.mRampDistance;
+
+    if (distance < rampDist)
+    {
+        // Boost LOD when you're REALLY close
+        distance *= 1.0f/rampDist;
+        distance *= distance;
+        distance *= rampDist;
+    }
+
+    distance *= F_PI/3.f;
+
+    return distance;
+}
+
+//static
+S32 LLVolumeLODBatch::computeDetail(F32 adjusted_distance, F32 radius, const Params& params)
+{
+    F32 distance = ll_round(adjusted_distance, 0.01f);
+    radius = ll_round(radius, 0.01f);
+
+    S32 cur_detail;
+    if (params.mDynamicLOD)
+    {
+        // We've got LOD in the profile, and in the twist.  Use radius.
+        F32 tan_angle = (params.mLODFactor*radius)/distance;
+        cur_detail = LLVolumeLODGroup::getDetailFromTan(ll_round(tan_angle, 0.01f));
+    }
+    else
+    {
+        cur_detail = llclamp((S32) (sqrtf(radius)*params.mLODFactor*4.f), 0, 3);
+    }
+    return cur_detail;
+}
+
+void LLVolumeLODBatch::compute(const Params& params)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    mChanges.clear();
+    if (mCount == 0)
+    {
+        return;
+    }
+
+    // pad the last block with an object that changes nothing
+    size_t padded = (mCount + 3) & ~3;
+    mDistance.resize(padded, 1.f);
+    mRadius.resize(padded, 1.f);
+    mDetail.resize(padded, 0);
+    mAdjustedDistance.resize(padded);
+    mNewDetail.resize(padded);
+
+    size_t num_blocks = padded / 4;
+    LL::parallelFor("General", num_blocks, LOD_BATCH_GRAIN / 4, [this, &params](size_t begin, size_t end)
+    {
+        computeBlocks(begin, end, params);
+    });
+
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        if (mNewDetail[i] != mDetail[i])
+        {
+            mChanges.push_back({ (U32) i, mNewDetail[i] });
+        }
+    }
+}
+
+void LLVolumeLODBatch::computeBlocks(size_t begin, size_t end, const Params& params)
+{
+    if (!params.mDynamicLOD)
+    {
+        for (size_t i = begin * 4; i < end * 4; ++i)
+        {
+            mAdjustedDistance[i] = adjustDistance(mDistance[i], params);
+            mNewDetail[i] = computeDetail(mAdjustedDistance[i], mRadius[i], params);
+        }
+        return;
+    }
+
+    const LLVector4a distance_factor(params.mDistanceFactor);
+    const LLVector4a ramp_dist(params.mRampDistance);
+    const LLVector4a inv_ramp_dist(1.0f / params.mRampDistance);
+    const LLVector4a angle_factor(F_PI/3.f);
+    const LLVector4a lod_factor(params.mLODFactor);
+
+    // getDetailFromTan() returns the first detail level whose threshold is not
+    // below the tangent, so the detail level is how many thresholds are below it
+    LLVector4a thresholds[LLVolumeLODGroup::NUM_LODS - 1];
+    for (S32 i = 0; i < LLVolumeLODGroup::NUM_LODS - 1; ++i)
+    {
+        thresholds[i].splat(LLVolumeLODGroup::getDetailThreshold(i));
+    }
+
+    for (size_t block = begin; block < end; ++block)
+    {
+        size_t i = block * 4;
+
+        LLVector4a distance;
+        distance.loadua(&mDistance[i]);
+        distance.mul(distance_factor);
+
+        // Boost LOD when you're REALLY close
+        LLVector4a boosted;
+        boosted.setMul(distance, inv_ramp_dist);
+        boosted.mul(boosted);
+        boosted.mul(ramp_dist);
+        distance.setSelectWithMask(distance.lessThan(ramp_dist), boosted, distance);
+
+        distance.mul(angle_factor);
+        _mm_storeu_ps(&mAdjustedDistance[i], distance);
+
+        LLVector4a radius;
+        radius.loadua(&mRadius[i]);
+
+        LLVector4a tan_angle;
+        tan_angle.setMul(round4(radius, 0.01f), lod_factor);
+        tan_angle.div(round4(distance, 0.01f));
+        tan_angle = round4(tan_angle, 0.01f);
+
+        __m128i detail = _mm_setzero_si128();
+        for (const LLVector4a& threshold : thresholds)
+        {
+            // each lane of the mask is -1 where the tangent is above the threshold
+            detail = _mm_sub_epi32(detail, _mm_castps_si128(tan_angle.greaterThan(threshold)));
+        }
+        _mm_storeu_si128((__m128i*) &mNewDetail[i], detail);
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file llvolumelodbatch.h
+ * @brief Detail level selection for many volumes at once
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVOLUMELODBATCH_H
+#define LL_LLVOLUMELODBATCH_H
+
+#include <vector>
+
+// Picks volume detail levels for many objects in one pass.  Objects are
+// added with their distance to the camera, LOD radius and current detail
+// level, then compute() runs the math of LLVOVolume::calcLOD() four objects
+// at a time, spreads large batches across the general thread pool, and lists
+// the objects whose detail level changed.
+class LLVolumeLODBatch
+{
+public:
+    struct Params
+    {
+        F32     mLODFactor = 1.f;       // LLVOVolume::sLODFactor, scaled for the field of view
+        F32     mDistanceFactor = 1.f;  // LLVOVolume::sDistanceFactor
+        F32     mRampDistance = 2.f;    // detail is boosted for objects closer than this
+        bool    mDynamicLOD = true;     // LLPipeline::sDynamicLOD
+    };
+
+    struct Change
+    {
+        U32     mIndex;     // as returned by add()
+        S32     mDetail;
+    };
+
+    void clear();
+
+    // returns the index of the object in this batch
+    U32 add(F32 distance, F32 radius, S32 detail);
+    U32 size() const { return (U32) mCount; }
+
+    void compute(const Params& params);
+
+    // objects whose detail level differs from the one they were added with, in index order
+    const std::vector<Change>& getChanges() const { return mChanges; }
+    // valid after compute()
+    S32 getDetail(U32 index) const { return mNewDetail[index]; }
+    F32 getAdjustedDistance(U32 index) const { return mAdjustedDistance[index]; }
+
+    // the math of compute() for one object: the camera distance adjusted for
+    // the distance factor and close ups, and the detail level at that distance
+    static F32 adjustDistance(F32 distance, const Params& params);
+    static S32 computeDetail(F32 adjusted_distance, F32 radius, const Params& params);
+
+private:
+    void computeBlocks(size_t begin, size_t end, const Params& params);
+
+    size_t              mCount = 0;
+    // padded to a multiple of four by compute()
+    std::vector<F32>    mDistance;
+    std::vector<F32>    mRadius;
+    std::vector<S32>    mDetail;
+    std::vector<F32>    mAdjustedDistance;
+    std::vector<S32>    mNewDetail;
+    std::vector<Change> mChanges;
+};
+
+#endif // LL_LLVOLUMELODBATCH_H
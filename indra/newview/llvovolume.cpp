@@ -89,6 +89,8 @@
 #include "llavatarappearancedefines.h"
 #include "llgltfmateriallist.h"
 #include "gltfscenemanager.h"
+#include "parallelfor.h"
+#include "hbxxh.h"
 
 const F32 FORCE_SIMPLE_RENDER_AREA = 512.f;
 const F32 FORCE_CULL_AREA = 8.f;
@@ -1396,22 +1398,6 @@ void LLVOVolume::sculpt()
     }
 }
 
-S32 LLVOVolume::computeLODDetail(F32 distance, F32 radius, F32 lod_factor)
-{
-    S32 cur_detail;
-    if (LLPipeline::sDynamicLOD)
-    {
-        // We've got LOD in the profile, and in the twist.  Use radius.
-        F32 tan_angle = (lod_factor*radius)/distance;
-        cur_detail = LLVolumeLODGroup::getDetailFromTan(ll_round(tan_angle, 0.01f));
-    }
-    else
-    {
-        cur_detail = llclamp((S32) (sqrtf(radius)*lod_factor*4.f), 0, 3);
-    }
-    return cur_detail;
-}
-
 std::string get_debug_object_lod_text(LLVOVolume *rootp)
 {
     std::string cam_dist_string = "";
@@ -1452,7 +1438,25 @@ std::string get_debug_object_lod_text(LLVOVolume *rootp)
     return result;
 }
 
-bool LLVOVolume::calcLOD()
+//static
+LLVolumeLODBatch::Params LLVOVolume::getLODParams()
+{
+    LLVolumeLODBatch::Params params;
+    params.mLODFactor = LLVOVolume::sLODFactor;
+    params.mDistanceFactor = sDistanceFactor;
+    params.mRampDistance = LLVOVolume::sLODFactor * 2;
+    params.mDynamicLOD = LLPipeline::sDynamicLOD;
+
+    static LLCachedControl<bool> ignore_fov_zoom(gSavedSettings,"IgnoreFOVZoomForLODs");
+    if(!ignore_fov_zoom)
+    {
+        params.mLODFactor *= DEFAULT_FIELD_OF_VIEW / LLViewerCamera::getInstance()->getDefaultFOV();
+    }
+
+    return params;
+}
+
+bool LLVOVolume::getLODInputs(F32& distance, F32& radius)
 {
     if (mDrawable.isNull())
     {
@@ -1465,12 +1469,6 @@ bool LLVOVolume::calcLOD()
         return false;
     }
 
-    S32 cur_detail = 0;
-
-    F32 radius;
-    F32 distance;
-    F32 lod_factor = LLVOVolume::sLODFactor;
-
     if (mDrawable->isState(LLDrawable::RIGGED))
     {
         LLVOAvatar* avatar = getAvatar();
@@ -1543,29 +1541,11 @@ bool LLVOVolume::calcLOD()
         }
     }
 
-    distance *= sDistanceFactor;
-
-    F32 rampDist = LLVOVolume::sLODFactor * 2;
-
-    if (distance < rampDist)
-    {
-        // Boost LOD when you're REALLY close
-        distance *= 1.0f/rampDist;
-        distance *= distance;
-        distance *= rampDist;
-    }
-
-
-    distance *= F_PI/3.f;
-
-    static LLCachedControl<bool> ignore_fov_zoom(gSavedSettings,"IgnoreFOVZoomForLODs");
-    if(!ignore_fov_zoom)
-    {
-        lod_factor *= DEFAULT_FIELD_OF_VIEW / LLViewerCamera::getInstance()->getDefaultFOV();
-    }
-
-    mLODAdjustedDistance = distance;
+    return true;
+}
 
+bool LLVOVolume::applyLODDetail(S32 cur_detail)
+{
     static LLCachedControl<S32> debug_selection_lods(gSavedSettings, "DebugSelectionLODs", 0);
     if (isHUDAttachment())
     {
@@ -1576,10 +1556,6 @@ bool LLVOVolume::calcLOD()
     {
         cur_detail = llmin(debug_selection_lods(), 3);
     }
-    else
-    {
-        cur_detail = computeLODDetail(ll_round(distance, 0.01f), ll_round(radius, 0.01f), lod_factor);
-    }
 
     if (gPipeline.hasRenderDebugMask(LLPipeline::RENDER_DEBUG_TRIANGLE_COUNT) && mDrawable->getFace(0))
     {
@@ -1608,6 +1584,91 @@ bool LLVOVolume::calcLOD()
     return false;
 }
 
+
+bool LLVOVolume::calcLOD()
+{
+    F32 radius;
+    F32 distance;
+    if (!getLODInputs(distance, radius))
+    {
+        return false;
+    }
+
+    LLVolumeLODBatch::Params params = getLODParams();
+    mLODAdjustedDistance = LLVolumeLODBatch::adjustDistance(distance, params);
+
+    return applyLODDetail(LLVolumeLODBatch::computeDetail(mLODAdjustedDistance, radius, params));
+}
+
+// LOD selection queued by updateLOD() while a batch is open
+static LLVolumeLODBatch sLODBatch;
+static std::vector<LLPointer<LLVOVolume> > sLODBatchVolumes;
+static bool sLODBatchOpen = false;
+
+//static
+void LLVOVolume::beginLODBatch()
+{
+    static LLCachedControl<bool> parallel_lod(gSavedSettings, "RenderParallelLOD", true);
+    sLODBatchOpen = parallel_lod;
+}
+
+//static
+void LLVOVolume::endLODBatch()
+{
+    if (!sLODBatchOpen)
+    {
+        return;
+    }
+    sLODBatchOpen = false;
+
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    sLODBatch.compute(getLODParams());
+
+    // calcLOD() updates the adjusted distance whether or not the detail changes
+    for (U32 i = 0; i < (U32)sLODBatchVolumes.size(); ++i)
+    {
+        sLODBatchVolumes[i]->mLODAdjustedDistance = sLODBatch.getAdjustedDistance(i);
+    }
+
+    for (const LLVolumeLODBatch::Change& change : sLODBatch.getChanges())
+    {
+        LLVOVolume* volume = sLODBatchVolumes[change.mIndex];
+        if (!volume->isDead() && volume->mDrawable.notNull())
+        {
+            if (volume->applyLODDetail(change.mDetail))
+            {
+                gPipeline.markRebuild(volume->mDrawable, LLDrawable::REBUILD_VOLUME);
+                volume->mLODChanged = true;
+            }
+        }
+    }
+
+    sLODBatch.clear();
+    sLODBatchVolumes.clear();
+}
+
+bool LLVOVolume::canBatchLOD()
+{
+    // objects whose detail level is overridden or shown in debug text are done one at a time
+    static LLCachedControl<bool> debug_lods(gSavedSettings, "DebugObjectLODs", false);
+    static LLCachedControl<S32> debug_selection_lods(gSavedSettings, "DebugSelectionLODs", 0);
+    return !debug_lods
+        && !isHUDAttachment()
+        && !(isSelected() && debug_selection_lods() >= 0)
+        && !gPipeline.hasRenderDebugMask(LLPipeline::RENDER_DEBUG_TRIANGLE_COUNT | LLPipeline::RENDER_DEBUG_LOD_INFO);
+}
+
+void LLVOVolume::checkBinRadius()
+{
+    F32 new_radius = getBinRadius();
+    F32 old_radius = mDrawable->getBinRadius();
+    if (new_radius < old_radius * 0.9f || new_radius > old_radius*1.1f)
+    {
+        gPipeline.markPartitionMove(mDrawable);
+    }
+}
+
 bool LLVOVolume::updateLOD()
 {
     if (mDrawable.isNull())
@@ -1619,15 +1680,29 @@ bool LLVOVolume::updateLOD()
 
     bool lod_changed = false;
 
-    if (!LLSculptIDSize::instance().isUnloaded(getVolume()->getParams().getSculptID()))
+    if (LLSculptIDSize::instance().isUnloaded(getVolume()->getParams().getSculptID()))
     {
-        lod_changed = calcLOD();
+        return false;
     }
-    else
+
+    if (sLODBatchOpen && canBatchLOD())
     {
+        F32 radius;
+        F32 distance;
+        if (getLODInputs(distance, radius))
+        {
+            sLODBatch.add(distance, radius, mLOD);
+            sLODBatchVolumes.push_back(this);
+        }
+
+        // the bin radius does not depend on the detail level, check it now
+        // rather than revisiting every object when the batch ends
+        checkBinRadius();
         return false;
     }
 
+    lod_changed = calcLOD();
+
     if (lod_changed)
     {
         gPipeline.markRebuild(mDrawable, LLDrawable::REBUILD_VOLUME);
@@ -1635,12 +1710,7 @@ bool LLVOVolume::updateLOD()
     }
     else
     {
-        F32 new_radius = getBinRadius();
-        F32 old_radius = mDrawable->getBinRadius();
-        if (new_radius < old_radius * 0.9f || new_radius > old_radius*1.1f)
-        {
-            gPipeline.markPartitionMove(mDrawable);
-        }
+        checkBinRadius();
     }
 
     lod_changed = lod_changed || LLViewerObject::updateLOD();
@@ -4999,12 +5069,15 @@ void LLRiggedVolume::update(
     }
 
 
-    //build matrix palette
-    static const size_t kMaxJoints = LL_MAX_JOINTS_PER_MESH_OBJECT;
-
-    LLMatrix4a mat[kMaxJoints];
-    U32 maxJoints = LLSkinningUtil::getMeshJointCount(skin);
-    LLSkinningUtil::initSkinningMatrixPalette(mat, maxJoints, skin, avatar);
+    // matrix palette, cached by the avatar per skin for the current pose so
+    // faces and objects sharing the skin (and rendering) build it only once
+    const LLVOAvatar::MatrixPaletteCache& palette = avatar->updateSkinInfoMatrixPalette(skin);
+    if (palette.mMatrixPalette.empty())
+    {
+        return;
+    }
+    const LLMatrix4a* mat = palette.mMatrixPalette.data();
+    U32 maxJoints = (U32)palette.mMatrixPalette.size();
     const LLMatrix4a bind_shape_matrix = skin->mBindShapeMatrix;
 
     S32 rigged_vert_count = 0;
@@ -5043,10 +5116,13 @@ void LLRiggedVolume::update(
 
             if (pos && dst_face.mExtents)
             {
-                U32 max_joints = LLSkinningUtil::getMaxJointCount();
                 rigged_vert_count += dst_face.mNumVertices;
                 rigged_face_count++;
 
+                // VFExtents change
+                LLVector4a& min = dst_face.mExtents[0];
+                LLVector4a& max = dst_face.mExtents[1];
+
             #if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
                 if (vol_face.mJointIndices) // fast path with preconditioned joint indices
                 {
@@ -5067,43 +5143,30 @@ void LLRiggedVolume::update(
                         final_mat.affineTransform(t, dst);
                         pos[j] = dst;
                     }
+
+                    min = pos[0];
+                    max = pos[0];
+                    for (S32 j = 1; j < dst_face.mNumVertices; ++j)
+                    {
+                        min.setMin(min, pos[j]);
+                        max.setMax(max, pos[j]);
+                    }
                 }
                 else
             #endif
                 {
-                    for (S32 j = 0; j < dst_face.mNumVertices; ++j)
-                    {
-                        LLMatrix4a final_mat;
-                        LLSkinningUtil::getPerVertexSkinMatrix(weight[j].getF32ptr(), mat, false, final_mat, max_joints);
-
-                        LLVector4a& v = vol_face.mPositions[j];
-                        LLVector4a t;
-                        LLVector4a dst;
-                        bind_shape_matrix.affineTransform(v, t);
-                        final_mat.affineTransform(t, dst);
-                        pos[j] = dst;
-                    }
+                    // skins the face and updates its bounding box
+                    LLSkinningUtil::skinPositions(mat, maxJoints, bind_shape_matrix, weight, vol_face.mPositions,
+                                                  dst_face.mNumVertices, pos, dst_face.mExtents);
                 }
 
                 //update bounding box
-                // VFExtents change
-                LLVector4a& min = dst_face.mExtents[0];
-                LLVector4a& max = dst_face.mExtents[1];
-
-                min = pos[0];
-                max = pos[1];
                 if (i==0)
                 {
                     box_min = min;
                     box_max = max;
                 }
 
-                for (S32 j = 1; j < dst_face.mNumVertices; ++j)
-                {
-                    min.setMin(min, pos[j]);
-                    max.setMax(max, pos[j]);
-                }
-
                 box_min.setMin(min,box_min);
                 box_max.setMax(max,box_max);
 
@@ -5211,6 +5274,11 @@ bool can_batch_texture(LLFace* facep)
 }
 
 const static U32 MAX_FACE_COUNT = 4096U;
+static LLTrace::CountStatHandle<> sGroupsRebuilt("geom_groups_rebuilt", "Number of spatial groups whose geometry was rebuilt");
+static LLTrace::CountStatHandle<> sDrawBatchCacheHits("draw_batch_cache_hits", "Number of face lists whose sorting and batching was reused from an earlier rebuild");
+static LLTrace::CountStatHandle<> sDrawBatchCacheMisses("draw_batch_cache_misses", "Number of face lists that had to be sorted and batched");
+// layouts kept per spatial group, enough for every face list of a group to flip between two states
+const static U32 DRAW_BATCH_CACHE_SIZE = 16;
 int32_t LLVolumeGeometryManager::sInstanceCount = 0;
 LLFace** LLVolumeGeometryManager::sFullbrightFaces[2] = { NULL };
 LLFace** LLVolumeGeometryManager::sBumpFaces[2] = { NULL };
@@ -6088,22 +6156,33 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
     U32 extra_mask = LLVertexBuffer::MAP_TEXTURE_INDEX;
     bool alpha_sort = true;
     bool rigged = false;
+
+    // with RenderParallelGeometry, face geometry is copied into the vertex buffers once they are all allocated
+    static LLCachedControl<bool> parallel_geometry(gSavedSettings, "RenderParallelGeometry", true);
+    static std::vector<LLFace*> geometry_faces;
+    std::vector<LLFace*>* deferred_faces = parallel_geometry ? &geometry_faces : nullptr;
+
     for (int i = 0; i < 2; ++i) //two sets, static and rigged)
     {
-        geometryBytes += genDrawInfo(group, simple_mask | extra_mask, sSimpleFaces[i], simple_count[i], false, batch_textures, rigged);
-        geometryBytes += genDrawInfo(group, fullbright_mask | extra_mask, sFullbrightFaces[i], fullbright_count[i], false, batch_textures, rigged);
-        geometryBytes += genDrawInfo(group, alpha_mask | extra_mask, sAlphaFaces[i], alpha_count[i], alpha_sort, batch_textures, rigged);
-        geometryBytes += genDrawInfo(group, bump_mask | extra_mask, sBumpFaces[i], bump_count[i], false, false, rigged);
-        geometryBytes += genDrawInfo(group, norm_mask | extra_mask, sNormFaces[i], norm_count[i], false, false, rigged);
-        geometryBytes += genDrawInfo(group, spec_mask | extra_mask, sSpecFaces[i], spec_count[i], false, false, rigged);
-        geometryBytes += genDrawInfo(group, normspec_mask | extra_mask, sNormSpecFaces[i], normspec_count[i], false, false, rigged);
-        geometryBytes += genDrawInfo(group, pbr_mask | extra_mask, sPbrFaces[i], pbr_count[i], false, false, rigged);
+        geometryBytes += genDrawInfo(group, simple_mask | extra_mask, sSimpleFaces[i], simple_count[i], false, batch_textures, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, fullbright_mask | extra_mask, sFullbrightFaces[i], fullbright_count[i], false, batch_textures, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, alpha_mask | extra_mask, sAlphaFaces[i], alpha_count[i], alpha_sort, batch_textures, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, bump_mask | extra_mask, sBumpFaces[i], bump_count[i], false, false, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, norm_mask | extra_mask, sNormFaces[i], norm_count[i], false, false, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, spec_mask | extra_mask, sSpecFaces[i], spec_count[i], false, false, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, normspec_mask | extra_mask, sNormSpecFaces[i], normspec_count[i], false, false, rigged, deferred_faces);
+        geometryBytes += genDrawInfo(group, pbr_mask | extra_mask, sPbrFaces[i], pbr_count[i], false, false, rigged, deferred_faces);
 
         // for rigged set, add weights and disable alpha sorting (rigged items use depth buffer)
         extra_mask |= LLVertexBuffer::MAP_WEIGHT4;
         rigged = true;
     }
 
+    if (deferred_faces)
+    {
+        buildFaceGeometry(geometry_faces);
+    }
+
     group->mGeometryBytes = geometryBytes;
 
     {
@@ -6121,6 +6200,8 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
     group->mLastUpdateTime = gFrameTimeSeconds;
     group->mBuilt = 1.f;
     group->clearState(LLSpatialGroup::GEOM_DIRTY | LLSpatialGroup::ALPHA_DIRTY);
+
+    add(sGroupsRebuilt, 1);
 }
 
 void LLVolumeGeometryManager::rebuildMesh(LLSpatialGroup* group)
@@ -6259,7 +6340,135 @@ struct CompareBatchBreakerRigged
     }
 };
 
-U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace** faces, U32 face_count, bool distance_sort, bool batch_textures, bool rigged)
+// hash of everything genDrawInfo() looks at to sort faces and split them into batches
+static U64 draw_batch_hash(U32 mask, LLFace* const* faces, U32 face_count, bool batch_textures, bool rigged,
+                           U32 max_vertices, S32 texture_index_channels)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    struct FaceKey
+    {
+        const LLFace*           mFace;
+        const LLViewerTexture*  mTexture;
+        const LLVOAvatar*       mAvatar;
+        U64                     mSkinHash;
+        U64                     mMaterialID;
+        U32                     mDrawOrderIndex;
+        U32                     mGeomCount;
+        U32                     mIndicesCount;
+        U8                      mBumpmap;
+        U8                      mFullbright;
+        U8                      mShiny;
+        U8                      mCanBatch;
+    };
+
+    HBXXH64 hash;
+    U32 params[] = { mask, face_count, batch_textures, rigged, max_vertices, (U32)texture_index_channels, LLPipeline::sTextureBindTest };
+    hash.update(params, sizeof(params));
+
+    FaceKey key;
+    memset(&key, 0, sizeof(key)); // no uninitialized padding in the hash
+    for (U32 i = 0; i < face_count; ++i)
+    {
+        LLFace* facep = faces[i];
+        const LLTextureEntry* te = facep->getTextureEntry();
+        key.mFace = facep;
+        key.mTexture = facep->getTexture();
+        key.mAvatar = rigged ? facep->mAvatar : nullptr;
+        key.mSkinHash = rigged ? facep->getSkinHash() : 0;
+        key.mMaterialID = te->getMaterialID().getDigest64();
+        key.mDrawOrderIndex = facep->getDrawOrderIndex();
+        key.mGeomCount = facep->getGeomCount();
+        key.mIndicesCount = facep->getIndicesCount();
+        key.mBumpmap = te->getBumpmap();
+        key.mFullbright = te->getFullbright();
+        key.mShiny = te->getShiny();
+        key.mCanBatch = batch_textures && can_batch_texture(facep);
+        hash.update(&key, sizeof(key));
+    }
+
+    return hash.digest();
+}
+
+// copy face geometry into its vertex buffer
+static void get_face_geometry(LLFace* facep)
+{
+    LLDrawable* drawablep = facep->getDrawable();
+    LLVOVolume* vobj = drawablep->getVOVolume();
+    LLVolume* volume = vobj->getVolume();
+
+    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+    {
+        vobj->updateRelativeXform(true);
+    }
+
+    U32 te_idx = facep->getTEOffset();
+
+    if (!facep->getGeometryVolume(*volume, te_idx,
+        vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), facep->getGeomIndex(), true))
+    {
+        LL_WARNS() << "Failed to get geometry for face!" << LL_ENDL;
+    }
+
+    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
+    {
+        vobj->updateRelativeXform(false);
+    }
+}
+
+void LLVolumeGeometryManager::buildFaceGeometry(std::vector<LLFace*>& faces)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    // faces that touch more than their own range of their vertex buffer are
+    // built on this thread once the others are done
+    static std::vector<LLFace*> serial_faces;
+    serial_faces.clear();
+
+    U32 count = 0;
+    for (LLFace* facep : faces)
+    {
+        if (facep->prepareGeometryOffThread())
+        {
+            faces[count++] = facep;
+        }
+        else
+        {
+            serial_faces.push_back(facep);
+        }
+    }
+    faces.resize(count);
+
+    constexpr U32 FACES_PER_TASK = 16;
+    if (count > FACES_PER_TASK)
+    {
+        LL::parallelFor("General", count, FACES_PER_TASK, [&faces](size_t begin, size_t end)
+            {
+                LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("buildFaceGeometry - worker");
+                for (size_t i = begin; i < end; ++i)
+                {
+                    get_face_geometry(faces[i]);
+                }
+            });
+    }
+    else
+    {
+        for (LLFace* facep : faces)
+        {
+            get_face_geometry(facep);
+        }
+    }
+
+    for (LLFace* facep : serial_faces)
+    {
+        get_face_geometry(facep);
+    }
+
+    faces.clear();
+}
+
+U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace** faces, U32 face_count, bool distance_sort, bool batch_textures, bool rigged,
+                                         std::vector<LLFace*>* geometry_faces)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
 
@@ -6270,138 +6479,238 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
     U32 max_vertices = (max_vbo_size * 1024)/LLVertexBuffer::calcVertexSize(group->getSpatialPartition()->mVertexDataMask);
     max_vertices = llmin(max_vertices, (U32) 65535);
 
-    {
-        LL_PROFILE_ZONE_NAMED("genDrawInfo - sort");
+    // the sort order and batches depend only on the faces and their textures
+    // and materials, so rebuilds of unchanged content can reuse them
+    static LLCachedControl<bool> use_batch_cache(gSavedSettings, "RenderDrawBatchCache", true);
+    static LLSpatialGroup::DrawBatchLayout scratch_layout;
+    LLSpatialGroup::DrawBatchLayout* layout = &scratch_layout;
+    bool cached = false;
 
-        if (rigged)
+    S32 texture_index_channels = LLGLSLShader::sIndexedTextureChannels;
+
+    if (use_batch_cache && !distance_sort && face_count > 1)
+    {
+        U64 hash = draw_batch_hash(mask, faces, face_count, batch_textures, rigged, max_vertices, texture_index_channels);
+        LLSpatialGroup::draw_batch_cache_t& cache = group->mDrawBatchCache;
+        for (LLSpatialGroup::DrawBatchLayout& entry : cache)
         {
-            if (!distance_sort) // <--- alpha "sort" rigged faces by maintaining original draw order
+            if (entry.mHash == hash && entry.mFaces.size() == face_count)
             {
-                //sort faces by things that break batches, including avatar and mesh id
-                std::sort(faces, faces + face_count, CompareBatchBreakerRigged());
+                layout = &entry;
+                cached = true;
+                break;
             }
         }
-        else if (!distance_sort)
-        {
-            //sort faces by things that break batches, not including avatar and mesh id
-            std::sort(faces, faces + face_count, CompareBatchBreaker());
-        }
-        else
+
+        if (!cached)
         {
-            //sort faces by distance
-            std::sort(faces, faces+face_count, LLFace::CompareDistanceGreater());
+            if (cache.size() < DRAW_BATCH_CACHE_SIZE)
+            {
+                cache.emplace_back();
+                layout = &cache.back();
+            }
+            else
+            {
+                layout = &cache[group->mDrawBatchCacheNext++ % DRAW_BATCH_CACHE_SIZE];
+            }
+            layout->mHash = hash;
         }
+        add(cached ? sDrawBatchCacheHits : sDrawBatchCacheMisses, 1);
     }
 
-    bool hud_group = group->isHUDGroup() ;
     LLFace** face_iter = faces;
     LLFace** end_faces = faces+face_count;
 
-    LLSpatialGroup::buffer_map_t buffer_map;
+    if (cached)
+    {
+        LL_PROFILE_ZONE_NAMED("genDrawInfo - cached");
+        for (U32 idx = 0; idx < face_count; ++idx)
+        {
+            LLFace* facep = layout->mFaces[idx];
+            faces[idx] = facep;
+            S16 tex_idx = layout->mTextureIndex[idx];
+            if (tex_idx >= 0)
+            {
+                if (tex_idx == FACE_DO_NOT_BATCH_TEXTURES && !batch_textures)
+                {
+                    facep->mDrawInfo = NULL;
+                }
+                facep->setTextureIndex((U8)tex_idx);
+            }
+        }
+    }
+    else
+    {
+        {
+            LL_PROFILE_ZONE_NAMED("genDrawInfo - sort");
 
-    LLViewerTexture* last_tex = NULL;
+            if (rigged)
+            {
+                if (!distance_sort) // <--- alpha "sort" rigged faces by maintaining original draw order
+                {
+                    //sort faces by things that break batches, including avatar and mesh id
+                    std::sort(faces, faces + face_count, CompareBatchBreakerRigged());
+                }
+            }
+            else if (!distance_sort)
+            {
+                //sort faces by things that break batches, not including avatar and mesh id
+                std::sort(faces, faces + face_count, CompareBatchBreaker());
+            }
+            else
+            {
+                //sort faces by distance
+                std::sort(faces, faces+face_count, LLFace::CompareDistanceGreater());
+            }
+        }
 
-    S32 texture_index_channels = LLGLSLShader::sIndexedTextureChannels;
+        layout->mTextureIndex.assign(face_count, -1);
+        layout->mBatches.clear();
+        auto set_texture_index = [&](LLFace** pos, U8 index)
+            {
+                (*pos)->setTextureIndex(index);
+                layout->mTextureIndex[pos - faces] = index;
+            };
 
-    bool flexi = false;
+        LLViewerTexture* last_tex = NULL;
 
-    while (face_iter != end_faces)
-    {
-        //pull off next face
-        LLFace* facep = *face_iter;
-        LLViewerTexture* tex = facep->getTexture();
-        const LLTextureEntry* te = facep->getTextureEntry();
-        LLMaterialPtr mat = te->getMaterialParams();
-        LLMaterialID matId = te->getMaterialID();
+        bool flexi = false;
 
-        if (distance_sort)
+        while (face_iter != end_faces)
         {
-            tex = NULL;
-        }
+            //pull off next face
+            LLFace* facep = *face_iter;
+            LLViewerTexture* tex = facep->getTexture();
+            const LLTextureEntry* te = facep->getTextureEntry();
+            LLMaterialPtr mat = te->getMaterialParams();
+            LLMaterialID matId = te->getMaterialID();
 
-        if (last_tex != tex)
-        {
-            last_tex = tex;
-        }
+            if (distance_sort)
+            {
+                tex = NULL;
+            }
 
-        bool bake_sunlight = LLPipeline::sBakeSunlight && facep->getDrawable()->isStatic();
+            if (last_tex != tex)
+            {
+                last_tex = tex;
+            }
 
-        U32 index_count = facep->getIndicesCount();
-        U32 geom_count = facep->getGeomCount();
+            U32 index_count = facep->getIndicesCount();
+            U32 geom_count = facep->getGeomCount();
 
-        flexi = flexi || facep->getViewerObject()->getVolume()->isUnique();
+            flexi = flexi || facep->getViewerObject()->getVolume()->isUnique();
 
-        //sum up vertices needed for this render batch
-        LLFace** i = face_iter;
-        ++i;
+            //sum up vertices needed for this render batch
+            LLFace** i = face_iter;
+            ++i;
 
-        const U32 MAX_TEXTURE_COUNT = 32;
-        LLViewerTexture* texture_list[MAX_TEXTURE_COUNT];
+            const U32 MAX_TEXTURE_COUNT = 32;
+            LLViewerTexture* texture_list[MAX_TEXTURE_COUNT];
 
-        U32 texture_count = 0;
+            U32 texture_count = 0;
 
-        {
-            LL_PROFILE_ZONE_NAMED("genDrawInfo - face size");
-            if (batch_textures)
             {
-                U8 cur_tex = 0;
-                facep->setTextureIndex(cur_tex);
-                if (texture_count < MAX_TEXTURE_COUNT)
+                LL_PROFILE_ZONE_NAMED("genDrawInfo - face size");
+                if (batch_textures)
                 {
-                    texture_list[texture_count++] = tex;
-                }
-
-                if (can_batch_texture(facep))
-                { //populate texture_list with any textures that can be batched
-                  //move i to the next unbatchable face
-                    while (i != end_faces)
+                    U8 cur_tex = 0;
+                    set_texture_index(face_iter, cur_tex);
+                    if (texture_count < MAX_TEXTURE_COUNT)
                     {
-                        facep = *i;
-
-                        if (!can_batch_texture(facep))
-                        { //face is bump mapped or has an animated texture matrix -- can't
-                            //batch more than 1 texture at a time
-                            facep->setTextureIndex(0);
-                            break;
-                        }
+                        texture_list[texture_count++] = tex;
+                    }
 
-                        if (facep->getTexture() != tex)
+                    if (can_batch_texture(facep))
+                    { //populate texture_list with any textures that can be batched
+                      //move i to the next unbatchable face
+                        while (i != end_faces)
                         {
-                            if (distance_sort)
-                            { //textures might be out of order, see if texture exists in current batch
-                                bool found = false;
-                                for (U32 tex_idx = 0; tex_idx < texture_count; ++tex_idx)
-                                {
-                                    if (facep->getTexture() == texture_list[tex_idx])
+                            facep = *i;
+
+                            if (!can_batch_texture(facep))
+                            { //face is bump mapped or has an animated texture matrix -- can't
+                                //batch more than 1 texture at a time
+                                set_texture_index(i, 0);
+                                break;
+                            }
+
+                            if (facep->getTexture() != tex)
+                            {
+                                if (distance_sort)
+                                { //textures might be out of order, see if texture exists in current batch
+                                    bool found = false;
+                                    for (U32 tex_idx = 0; tex_idx < texture_count; ++tex_idx)
+                                    {
+                                        if (facep->getTexture() == texture_list[tex_idx])
+                                        {
+                                            cur_tex = tex_idx;
+                                            found = true;
+                                            break;
+                                        }
+                                    }
+
+                                    if (!found)
                                     {
-                                        cur_tex = tex_idx;
-                                        found = true;
-                                        break;
+                                        cur_tex = texture_count;
                                     }
                                 }
+                                else
+                                {
+                                    cur_tex++;
+                                }
+
+                                if (cur_tex >= texture_index_channels)
+                                { //cut batches when index channels are depleted
+                                    break;
+                                }
 
-                                if (!found)
+                                tex = facep->getTexture();
+
+                                if (texture_count < MAX_TEXTURE_COUNT)
                                 {
-                                    cur_tex = texture_count;
+                                    texture_list[texture_count++] = tex;
                                 }
                             }
-                            else
-                            {
-                                cur_tex++;
-                            }
 
-                            if (cur_tex >= texture_index_channels)
-                            { //cut batches when index channels are depleted
+                            if (geom_count + facep->getGeomCount() > max_vertices)
+                            { //cut batches on geom count too big
                                 break;
                             }
 
-                            tex = facep->getTexture();
+                            ++i;
 
-                            if (texture_count < MAX_TEXTURE_COUNT)
-                            {
-                                texture_list[texture_count++] = tex;
-                            }
+                            flexi = flexi || facep->getViewerObject()->getVolume()->isUnique();
+
+                            index_count += facep->getIndicesCount();
+                            geom_count += facep->getGeomCount();
+
+                            set_texture_index(i - 1, cur_tex);
                         }
+                    }
+                    else
+                    {
+                        set_texture_index(face_iter, 0);
+                    }
+
+                    tex = texture_list[0];
+                }
+                else
+                {
+                    while (i != end_faces &&
+                        (LLPipeline::sTextureBindTest ||
+                            (distance_sort ||
+                                ((*i)->getTexture() == tex))))
+                    {
+                        facep = *i;
+                        const LLTextureEntry* nextTe = facep->getTextureEntry();
+                        if (nextTe->getMaterialID() != matId)
+                        {
+                            break;
+                        }
+
+                        //face has no texture index
+                        facep->mDrawInfo = NULL;
+                        set_texture_index(i, FACE_DO_NOT_BATCH_TEXTURES);
 
                         if (geom_count + facep->getGeomCount() > max_vertices)
                         { //cut batches on geom count too big
@@ -6409,53 +6718,36 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                         }
 
                         ++i;
-
-                        flexi = flexi || facep->getViewerObject()->getVolume()->isUnique();
-
                         index_count += facep->getIndicesCount();
                         geom_count += facep->getGeomCount();
 
-                        facep->setTextureIndex(cur_tex);
+                        flexi = flexi || facep->getViewerObject()->getVolume()->isUnique();
                     }
                 }
-                else
-                {
-                    facep->setTextureIndex(0);
-                }
-
-                tex = texture_list[0];
             }
-            else
-            {
-                while (i != end_faces &&
-                    (LLPipeline::sTextureBindTest ||
-                        (distance_sort ||
-                            ((*i)->getTexture() == tex))))
-                {
-                    facep = *i;
-                    const LLTextureEntry* nextTe = facep->getTextureEntry();
-                    if (nextTe->getMaterialID() != matId)
-                    {
-                        break;
-                    }
 
-                    //face has no texture index
-                    facep->mDrawInfo = NULL;
-                    facep->setTextureIndex(FACE_DO_NOT_BATCH_TEXTURES);
+            layout->mBatches.push_back({ (U32)(i - faces), geom_count, index_count });
+            face_iter = i;
+        }
 
-                    if (geom_count + facep->getGeomCount() > max_vertices)
-                    { //cut batches on geom count too big
-                        break;
-                    }
+        layout->mFaces.assign(faces, faces + face_count);
+    }
 
-                    ++i;
-                    index_count += facep->getIndicesCount();
-                    geom_count += facep->getGeomCount();
+    bool hud_group = group->isHUDGroup() ;
 
-                    flexi = flexi || facep->getViewerObject()->getVolume()->isUnique();
-                }
-            }
-        }
+    LLSpatialGroup::buffer_map_t buffer_map;
+
+    face_iter = faces;
+    for (const LLSpatialGroup::DrawBatch& batch : layout->mBatches)
+    {
+        LLFace** i = faces + batch.mEnd;
+        LLFace* facep = *face_iter;
+        LLViewerTexture* tex = NULL;
+
+        bool bake_sunlight = LLPipeline::sBakeSunlight && facep->getDrawable()->isStatic();
+
+        U32 index_count = batch.mIndexCount;
+        U32 geom_count = batch.mGeomCount;
 
         //create vertex buffer
         LLPointer<LLVertexBuffer> buffer;
@@ -6476,6 +6768,11 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
         {
             geometryBytes += buffer->getSize() + buffer->getIndicesSize();
             buffer_map[mask][*face_iter].push_back(buffer);
+
+            if (geometry_faces)
+            { // faces are copied in on several threads by buildFaceGeometry()
+                buffer->mapWholeBuffer();
+            }
         }
 
         //add face geometry
@@ -6509,28 +6806,13 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                 //for debugging, set last time face was updated vs moved
                 facep->updateRebuildFlags();
 
+                if (geometry_faces)
+                {
+                    geometry_faces->push_back(facep);
+                }
+                else
                 { //copy face geometry into vertex buffer
-                    LLDrawable* drawablep = facep->getDrawable();
-                    LLVOVolume* vobj = drawablep->getVOVolume();
-                    LLVolume* volume = vobj->getVolume();
-
-                    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
-                    {
-                        vobj->updateRelativeXform(true);
-                    }
-
-                    U32 te_idx = facep->getTEOffset();
-
-                    if (!facep->getGeometryVolume(*volume, te_idx,
-                        vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), index_offset,true))
-                    {
-                        LL_WARNS() << "Failed to get geometry for face!" << LL_ENDL;
-                    }
-
-                    if (drawablep->isState(LLDrawable::ANIMATED_CHILD))
-                    {
-                        vobj->updateRelativeXform(false);
-                    }
+                    get_face_geometry(facep);
                 }
             }
 
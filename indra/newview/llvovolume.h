@@ -32,6 +32,7 @@
 #include "llviewermedia.h"
 #include "llframetimer.h"
 #include "lllocalbitmaps.h"
+#include "llvolumelodbatch.h"
 #include "m3math.h"     // LLMatrix3
 #include "m4math.h"     // LLMatrix4
 #include <unordered_map>
@@ -420,8 +421,21 @@ public:
     //clear out rigged volume and revert back to non-rigged state for picking/LOD/distance updates
     void clearRiggedVolume();
 
+    // While a LOD batch is open, updateLOD() queues the LOD selection of
+    // ordinary volumes, and endLODBatch() selects and applies the LODs of all
+    // of them at once.  See LLVolumeLODBatch.
+    static void beginLODBatch();
+    static void endLODBatch();
+
 protected:
-    S32 computeLODDetail(F32 distance, F32 radius, F32 lod_factor);
+    static LLVolumeLODBatch::Params getLODParams();
+    // camera distance and LOD radius for calcLOD(), false if the LOD should not change
+    bool getLODInputs(F32& distance, F32& radius);
+    // true if the LOD changed to cur_detail, or the detail level that overrides it
+    bool applyLODDetail(S32 cur_detail);
+    bool canBatchLOD();
+    // move the drawable in the octree if its bin radius changed enough
+    void checkBinRadius();
     bool calcLOD();
     LLFace* addFace(S32 face_index);
 
@@ -115,6 +115,7 @@
 #include "llprogressview.h"
 #include "llcleanup.h"
 #include "gltfscenemanager.h"
+#include "parallelfor.h"
 
 #include "llenvironment.h"
 #include "llsettingsvo.h"
@@ -338,7 +339,27 @@ F32     LLPipeline::sDistortionWaterClipPlaneMargin = 1.0125f;
 // EventHost API LLPipeline listener.
 static LLPipelineListener sPipelineListener;
 
-static LLCullResult* sCull = NULL;
+// per thread, for updateCullParallel()
+static thread_local LLCullResult* sCull = NULL;
+
+// time spent in updateCull() for each LLViewerCamera::eCameraID
+static LLTrace::EventStatHandle<F64Milliseconds> sCullTime[LLViewerCamera::NUM_CAMERAS] =
+{
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_world", "Time to cull the scene for the main view"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_sun_shadow0", "Time to cull the scene for sun shadow map 0"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_sun_shadow1", "Time to cull the scene for sun shadow map 1"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_sun_shadow2", "Time to cull the scene for sun shadow map 2"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_sun_shadow3", "Time to cull the scene for sun shadow map 3"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_spot_shadow0", "Time to cull the scene for spot light shadow map 0"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_spot_shadow1", "Time to cull the scene for spot light shadow map 1"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_water0", "Time to cull the scene for water reflection"),
+    LLTrace::EventStatHandle<F64Milliseconds>("cull_water1", "Time to cull the scene for water refraction"),
+};
+
+// time spent in each phase of stateSortVisible() for the main view when RenderParallelStateSort is set
+static LLTrace::EventStatHandle<F64Milliseconds> sStateSortGatherTime("statesort_gather", "Time to gather the visible drawables for stateSort");
+static LLTrace::EventStatHandle<F64Milliseconds> sStateSortClassifyTime("statesort_classify", "Time to classify the visible drawables for stateSort on the thread pool");
+static LLTrace::EventStatHandle<F64Milliseconds> sStateSortApplyTime("statesort_apply", "Time to update LODs and draw pools from the stateSort classification");
 
 void validate_framebuffer_object();
 
@@ -603,6 +624,8 @@ void LLPipeline::init()
     connectRefreshCachedSettingsSafe("RenderHeroProbeUpdateRate");
     connectRefreshCachedSettingsSafe("RenderHeroProbeConservativeUpdateMultiplier");
     connectRefreshCachedSettingsSafe("RenderAvatarCloth");
+    connectRefreshCachedSettingsSafe("RenderMultiDrawBatches");
+    connectRefreshCachedSettingsSafe("RenderFrameArena");
 
     LLPointer<LLControlVariable> cntrl_ptr = gSavedSettings.getControl("CollectFontVertexBuffers");
     if (cntrl_ptr.notNull())
@@ -1136,6 +1159,8 @@ void LLPipeline::refreshCachedSettings()
     RenderHeroProbeUpdateRate = gSavedSettings.getS32("RenderHeroProbeUpdateRate");
     RenderHeroProbeConservativeUpdateMultiplier = gSavedSettings.getS32("RenderHeroProbeConservativeUpdateMultiplier");
     RenderAvatarCloth = gSavedSettings.getBOOL("RenderAvatarCloth");
+    LLVertexBuffer::sMultiDrawMode = llmin(gSavedSettings.getU32("RenderMultiDrawBatches"), (U32)LLVertexBuffer::MULTI_DRAW_INDIRECT);
+    LLFrameArena::sEnabled = gSavedSettings.getBOOL("RenderFrameArena");
 
     sReflectionProbesEnabled = LLFeatureManager::getInstance()->isFeatureAvailable("RenderReflectionsEnabled") && gSavedSettings.getBOOL("RenderReflectionsEnabled");
     RenderSpotLight = nullptr;
@@ -2468,6 +2493,97 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE; //LL_RECORD_BLOCK_TIME(FTM_CULL);
     LL_PROFILE_GPU_ZONE("updateCull"); // should always be zero GPU time, but drop a timer to flush stuff out
 
+    LLTimer cull_timer;
+
+    setCullClipPlane(camera);
+
+    cullPartitions(camera, result);
+
+    cullSky(camera);
+
+    record(sCullTime[LLViewerCamera::sCurCameraID], F64Seconds(cull_timer.getElapsedTimeF64()));
+}
+
+void LLPipeline::updateCullParallel(LLCamera* const* cameras, LLCullResult* const* results,
+                                    const LLViewerCamera::eCameraID* camera_ids, U32 count)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    static LLCachedControl<bool> parallel_cull(gSavedSettings, "RenderParallelCull", true);
+
+    LLViewerCamera::eCameraID saved_camera_id = LLViewerCamera::sCurCameraID;
+
+    if (!parallel_cull || count < 2)
+    {
+        for (U32 i = 0; i < count; i++)
+        {
+            LLViewerCamera::sCurCameraID = camera_ids[i];
+            updateCull(*cameras[i], *results[i]);
+        }
+        LLViewerCamera::sCurCameraID = saved_camera_id;
+        return;
+    }
+
+    for (U32 i = 0; i < count; i++)
+    {
+        llassert(camera_ids[i] != LLViewerCamera::CAMERA_WORLD);
+        setCullClipPlane(*cameras[i]);
+    }
+
+    // bring every octree up to date first, so that the culls below only
+    // read the octrees
+    for (LLViewerRegion* region : LLWorld::getInstance()->getRegionList())
+    {
+        for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+        {
+            LLSpatialPartition* part = region->getSpatialPartition(i);
+            if (part && hasRenderType(part->mDrawableType))
+            {
+                part->prepareCull();
+            }
+        }
+
+        LLVOCachePartition* vo_part = region->getVOCachePartition();
+        if (vo_part)
+        {
+            vo_part->prepareCull();
+        }
+    }
+
+    // each camera culls into its own result, in the same order as updateCull()
+    std::vector<F64> cull_seconds(count);
+    LLViewerOctreePartition::sParallelCull = true;
+    LL::parallelFor("General", count, 1, [&](size_t begin, size_t end)
+        {
+            LLViewerCamera::eCameraID thread_camera_id = LLViewerCamera::sCurCameraID;
+            LLCullResult* thread_cull = sCull;
+
+            for (size_t i = begin; i < end; i++)
+            {
+                LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("cull camera");
+                LLTimer cull_timer;
+                LLViewerCamera::sCurCameraID = camera_ids[i];
+                cullPartitions(*cameras[i], *results[i]);
+                cull_seconds[i] = cull_timer.getElapsedTimeF64();
+            }
+
+            LLViewerCamera::sCurCameraID = thread_camera_id;
+            sCull = thread_cull;
+        });
+    LLViewerOctreePartition::sParallelCull = false;
+
+    for (U32 i = 0; i < count; i++)
+    {
+        LLViewerCamera::sCurCameraID = camera_ids[i];
+        grabReferences(*results[i]);
+        cullSky(*cameras[i]);
+        record(sCullTime[camera_ids[i]], F64Seconds(cull_seconds[i]));
+    }
+
+    LLViewerCamera::sCurCameraID = saved_camera_id;
+}
+
+void LLPipeline::setCullClipPlane(LLCamera& camera)
+{
     bool water_clip = isWaterClip();
 
     if (water_clip)
@@ -2497,7 +2613,11 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
     {
         camera.disableUserClipPlane();
     }
+}
 
+// may run off the main thread, see updateCullParallel()
+void LLPipeline::cullPartitions(LLCamera& camera, LLCullResult& result)
+{
     grabReferences(result);
 
     sCull->clear();
@@ -2526,7 +2646,10 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
             vo_part->cull(camera, sUseOcclusion > 0);
         }
     }
+}
 
+void LLPipeline::cullSky(LLCamera& camera)
+{
     if (hasRenderType(LLPipeline::RENDER_TYPE_SKY) &&
         gSky.mVOSkyp.notNull() &&
         gSky.mVOSkyp->mDrawable.notNull())
@@ -3121,6 +3244,12 @@ void LLPipeline::stateSort(LLCamera& camera, LLCullResult &result)
 
     //LLVertexBuffer::unbind();
 
+    bool batch_lod = LLViewerCamera::sCurCameraID == LLViewerCamera::CAMERA_WORLD && !gCubeSnapshot;
+    if (batch_lod)
+    { // LOD changes found by updateDistance() below are selected and applied together before postSort
+        LLVOVolume::beginLODBatch();
+    }
+
     grabReferences(result);
     for (LLCullResult::sg_iterator iter = sCull->beginDrawableGroups(); iter != sCull->endDrawableGroups(); ++iter)
     {
@@ -3185,43 +3314,243 @@ void LLPipeline::stateSort(LLCamera& camera, LLCullResult &result)
         }
     }
 
-    for (LLCullResult::sg_iterator iter = sCull->beginVisibleGroups(); iter != sCull->endVisibleGroups(); ++iter)
+    stateSortVisible(camera);
+
+    if (batch_lod)
     {
-        LLSpatialGroup* group = *iter;
-        if (group->isDead())
+        LLVOVolume::endLODBatch();
+    }
+
+    postSort(camera);
+}
+
+void LLPipeline::stateSortVisible(LLCamera& camera)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    static LLCachedControl<bool> parallel_state_sort(gSavedSettings, "RenderParallelStateSort", true);
+
+    if (!parallel_state_sort)
+    {
+        for (LLCullResult::sg_iterator iter = sCull->beginVisibleGroups(); iter != sCull->endVisibleGroups(); ++iter)
         {
-            continue;
+            LLSpatialGroup* group = *iter;
+            if (group->isDead())
+            {
+                continue;
+            }
+            group->checkOcclusion();
+            if (sUseOcclusion > 1 && group->isOcclusionState(LLSpatialGroup::OCCLUDED))
+            {
+                markOccluder(group);
+            }
+            else
+            {
+                group->setVisible();
+                stateSort(group, camera);
+
+                { //rebuild mesh as soon as we know it's visible
+                    group->rebuildMesh();
+                }
+            }
         }
-        group->checkOcclusion();
-        if (sUseOcclusion > 1 && group->isOcclusionState(LLSpatialGroup::OCCLUDED))
+
         {
-            markOccluder(group);
+            LL_PROFILE_ZONE_NAMED_CATEGORY_DRAWABLE("stateSort"); // LL_RECORD_BLOCK_TIME(FTM_STATESORT_DRAWABLE);
+            for (LLCullResult::drawable_iterator iter = sCull->beginVisibleList();
+                 iter != sCull->endVisibleList(); ++iter)
+            {
+                LLDrawable *drawablep = *iter;
+                if (!drawablep->isDead())
+                {
+                    stateSort(drawablep, camera);
+                }
+            }
         }
-        else
+        return;
+    }
+
+    bool world_camera = LLViewerCamera::sCurCameraID == LLViewerCamera::CAMERA_WORLD && !gCubeSnapshot;
+    // same conditions as LLDrawable::updateDistance()
+    bool update_distance = world_camera && !gShiftFrame;
+    bool hide_selected = LLSelectMgr::getInstance()->mHideSelectedObjects;
+
+    LLTimer phase_timer;
+
+    // gather: occlusion and group visibility stay on this thread, since they
+    // may touch occlusion queries and the occluder list
+    static std::vector<LLSpatialGroup*> visible_groups;
+    static std::vector<LLDrawable*> drawables;
+    visible_groups.clear();
+    drawables.clear();
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("stateSort - gather");
+        for (LLCullResult::sg_iterator iter = sCull->beginVisibleGroups(); iter != sCull->endVisibleGroups(); ++iter)
         {
-            group->setVisible();
-            stateSort(group, camera);
+            LLSpatialGroup* group = *iter;
+            if (group->isDead())
+            {
+                continue;
+            }
+            group->checkOcclusion();
+            if (sUseOcclusion > 1 && group->isOcclusionState(LLSpatialGroup::OCCLUDED))
+            {
+                markOccluder(group);
+            }
+            else
+            {
+                group->setVisible();
+                if (group->changeLOD())
+                { // see stateSort(LLSpatialGroup*)
+                    for (LLSpatialGroup::element_iter i = group->getDataBegin(); i != group->getDataEnd(); ++i)
+                    {
+                        drawables.push_back((LLDrawable*)(*i)->getDrawable());
+                    }
 
-            { //rebuild mesh as soon as we know it's visible
-                group->rebuildMesh();
+                    if (world_camera)
+                    { //avoid redundant stateSort calls
+                        group->mLastUpdateDistance = group->mDistance;
+                    }
+                }
+                visible_groups.push_back(group);
+            }
+        }
+
+        for (LLCullResult::drawable_iterator iter = sCull->beginVisibleList(); iter != sCull->endVisibleList(); ++iter)
+        {
+            LLDrawable* drawablep = *iter;
+            if (!drawablep->isDead())
+            {
+                drawables.push_back(drawablep);
             }
         }
     }
+    if (world_camera)
+    {
+        record(sStateSortGatherTime, F64Seconds(phase_timer.getElapsedTimeF64()));
+    }
+
+    // classify: the checks, visibility flag and distance of stateSort(LLDrawable*)
+    // for every drawable, into one bin per chunk so the results can be applied
+    // in the same order as the serial sort
+    struct StateSortBin
+    {
+        std::vector<LLDrawable*>    mSerial; // spatial bridges and avatars, sorted in full on this thread
+        std::vector<LLDrawable*>    mLOD;    // distance updated, LOD still to update
+        std::vector<LLFace*>        mFaces;  // faces to add to their pools
+        U32                         mNumFaces = 0;
+    };
+    constexpr size_t STATE_SORT_GRAIN = 256;
+    static std::vector<StateSortBin> bins;
+    bins.resize((drawables.size() + STATE_SORT_GRAIN - 1) / STATE_SORT_GRAIN);
+
+    phase_timer.reset();
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("stateSort - classify");
+        LL::parallelFor("General", drawables.size(), STATE_SORT_GRAIN, [&](size_t begin, size_t end)
+            {
+                StateSortBin& bin = bins[begin / STATE_SORT_GRAIN];
+                bin.mSerial.clear();
+                bin.mLOD.clear();
+                bin.mFaces.clear();
+                bin.mNumFaces = 0;
+
+                for (size_t i = begin; i < end; i++)
+                {
+                    LLDrawable* drawablep = drawables[i];
+                    if (!drawablep
+                        || drawablep->isDead()
+                        || !hasRenderType(drawablep->getRenderType())
+                        || (RenderSpotLight && drawablep == RenderSpotLight))
+                    {
+                        continue;
+                    }
+
+                    if (hide_selected &&
+                        drawablep->getVObj().notNull() &&
+                        drawablep->getVObj()->isSelected())
+                    {
+                        continue;
+                    }
+
+                    if (drawablep->isSpatialBridge() || drawablep->isAvatar())
+                    { // bridges mark their own groups visible, avatars update their visibility
+                        bin.mSerial.push_back(drawablep);
+                        continue;
+                    }
+
+                    if (!drawablep->isState(LLDrawable::INVISIBLE|LLDrawable::FORCE_INVISIBLE))
+                    {
+                        drawablep->setVisible(camera, NULL, false);
+                    }
+
+                    if (update_distance && !drawablep->isActive())
+                    {
+                        bool force_update = false;
+                        drawablep->calcDistance(camera, force_update);
+                        if (drawablep->getVObj().notNull())
+                        {
+                            bin.mLOD.push_back(drawablep);
+                        }
+                    }
+
+                    if (!drawablep->getVOVolume())
+                    {
+                        for (LLFace* facep : drawablep->mFaces)
+                        {
+                            if (facep->hasGeometry())
+                            {
+                                if (!facep->getPool())
+                                {
+                                    break;
+                                }
+                                bin.mFaces.push_back(facep);
+                            }
+                        }
+                    }
+
+                    bin.mNumFaces += drawablep->getNumFaces();
+                }
+            });
+    }
+    if (world_camera)
+    {
+        record(sStateSortClassifyTime, F64Seconds(phase_timer.getElapsedTimeF64()));
+    }
 
+    // apply: LOD updates and pool insertion, which share state between
+    // drawables, then the mesh rebuilds the serial sort did per group
+    phase_timer.reset();
     {
-        LL_PROFILE_ZONE_NAMED_CATEGORY_DRAWABLE("stateSort"); // LL_RECORD_BLOCK_TIME(FTM_STATESORT_DRAWABLE);
-        for (LLCullResult::drawable_iterator iter = sCull->beginVisibleList();
-             iter != sCull->endVisibleList(); ++iter)
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("stateSort - apply");
+        for (StateSortBin& bin : bins)
         {
-            LLDrawable *drawablep = *iter;
-            if (!drawablep->isDead())
+            for (LLDrawable* drawablep : bin.mSerial)
             {
                 stateSort(drawablep, camera);
             }
+
+            for (LLDrawable* drawablep : bin.mLOD)
+            {
+                drawablep->getVObj()->updateLOD();
+            }
+
+            for (LLFace* facep : bin.mFaces)
+            {
+                facep->getPool()->enqueue(facep);
+            }
+
+            mNumVisibleFaces += bin.mNumFaces;
         }
-    }
 
-    postSort(camera);
+        for (LLSpatialGroup* group : visible_groups)
+        {
+            group->rebuildMesh();
+        }
+    }
+    if (world_camera)
+    {
+        record(sStateSortApplyTime, F64Seconds(phase_timer.getElapsedTimeF64()));
+    }
 }
 
 void LLPipeline::stateSort(LLSpatialGroup* group, LLCamera& camera)
@@ -8656,9 +8985,9 @@ void LLPipeline::renderDeferredLighting()
         if (local_light_count > 0 && (!gCubeSnapshot || probe_level > 0))
         {
             gGL.setSceneBlendType(LLRender::BT_ADD);
-            std::list<LLVector4>        fullscreen_lights;
-            LLDrawable::drawable_list_t spot_lights;
-            LLDrawable::drawable_list_t fullscreen_spot_lights;
+            LLFrameList<LLVector4>      fullscreen_lights;
+            LLFrameVector<LLPointer<LLDrawable> > spot_lights;
+            LLFrameVector<LLPointer<LLDrawable> > fullscreen_spot_lights;
             LLSettingsSky::ptr_t        psky        = LLEnvironment::instance().getCurrentSky();
 
             if (!gCubeSnapshot)
@@ -8669,7 +8998,7 @@ void LLPipeline::renderDeferredLighting()
                 }
             }
 
-            std::list<LLVector4> light_colors;
+            LLFrameList<LLVector4> light_colors;
 
             LLVertexBuffer::unbind();
 
@@ -8795,9 +9124,8 @@ void LLPipeline::renderDeferredLighting()
 
                 gDeferredSpotLightProgram.enableTexture(LLShaderMgr::DEFERRED_PROJECTION);
 
-                for (LLDrawable::drawable_list_t::iterator iter = spot_lights.begin(); iter != spot_lights.end(); ++iter)
+                for (LLDrawable* drawablep : spot_lights)
                 {
-                    LLDrawable *drawablep = *iter;
 
                     LLVOVolume *volume = drawablep->getVOVolume();
 
@@ -8872,9 +9200,8 @@ void LLPipeline::renderDeferredLighting()
 
                 mScreenTriangleVB->setBuffer();
 
-                for (LLDrawable::drawable_list_t::iterator iter = fullscreen_spot_lights.begin(); iter != fullscreen_spot_lights.end(); ++iter)
+                for (LLDrawable* drawablep : fullscreen_spot_lights)
                 {
-                    LLDrawable* drawablep = *iter;
                     LLVOVolume* volume = drawablep->getVOVolume();
                     LLVector3   center = drawablep->getPositionAgent();
                     F32         light_size_final = volume->getLightRadius() * 1.5f;
@@ -9475,7 +9802,8 @@ static LLTrace::BlockTimerStatHandle FTM_SHADOW_ALPHA_TREE("Alpha Tree");
 static LLTrace::BlockTimerStatHandle FTM_SHADOW_ALPHA_GRASS("Alpha Grass");
 static LLTrace::BlockTimerStatHandle FTM_SHADOW_FULLBRIGHT_ALPHA_MASKED("Fullbright Alpha Masked");
 
-void LLPipeline::renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCamera& shadow_cam, LLCullResult& result, bool depth_clamp)
+void LLPipeline::renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCamera& shadow_cam, LLCullResult& result, bool depth_clamp,
+                              bool do_cull)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE; //LL_RECORD_BLOCK_TIME(FTM_SHADOW_RENDER);
     LL_PROFILE_GPU_ZONE("renderShadow");
@@ -9511,7 +9839,10 @@ void LLPipeline::renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCa
 
     LLGLDepthTest depth_test(GL_TRUE, GL_TRUE, GL_LESS);
 
-    updateCull(shadow_cam, result);
+    if (do_cull)
+    {
+        updateCull(shadow_cam, result);
+    }
 
     stateSort(shadow_cam, result);
 
@@ -9679,7 +10010,7 @@ void LLPipeline::renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCa
     LLPipeline::sShadowRender = false;
 }
 
-bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir)
+bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector3& max, LLFrameVector<LLVector3>& fp, LLVector3 light_dir)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
     //get point cloud of intersection of frust and min, max
@@ -9699,7 +10030,7 @@ bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector
         LLPlane(max, LLVector3(0,0,1))};
 
     //potential points
-    std::vector<LLVector3> pp;
+    LLFrameVector<LLVector3> pp;
 
     //add corners of AABB
     pp.push_back(LLVector3(min.mV[0], min.mV[1], min.mV[2]));
@@ -10050,7 +10381,7 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
     F32 near_clip = 0.f;
     {
         //get visible point cloud
-        std::vector<LLVector3> fp;
+        LLFrameVector<LLVector3> fp;
 
         main_camera.calcAgentFrustumPlanes(main_camera.mAgentFrustum);
 
@@ -10134,6 +10465,37 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
     // convenience array of 4 near clip plane distances
     F32 dist[] = { near_clip, mSunClipPlanes.mV[0], mSunClipPlanes.mV[1], mSunClipPlanes.mV[2], mSunClipPlanes.mV[3] };
 
+    // shadow cameras set up below, culled all at once before rendering
+    LLCamera shadow_cam_list[4];
+    S32 shadow_index[4];
+    U32 cull_count = 0;
+    glm::mat4 shadow_last_view[6];
+    glm::mat4 shadow_last_proj[6];
+
+    auto cull_shadows = [&](LLCullResult* results, LLViewerCamera::eCameraID first_id)
+    {
+        LLCamera* cull_cams[4];
+        LLCullResult* cull_results[4];
+        LLViewerCamera::eCameraID cull_ids[4];
+        for (U32 k = 0; k < cull_count; k++)
+        {
+            cull_cams[k] = &shadow_cam_list[k];
+            cull_results[k] = &results[shadow_index[k]];
+            cull_ids[k] = (LLViewerCamera::eCameraID)(first_id + shadow_index[k]);
+        }
+
+        // same state renderShadow() culls with
+        bool saved_shadow_render = sShadowRender;
+        S32 saved_occlusion = sUseOcclusion;
+        sShadowRender = true;
+        sUseOcclusion = 0;
+
+        updateCullParallel(cull_cams, cull_results, cull_ids, cull_count);
+
+        sShadowRender = saved_shadow_render;
+        sUseOcclusion = saved_occlusion;
+    };
+
     if (mSunDiffuse == LLColor4::black)
     { //sun diffuse is totally black shadows don't matter
         skipRenderingShadows();
@@ -10190,7 +10552,7 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
                 mShadowCamera[j] = shadow_cam;
             }
 
-            std::vector<LLVector3> fp;
+            LLFrameVector<LLVector3> fp;
 
             if (!gPipeline.getVisiblePointCloud(shadow_cam, min, max, fp, lightDir)
                 || j > RenderShadowSplits)
@@ -10220,7 +10582,7 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             {
                 mShadowExtents[j][0] = min;
                 mShadowExtents[j][1] = max;
-                mShadowFrustPoints[j] = fp;
+                mShadowFrustPoints[j].assign(fp.begin(), fp.end());
             }
 
 
@@ -10230,7 +10592,7 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             //get a temporary view projection
             view[j] = look(camera.getOrigin(), lightDir, -up);
 
-            std::vector<LLVector3> wpf;
+            LLFrameVector<LLVector3> wpf;
 
             for (U32 i = 0; i < fp.size(); i++)
             {
@@ -10487,20 +10849,42 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             set_last_modelview(mShadowModelview[j]);
             set_last_projection(mShadowProjection[j]);
 
+            shadow_last_view[j] = mShadowModelview[j];
+            shadow_last_proj[j] = mShadowProjection[j];
+
             mShadowModelview[j] = view[j];
             mShadowProjection[j] = proj[j];
             mSunShadowMatrix[j] = trans*proj[j]*view[j]*inv_view;
 
             stop_glerror();
 
+            // culled together with the other splits and rendered below
+            shadow_cam_list[cull_count] = shadow_cam;
+            shadow_index[cull_count] = j;
+            cull_count++;
+        }
+
+        static LLCullResult result[4];
+        cull_shadows(result, LLViewerCamera::CAMERA_SUN_SHADOW0);
+
+        for (U32 k = 0; k < cull_count; k++)
+        {
+            S32 j = shadow_index[k];
+            LLCamera& shadow_cam = shadow_cam_list[k];
+
+            LLViewerCamera::sCurCameraID = (LLViewerCamera::eCameraID)(LLViewerCamera::CAMERA_SUN_SHADOW0+j);
+
+            set_current_modelview(view[j]);
+            set_current_projection(proj[j]);
+
+            set_last_modelview(shadow_last_view[j]);
+            set_last_projection(shadow_last_proj[j]);
+
             mRT->shadow[j].bindTarget();
             mRT->shadow[j].getViewport(gGLViewport);
             mRT->shadow[j].clear();
 
-            {
-                static LLCullResult result[4];
-                renderShadow(view[j], proj[j], shadow_cam, result[j], true);
-            }
+            renderShadow(view[j], proj[j], shadow_cam, result[j], true, false);
 
             mRT->shadow[j].flush();
 
@@ -10558,6 +10942,8 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
         // this should never happen
         llassert(mShadowSpotLight[0] != mShadowSpotLight[1] || mShadowSpotLight[0].isNull());
 
+        cull_count = 0;
+
         for (S32 i = 0; i < 2; i++)
         {
             set_current_modelview(saved_view);
@@ -10629,35 +11015,54 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             set_last_modelview(mShadowModelview[i + 4]);
             set_last_projection(mShadowProjection[i + 4]);
 
+            shadow_last_view[i + 4] = mShadowModelview[i + 4];
+            shadow_last_proj[i + 4] = mShadowProjection[i + 4];
+
             mShadowModelview[i + 4] = view[i + 4];
             mShadowProjection[i + 4] = proj[i + 4];
 
             if (!gCubeSnapshot) //skip updating spot shadow maps during cubemap updates
             {
-                LLCamera shadow_cam = camera;
+                LLCamera& shadow_cam = shadow_cam_list[cull_count];
+                shadow_cam = camera;
                 shadow_cam.setFar(far_clip);
                 shadow_cam.setOrigin(origin);
 
                 LLViewerCamera::updateFrustumPlanes(shadow_cam, false, false, true);
 
-                //
+                // culled together with the other spot light and rendered below
+                shadow_index[cull_count] = i;
+                cull_count++;
+            }
+        }
 
-                mSpotShadow[i].bindTarget();
-                mSpotShadow[i].getViewport(gGLViewport);
-                mSpotShadow[i].clear();
+        static LLCullResult result[2];
+        cull_shadows(result, LLViewerCamera::CAMERA_SPOT_SHADOW0);
 
-                static LLCullResult result[2];
+        for (U32 k = 0; k < cull_count; k++)
+        {
+            S32 i = shadow_index[k];
+            LLCamera& shadow_cam = shadow_cam_list[k];
 
-                LLViewerCamera::sCurCameraID = (LLViewerCamera::eCameraID)(LLViewerCamera::CAMERA_SPOT_SHADOW0 + i);
+            LLViewerCamera::sCurCameraID = (LLViewerCamera::eCameraID)(LLViewerCamera::CAMERA_SPOT_SHADOW0 + i);
 
-                RenderSpotLight = drawable;
+            set_current_modelview(view[i + 4]);
+            set_current_projection(proj[i + 4]);
 
-                renderShadow(view[i + 4], proj[i + 4], shadow_cam, result[i], false);
+            set_last_modelview(shadow_last_view[i + 4]);
+            set_last_projection(shadow_last_proj[i + 4]);
 
-                RenderSpotLight = nullptr;
+            mSpotShadow[i].bindTarget();
+            mSpotShadow[i].getViewport(gGLViewport);
+            mSpotShadow[i].clear();
 
-                mSpotShadow[i].flush();
-            }
+            RenderSpotLight = mShadowSpotLight[i];
+
+            renderShadow(view[i + 4], proj[i + 4], shadow_cam, result[i], false, false);
+
+            RenderSpotLight = nullptr;
+
+            mSpotShadow[i].flush();
         }
     }
     else
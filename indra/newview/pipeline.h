@@ -40,7 +40,9 @@
 #include "llrendertarget.h"
 #include "llreflectionmapmanager.h"
 #include "llheroprobemanager.h"
+#include "llframearena.h"
 
+#include <atomic>
 #include <stack>
 
 class LLViewerTexture;
@@ -261,10 +263,15 @@ public:
     void updateMove();
     bool visibleObjectsInFrustum(LLCamera& camera);
     bool getVisibleExtents(LLCamera& camera, LLVector3 &min, LLVector3& max);
-    bool getVisiblePointCloud(LLCamera& camera, LLVector3 &min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir = LLVector3(0,0,0));
+    bool getVisiblePointCloud(LLCamera& camera, LLVector3 &min, LLVector3& max, LLFrameVector<LLVector3>& fp, LLVector3 light_dir = LLVector3(0,0,0));
 
     // Populate given LLCullResult with results of a frustum cull of the entire scene against the given LLCamera
     void updateCull(LLCamera& camera, LLCullResult& result);
+    // Same as calling updateCull() for each camera with LLViewerCamera::sCurCameraID set to the matching id,
+    // but the scene culls run concurrently on the "General" thread pool when RenderParallelCull is set.
+    // Only for cameras other than CAMERA_WORLD, whose culls don't update the object cache.
+    void updateCullParallel(LLCamera* const* cameras, LLCullResult* const* results,
+                            const LLViewerCamera::eCameraID* camera_ids, U32 count);
     void createObjects(F32 max_dtime);
     void createObject(LLViewerObject* vobj);
     void processPartitionQ();
@@ -348,7 +355,9 @@ public:
 
     void renderHighlight(const LLViewerObject* obj, F32 fade);
 
-    void renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCamera& camera, LLCullResult& result, bool depth_clamp);
+    // if !do_cull, result must already hold the cull of camera (see updateCullParallel())
+    void renderShadow(const glm::mat4& view, const glm::mat4& proj, LLCamera& camera, LLCullResult& result, bool depth_clamp,
+                      bool do_cull = true);
     void renderSelectedFaces(const LLColor4& color);
     void renderHighlights();
     void renderDebug();
@@ -484,6 +493,12 @@ private:
     void hideDrawable( LLDrawable *pDrawable );
     void unhideDrawable( LLDrawable *pDrawable );
     void skipRenderingShadows();
+    void setCullClipPlane(LLCamera& camera);
+    void cullPartitions(LLCamera& camera, LLCullResult& result);
+    // The visible groups and visible list part of stateSort(), with the per drawable
+    // distance and visibility work done on the "General" thread pool when RenderParallelStateSort is set.
+    void stateSortVisible(LLCamera& camera);
+    void cullSky(LLCamera& camera);
 public:
     enum {GPU_CLASS_MAX = 3 };
 
@@ -646,7 +661,7 @@ public:
     bool                     mBackfaceCull;
     S32                      mMatrixOpCount;
     S32                      mTextureMatrixOps;
-    S32                      mNumVisibleNodes;
+    std::atomic<S32>         mNumVisibleNodes;
 
     S32                      mDebugTextureUploadCost;
     S32                      mDebugSculptUploadCost;
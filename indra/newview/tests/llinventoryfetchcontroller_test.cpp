@@ -0,0 +1,244 @@
+/**
+ * @file llinventoryfetchcontroller_test.cpp
+ * @brief Test cases for LLInventoryFetchController.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Dependencies
+#include "linden_common.h"
+#include <queue>
+#include <vector>
+// Class to test
+#include "../llinventoryfetchcontroller.h"
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// TUT
+// -------------------------------------------------------------------------------------------
+namespace tut
+{
+    // Test wrapper declaration
+    struct inventoryfetchcontroller_test
+    {
+        // mSeconds is simulated time, no clock is involved
+        struct FetchRun
+        {
+            F64 mSeconds = 0.0;
+            U32 mThrottled = 0;
+        };
+
+        // Fetches folders from a pretend AIS that serves CAPACITY requests at
+        // a time and answers anything over that with a quick 503.
+        // Without a controller, keeps fixed_concurrency requests in flight.
+        FetchRun fetchFolders(U32 folders, LLInventoryFetchController* controller, U32 fixed_concurrency)
+        {
+            constexpr U32 CAPACITY = 6;
+            constexpr F64 SERVE_SECONDS = 0.2;
+            constexpr F64 THROTTLE_SECONDS = 0.05;
+
+            struct Response
+            {
+                F64 mTime;
+                S32 mStatus;
+                bool operator>(const Response& other) const { return mTime > other.mTime; }
+            };
+            std::priority_queue<Response, std::vector<Response>, std::greater<Response>> responses;
+
+            FetchRun run;
+            F64 now = 0.0;
+            U32 remaining = folders;
+            U32 in_flight = 0;
+            U32 serving = 0;
+            while (remaining || in_flight)
+            {
+                U32 limit = controller ? controller->getConcurrency() : fixed_concurrency;
+                bool paused = controller && controller->isBackingOff(now);
+                while (remaining && in_flight < limit && !paused)
+                {
+                    --remaining;
+                    ++in_flight;
+                    if (serving < CAPACITY)
+                    {
+                        ++serving;
+                        responses.push({ now + SERVE_SECONDS, 200 });
+                    }
+                    else
+                    {
+                        responses.push({ now + THROTTLE_SECONDS, 503 });
+                    }
+                }
+
+                if (responses.empty())
+                {
+                    // waiting out a pause
+                    now += 0.01;
+                    continue;
+                }
+
+                Response response = responses.top();
+                responses.pop();
+                now = response.mTime;
+                --in_flight;
+                if (response.mStatus == 200)
+                {
+                    --serving;
+                }
+                else
+                {
+                    ++run.mThrottled;
+                    ++remaining;
+                }
+                if (controller)
+                {
+                    F64 seconds = response.mStatus == 200 ? SERVE_SECONDS : THROTTLE_SECONDS;
+                    controller->onResponse(seconds, 1, 100, response.mStatus, now);
+                }
+            }
+            run.mSeconds = now;
+            return run;
+        }
+    };
+
+    // Tut templating thingamagic: test group, object and test instance
+    typedef test_group<inventoryfetchcontroller_test> inventoryfetchcontroller_t;
+    typedef inventoryfetchcontroller_t::object inventoryfetchcontroller_object_t;
+    tut::inventoryfetchcontroller_t tut_inventoryfetchcontroller("LLInventoryFetchController");
+
+    // ---------------------------------------------------------------------------------------
+    // Test functions
+    // ---------------------------------------------------------------------------------------
+
+    // prompt responses raise concurrency up to the limit, throttling lowers it and pauses
+    template<> template<>
+    void inventoryfetchcontroller_object_t::test<1>()
+    {
+        LLInventoryFetchController controller;
+        const LLInventoryFetchController::Params& params = controller.getParams();
+        ensure_equals("starting concurrency", controller.getConcurrency(), params.mStartConcurrency);
+
+        F64 now = 0.0;
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            controller.onResponse(0.2, 1, 100, 200, now += 0.1);
+        }
+        ensure_equals("grows to the limit", controller.getConcurrency(), params.mMaxConcurrency);
+
+        controller.onResponse(0.05, 1, 0, 503, now);
+        U32 throttled = controller.getConcurrency();
+        ensure("throttling lowers concurrency", throttled < params.mMaxConcurrency);
+        ensure("pauses after throttling", controller.isBackingOff(now));
+        ensure("pause ends", !controller.isBackingOff(now + params.mBackoffSeconds));
+
+        // responses to requests sent before the decrease don't count again
+        controller.onResponse(0.05, 1, 0, 429, now);
+        ensure_equals("one decrease per pause", controller.getConcurrency(), throttled);
+
+        // throttling while paused again doubles the pause
+        now += params.mBackoffSeconds;
+        controller.onResponse(0.05, 1, 0, 503, now);
+        ensure("longer pause", controller.isBackingOff(now + params.mBackoffSeconds * 1.5));
+        for (U32 i = 0; i < 100; ++i)
+        {
+            now += params.mMaxBackoffSeconds;
+            controller.onResponse(0.05, 1, 0, 503, now);
+        }
+        ensure_equals("bottoms out", controller.getConcurrency(), params.mMinConcurrency);
+        ensure("pause is capped", !controller.isBackingOff(now + params.mMaxBackoffSeconds));
+
+        // slow responses lower it as well
+        controller.reset();
+        for (U32 i = 0; i < 100; ++i)
+        {
+            controller.onResponse(params.mTargetSeconds * 2.0, 1, 100, 200, now += 1.0);
+        }
+        ensure_equals("slow responses", controller.getConcurrency(), params.mMinConcurrency);
+
+        // other failures don't say anything about load
+        controller.reset();
+        controller.onResponse(0.1, 1, 0, 500, now);
+        ensure_equals("server error", controller.getConcurrency(), params.mStartConcurrency);
+        ensure("no pause", !controller.isBackingOff(now));
+    }
+
+    // depth and batch size follow response sizes
+    template<> template<>
+    void inventoryfetchcontroller_object_t::test<2>()
+    {
+        LLInventoryFetchController controller;
+        const LLInventoryFetchController::Params& params = controller.getParams();
+        ensure_equals("starting depth", controller.getDepth(), params.mMaxDepth);
+        ensure_equals("starting batch", controller.getBatchSize(), params.mMaxBatch);
+
+        controller.onResponse(0.5, 1, params.mTargetObjects * 4, 200, 1.0);
+        ensure_equals("large response", controller.getDepth(), params.mMaxDepth / 2);
+        controller.onResponse(params.mTargetSeconds * 2.0, 1, 10, 200, 2.0);
+        ensure_equals("slow response", controller.getDepth(), params.mMaxDepth / 4);
+        controller.onResponse(0.0, 1, 0, 403, 3.0);
+        ensure_equals("too large", controller.getDepth(), params.mMaxDepth / 8);
+        for (U32 i = 0; i < 100; ++i)
+        {
+            controller.onResponse(0.0, 1, 0, 403, 3.0);
+        }
+        ensure_equals("depth bottoms out", controller.getDepth(), params.mMinDepth);
+
+        for (U32 i = 0; i < 100; ++i)
+        {
+            controller.onResponse(0.1, 1, 10, 200, 4.0);
+        }
+        ensure_equals("small responses", controller.getDepth(), params.mMaxDepth);
+
+        // big folders, fewer of them per request
+        controller.reset();
+        for (U32 i = 0; i < 50; ++i)
+        {
+            controller.onResponse(0.5, 4, params.mTargetObjects, 200, 5.0);
+        }
+        ensure_equals("big folders", controller.getBatchSize(), 4U);
+        for (U32 i = 0; i < 50; ++i)
+        {
+            controller.onResponse(0.5, 20, 20, 200, 6.0);
+        }
+        ensure_equals("small folders", controller.getBatchSize(), params.mMaxBatch);
+    }
+
+    // against a server that takes six requests at a time
+    template<> template<>
+    void inventoryfetchcontroller_object_t::test<3>()
+    {
+        constexpr U32 FOLDERS = 100;
+
+        // what the fetch did before: one less than the pool size
+        FetchRun fixed = fetchFolders(FOLDERS, NULL, 19);
+        // few enough to never get throttled
+        FetchRun cautious = fetchFolders(FOLDERS, NULL, 4);
+
+        LLInventoryFetchController controller;
+        FetchRun adaptive = fetchFolders(FOLDERS, &controller, 0);
+
+        ensure("fixed concurrency gets throttled", fixed.mThrottled > FOLDERS);
+        ensure("far fewer throttled responses", adaptive.mThrottled * 10 < fixed.mThrottled);
+        ensure("close to the fastest", adaptive.mSeconds < fixed.mSeconds * 1.5);
+        ensure("faster than cautious", adaptive.mSeconds < cautious.mSeconds);
+    }
+}
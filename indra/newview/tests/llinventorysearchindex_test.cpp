@@ -0,0 +1,220 @@
+/**
+ * @file llinventorysearchindex_test.cpp
+ * @brief Test cases for LLInventorySearchIndex.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Dependencies
+#include "linden_common.h"
+#include <algorithm>
+// Class to test
+#include "../llinventorysearchindex.h"
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// TUT
+// -------------------------------------------------------------------------------------------
+namespace tut
+{
+    // Test wrapper declaration
+    struct inventorysearchindex_test
+    {
+        struct Object
+        {
+            LLUUID mID;
+            std::string mName;
+            std::string mDescription;
+        };
+        std::vector<Object> mObjects;
+
+        // names made of a few words from a small vocabulary, like a real
+        // inventory full of "Red Dress (fitted)" and "Red Dress (fitted) v2"
+        void makeInventory(U32 count)
+        {
+            static const char* words[] = {
+                "Red", "Blue", "dress", "Shirt", "hair", "Mesh", "Body", "eyes", "Skin", "shape",
+                "Tattoo", "jacket", "boots", "Pose", "anim", "HUD", "script", "Texture", "Rezzer", "chair",
+                "Table", "lamp", "Tree", "rock", "Grass", "House", "Door", "window", "Sign", "note",
+                "Landmark", "Gesture", "sound", "Wings", "tail", "Ears", "Snout", "paws", "Fur", "scales"
+            };
+            constexpr U32 NUM_WORDS = sizeof(words) / sizeof(words[0]);
+
+            U32 seed = 12345;
+            auto next = [&seed](U32 range)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                return (seed >> 8) % range;
+            };
+
+            mObjects.resize(count);
+            for (U32 i = 0; i < count; ++i)
+            {
+                Object& obj = mObjects[i];
+                obj.mID.generate();
+                obj.mName.clear();
+                U32 num_words = 1 + next(4);
+                for (U32 w = 0; w < num_words; ++w)
+                {
+                    obj.mName += words[next(NUM_WORDS)];
+                    obj.mName += ' ';
+                }
+                obj.mName += std::to_string(next(1000));
+                obj.mDescription = (i % 3) ? "" : std::string("made by ") + words[next(NUM_WORDS)];
+            }
+        }
+
+        void fill(LLInventorySearchIndex& index)
+        {
+            for (const Object& obj : mObjects)
+            {
+                index.update(obj.mID, obj.mName, obj.mDescription);
+            }
+        }
+
+        // what LLInventoryFilter does per item without the index
+        static bool scanMatch(const Object& obj, const LLInventorySearchIndex::Query& query)
+        {
+            std::string text = query.mField == LLInventorySearchIndex::NAME ? obj.mName : obj.mDescription;
+            LLStringUtil::toUpper(text);
+            return text.find(query.mSubString) != std::string::npos;
+        }
+
+        void scan(const LLInventorySearchIndex::Query& query, uuid_vec_t& ids)
+        {
+            ids.clear();
+            for (const Object& obj : mObjects)
+            {
+                if (scanMatch(obj, query))
+                {
+                    ids.push_back(obj.mID);
+                }
+            }
+        }
+
+        // the index finds exactly what checking every object finds
+        void compare(const LLInventorySearchIndex& index, const LLInventorySearchIndex::Query& query)
+        {
+            uuid_vec_t expected;
+            scan(query, expected);
+            uuid_vec_t found;
+            index.find(query, found);
+            std::sort(expected.begin(), expected.end());
+            std::sort(found.begin(), found.end());
+            ensure_equals("match count for '" + query.mSubString + "'", found.size(), expected.size());
+            ensure("matches for '" + query.mSubString + "'", found == expected);
+        }
+    };
+
+    // Tut templating thingamagic: test group, object and test instance
+    typedef test_group<inventorysearchindex_test> inventorysearchindex_t;
+    typedef inventorysearchindex_t::object inventorysearchindex_object_t;
+    tut::inventorysearchindex_t tut_inventorysearchindex("LLInventorySearchIndex");
+
+    // ---------------------------------------------------------------------------------------
+    // Test functions
+    // ---------------------------------------------------------------------------------------
+
+    // substring queries of every length, on names and descriptions
+    template<> template<>
+    void inventorysearchindex_object_t::test<1>()
+    {
+        makeInventory(5000);
+        LLInventorySearchIndex index;
+        fill(index);
+        ensure_equals("size", index.size(), mObjects.size());
+
+        LLInventorySearchIndex::Query query;
+        for (const char* sub_string : { "R", "RE", "RED", "RED ", "DRESS", "D D", "ESS SH", "HUD 1", "XYZ", "" })
+        {
+            query.mSubString = sub_string;
+            compare(index, query);
+        }
+
+        query.mField = LLInventorySearchIndex::DESCRIPTION;
+        for (const char* sub_string : { "MADE", "BY T", "Y", "" })
+        {
+            query.mSubString = sub_string;
+            compare(index, query);
+        }
+    }
+
+    // updates and removals
+    template<> template<>
+    void inventorysearchindex_object_t::test<2>()
+    {
+        makeInventory(2000);
+        LLInventorySearchIndex index;
+        fill(index);
+
+        U32 generation = index.getGeneration();
+        for (U32 i = 0; i < mObjects.size(); i += 3)
+        {
+            mObjects[i].mName = "renamed " + mObjects[i].mName;
+            index.update(mObjects[i].mID, mObjects[i].mName, mObjects[i].mDescription);
+        }
+        ensure("generation changed", index.getGeneration() != generation);
+        ensure_equals("size after rename", index.size(), mObjects.size());
+
+        for (U32 i = 1; i < mObjects.size(); i += 3)
+        {
+            index.remove(mObjects[i].mID);
+        }
+        std::vector<Object> kept;
+        for (U32 i = 0; i < mObjects.size(); ++i)
+        {
+            if (i % 3 != 1)
+            {
+                kept.push_back(mObjects[i]);
+            }
+        }
+        mObjects.swap(kept);
+        ensure_equals("size after removal", index.size(), mObjects.size());
+
+        // removed slots get reused
+        std::vector<Object> old_objects = mObjects;
+        makeInventory(500);
+        fill(index);
+        mObjects.insert(mObjects.end(), old_objects.begin(), old_objects.end());
+        ensure_equals("size after refill", index.size(), mObjects.size());
+
+        LLInventorySearchIndex::Query query;
+        for (const char* sub_string : { "RENAMED", "NAMED RED", "E", "TAIL", "" })
+        {
+            query.mSubString = sub_string;
+            compare(index, query);
+        }
+
+        LLInventorySearchIndex::bitset_t matches;
+        query.mSubString = "RENAMED";
+        index.find(query, matches);
+        ensure("renamed item matches", index.isMatch(matches, old_objects[0].mID));
+        ensure_equals("name length", index.getNameLength(old_objects[0].mID), old_objects[0].mName.size());
+
+        index.clear();
+        ensure_equals("cleared", index.size(), (size_t)0);
+        uuid_vec_t found;
+        index.find(query, found);
+        ensure("nothing found after clear", found.empty());
+    }
+}
@@ -0,0 +1,242 @@
+/**
+ * @file llskinningutil_test.cpp
+ * @brief Test cases for LLSkinningUtil vertex skinning.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Dependencies
+#include "linden_common.h"
+#include "llmath.h"
+#include "llalignedarray.h"
+#include "llquaternion.h"
+#include "m4math.h"
+#include "llgl.h"
+#include "lljoint.h"
+#include "../llvoavatar.h"
+// Class to test
+#include "../llskinningutil.h"
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// Stubbing: Declarations required to link and run the class being tested
+// Notes:
+// * Add here stubbed implementation of the few classes and methods used in the class to be tested
+// * Add as little as possible (let the link errors guide you)
+// * Do not make any assumption as to how those classes or methods work (i.e. don't copy/paste code)
+// * A simulator for a class can be implemented here. Please comment and document thoroughly.
+
+LLJoint* LLVOAvatar::getJoint(S32) { return NULL; }
+const LLMatrix4a& LLJoint::getWorldMatrix4a() { return mWorldMatrix; }
+LLGLManager::LLGLManager() {}
+LLGLManager gGLManager;
+
+// End Stubbing
+// -------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------
+// TUT
+// -------------------------------------------------------------------------------------------
+namespace tut
+{
+    // Test wrapper declaration
+    struct skinningutil_test
+    {
+        static constexpr U32 NUM_JOINTS = 40;
+
+        LLAlignedArray<LLMatrix4a, 64>  mPalette;
+        LLMatrix4a                      mBindShape;
+        LLAlignedArray<LLVector4a, 64>  mWeights;
+        LLAlignedArray<LLVector4a, 64>  mPositions;
+
+        skinningutil_test()
+        {
+            mPalette.resize(NUM_JOINTS);
+            for (U32 i = 0; i < NUM_JOINTS; ++i)
+            {
+                F32 f = (F32)i;
+                LLMatrix4 mat(LLQuaternion(f * 0.2f, LLVector3(sinf(f), 1.f, cosf(f))),
+                              LLVector4(sinf(f * 0.7f), cosf(f * 0.3f), 0.05f * f, 1.f));
+                mPalette.mArray[i].loadu(mat);
+            }
+
+            LLMatrix4 bind_shape(LLQuaternion(0.3f, LLVector3::z_axis), LLVector4(0.1f, -0.2f, 0.3f, 1.f));
+            bind_shape.mMatrix[0][0] *= 1.5f;
+            bind_shape.mMatrix[1][1] *= 0.5f;
+            mBindShape.loadu(bind_shape);
+        }
+
+        // Weights packed as in LLVolumeFace::mWeights: joint index in the
+        // integer part, unnormalized weight in the fraction.
+        // Vertices get 1 to max_influences joints.
+        void makeVertices(U32 count, U32 max_influences = 4)
+        {
+            mWeights.resize(count);
+            mPositions.resize(count);
+            for (U32 i = 0; i < count; ++i)
+            {
+                U32 h = (i + 1) * 2654435761u;
+                F32 w[4];
+                U32 influences = 1 + h % max_influences;
+                for (U32 k = 0; k < 4; ++k)
+                {
+                    U32 joint = (h >> (k * 5)) % NUM_JOINTS;
+                    F32 weight = k < influences ? 0.05f + (F32)((h >> (k * 3)) % 90) * 0.01f : 0.f;
+                    w[k] = (F32)joint + weight;
+                }
+                mWeights.mArray[i].loadua(w);
+
+                F32 f = (F32)i * 0.01f;
+                mPositions.mArray[i].set(sinf(f * 3.f), cosf(f * 5.f), f - 2.f, 1.f);
+            }
+        }
+
+        // Scalar version of getObjectSkinnedTransform() from objectSkinV.glsl.
+        // Unlike getPerVertexSkinMatrix(), which leaves the fourth weight
+        // unnormalized, this normalizes all four weights.
+        void skinReference(LLVector4a* dst)
+        {
+            for (U32 i = 0; i < mPositions.size(); ++i)
+            {
+                const F32* w = mWeights.mArray[i].getF32ptr();
+                S32 idx[4];
+                F32 wght[4];
+                F32 scale = 0.f;
+                for (U32 k = 0; k < 4; ++k)
+                {
+                    idx[k] = llclamp((S32)floorf(w[k]), (S32)0, (S32)NUM_JOINTS - 1);
+                    wght[k] = w[k] - floorf(w[k]);
+                    scale += wght[k];
+                }
+
+                LLMatrix4a final_mat;
+                final_mat.clear();
+                for (U32 k = 0; k < 4; ++k)
+                {
+                    LLMatrix4a src;
+                    src.setMul(mPalette.mArray[idx[k]], wght[k] / scale);
+                    final_mat.add(src);
+                }
+
+                LLVector4a t;
+                mBindShape.affineTransform(mPositions.mArray[i], t);
+                final_mat.affineTransform(t, dst[i]);
+            }
+        }
+    };
+
+    // Tut templating thingamagic: test group, object and test instance
+    typedef test_group<skinningutil_test> skinningutil_t;
+    typedef skinningutil_t::object skinningutil_object_t;
+    tut::skinningutil_t tut_skinningutil("LLSkinningUtil");
+
+    // ---------------------------------------------------------------------------------------
+    // Test functions
+    // ---------------------------------------------------------------------------------------
+
+    // skinPositions() matches the shader skinning, and reports the extents
+    template<> template<>
+    void skinningutil_object_t::test<1>()
+    {
+        constexpr U32 NUM_VERTICES = 1000;
+        makeVertices(NUM_VERTICES);
+
+        LLAlignedArray<LLVector4a, 64> expected;
+        LLAlignedArray<LLVector4a, 64> actual;
+        expected.resize(NUM_VERTICES);
+        actual.resize(NUM_VERTICES);
+        skinReference(expected.mArray);
+
+        LLVector4a extents[2];
+        LLSkinningUtil::skinPositions(mPalette.mArray, NUM_JOINTS, mBindShape, mWeights.mArray, mPositions.mArray,
+                                      NUM_VERTICES, actual.mArray, extents);
+
+        LLVector4a box_min = expected.mArray[0];
+        LLVector4a box_max = expected.mArray[0];
+        for (U32 i = 0; i < NUM_VERTICES; ++i)
+        {
+            for (U32 c = 0; c < 3; ++c)
+            {
+                ensure_approximately_equals_range("skinned position", actual.mArray[i][c], expected.mArray[i][c], 0.0001f);
+            }
+            box_min.setMin(box_min, expected.mArray[i]);
+            box_max.setMax(box_max, expected.mArray[i]);
+        }
+        for (U32 c = 0; c < 3; ++c)
+        {
+            ensure_approximately_equals_range("extents min", extents[0][c], box_min[c], 0.0001f);
+            ensure_approximately_equals_range("extents max", extents[1][c], box_max[c], 0.0001f);
+        }
+    }
+
+    // out of range joint indices are clamped to the palette
+    template<> template<>
+    void skinningutil_object_t::test<2>()
+    {
+        makeVertices(2);
+        F32 w[4] = { (F32)(NUM_JOINTS + 5) + 0.5f, 1.25f, 0.f, 0.f };
+        mWeights.mArray[0].loadua(w);
+
+        LLVector4a expected[2];
+        LLVector4a actual[2];
+        skinReference(expected);
+        LLSkinningUtil::skinPositions(mPalette.mArray, NUM_JOINTS, mBindShape, mWeights.mArray, mPositions.mArray,
+                                      2, actual);
+        for (U32 i = 0; i < 2; ++i)
+        {
+            for (U32 c = 0; c < 3; ++c)
+            {
+                ensure_approximately_equals_range("clamped position", actual[i][c], expected[i][c], 0.0001f);
+            }
+        }
+    }
+
+    // skinPositions() matches getPerVertexSkinMatrix() wherever the latter
+    // normalizes every weight, i.e. for vertices with up to three joints
+    template<> template<>
+    void skinningutil_object_t::test<3>()
+    {
+        constexpr U32 NUM_VERTICES = 1000;
+        makeVertices(NUM_VERTICES, 3);
+
+        LLAlignedArray<LLVector4a, 64> actual;
+        actual.resize(NUM_VERTICES);
+        LLSkinningUtil::skinPositions(mPalette.mArray, NUM_JOINTS, mBindShape, mWeights.mArray, mPositions.mArray,
+                                      NUM_VERTICES, actual.mArray);
+
+        for (U32 i = 0; i < NUM_VERTICES; ++i)
+        {
+            LLMatrix4a final_mat;
+            LLSkinningUtil::getPerVertexSkinMatrix(mWeights.mArray[i].getF32ptr(), mPalette.mArray, false, final_mat, NUM_JOINTS);
+
+            LLVector4a t;
+            LLVector4a expected;
+            mBindShape.affineTransform(mPositions.mArray[i], t);
+            final_mat.affineTransform(t, expected);
+            for (U32 c = 0; c < 3; ++c)
+            {
+                ensure_approximately_equals_range("per vertex skin matrix", actual.mArray[i][c], expected[c], 0.0001f);
+            }
+        }
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @file llvolumelodbatch_test.cpp
+ * @brief Test cases for LLVolumeLODBatch detail level selection.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+// Dependencies
+#include "linden_common.h"
+#include "llmath.h"
+#include "llvolumemgr.h"
+// Class to test
+#include "../llvolumelodbatch.h"
+// Tut header
+#include "../test/lltut.h"
+
+// -------------------------------------------------------------------------------------------
+// TUT
+// -------------------------------------------------------------------------------------------
+namespace tut
+{
+    // Test wrapper declaration
+    struct volumelodbatch_test
+    {
+        std::vector<F32> mDistances;
+        std::vector<F32> mRadii;
+        std::vector<S32> mDetails;
+
+        // objects from right next to the camera out to the far clip, from
+        // pebbles to whole buildings, each with some previous detail level
+        void makeObjects(U32 count)
+        {
+            mDistances.resize(count);
+            mRadii.resize(count);
+            mDetails.resize(count);
+            U32 seed = 54321;
+            auto rand01 = [&seed]()
+            {
+                seed = seed * 1664525u + 1013904223u;
+                return (F32)(seed >> 8) / (F32)(1 << 24);
+            };
+            for (U32 i = 0; i < count; ++i)
+            {
+                F32 r = rand01();
+                mDistances[i] = 0.01f + r * r * 512.f;
+                mRadii[i] = 0.05f + rand01() * ((i % 8 == 0) ? 64.f : 4.f);
+                mDetails[i] = (S32)(rand01() * 4.f) % 4;
+            }
+        }
+
+        void fill(LLVolumeLODBatch& batch)
+        {
+            batch.clear();
+            for (size_t i = 0; i < mDistances.size(); ++i)
+            {
+                batch.add(mDistances[i], mRadii[i], mDetails[i]);
+            }
+        }
+
+        // compute() gives the same detail levels and changes as the one
+        // object at a time math
+        void compare(const LLVolumeLODBatch::Params& params)
+        {
+            LLVolumeLODBatch batch;
+            fill(batch);
+            batch.compute(params);
+
+            ensure_equals("batch size", batch.size(), (U32) mDistances.size());
+
+            size_t next_change = 0;
+            const std::vector<LLVolumeLODBatch::Change>& changes = batch.getChanges();
+            for (U32 i = 0; i < batch.size(); ++i)
+            {
+                F32 adjusted = LLVolumeLODBatch::adjustDistance(mDistances[i], params);
+                S32 detail = LLVolumeLODBatch::computeDetail(adjusted, mRadii[i], params);
+                ensure_equals("adjusted distance", batch.getAdjustedDistance(i), adjusted);
+                ensure_equals("detail", batch.getDetail(i), detail);
+
+                if (detail != mDetails[i])
+                {
+                    ensure("change listed", next_change < changes.size());
+                    ensure_equals("change index", changes[next_change].mIndex, i);
+                    ensure_equals("change detail", changes[next_change].mDetail, detail);
+                    ++next_change;
+                }
+            }
+            ensure_equals("no extra changes", next_change, changes.size());
+        }
+    };
+
+    // Tut templating thingamagic: test group, object and test instance
+    typedef test_group<volumelodbatch_test> volumelodbatch_t;
+    typedef volumelodbatch_t::object volumelodbatch_object_t;
+    tut::volumelodbatch_t tut_volumelodbatch("LLVolumeLODBatch");
+
+    // ---------------------------------------------------------------------------------------
+    // Test functions
+    // ---------------------------------------------------------------------------------------
+
+    // compute() matches adjustDistance() and computeDetail()
+    template<> template<>
+    void volumelodbatch_object_t::test<1>()
+    {
+        // not a multiple of four, so the last block is padded
+        makeObjects(10003);
+
+        LLVolumeLODBatch::Params params;
+        compare(params);
+
+        params.mLODFactor = 2.f;
+        params.mRampDistance = 4.f;
+        params.mDistanceFactor = 1.5f;
+        compare(params);
+
+        params.mLODFactor = 4.f * 60.f / 45.f;
+        params.mRampDistance = 8.f;
+        params.mDistanceFactor = 1.f;
+        compare(params);
+
+        // the detail levels cover the whole range
+        LLVolumeLODBatch batch;
+        fill(batch);
+        batch.compute(params);
+        S32 seen[LLVolumeLODGroup::NUM_LODS] = { 0 };
+        for (U32 i = 0; i < batch.size(); ++i)
+        {
+            seen[batch.getDetail(i)]++;
+        }
+        for (S32 i = 0; i < LLVolumeLODGroup::NUM_LODS; ++i)
+        {
+            ensure("all detail levels picked", seen[i] > 0);
+        }
+    }
+
+    // without dynamic LOD, and when reused
+    template<> template<>
+    void volumelodbatch_object_t::test<2>()
+    {
+        makeObjects(1001);
+
+        LLVolumeLODBatch::Params params;
+        params.mDynamicLOD = false;
+        params.mLODFactor = 0.5f;
+        compare(params);
+
+        LLVolumeLODBatch batch;
+        fill(batch);
+        batch.compute(params);
+        fill(batch);
+        ensure_equals("refilled size", batch.size(), (U32) mDistances.size());
+        batch.clear();
+        batch.compute(params);
+        ensure_equals("empty batch", batch.size(), 0U);
+        ensure("no changes", batch.getChanges().empty());
+    }
+}